@@ -0,0 +1,107 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_BENCH_H
+#define SCORPION_BENCH_H 1
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace bench {
+    using Clock = std::chrono::steady_clock;
+
+    class State {
+    public:
+        State(size_t iterations, int64_t arg);
+
+        // everything before the first call and after the last one is setup/teardown and isn't timed
+        bool keepRunning() {
+            if (mRemaining == mIterations) mStart = Clock::now();
+            if (mRemaining == 0) {
+                mElapsed += Clock::now() - mStart;
+                return false;
+            }
+
+            mRemaining--;
+            return true;
+        }
+
+        void pauseTiming();
+        void resumeTiming();
+
+        size_t getIterations() const;
+        int64_t getArg() const;
+
+        // items processed per iteration, used for the items/s column
+        void setItemsPerIteration(size_t items);
+        size_t getItemsPerIteration() const;
+
+        Clock::duration getElapsed() const;
+
+    private:
+        size_t mIterations;
+        size_t mRemaining;
+        int64_t mArg;
+        size_t mItemsPerIteration = 1;
+
+        Clock::time_point mStart;
+        Clock::duration mElapsed{};
+    };
+
+    using BenchmarkFn = void(*)(State&);
+
+    struct Registration {
+        Registration(const char* name, BenchmarkFn fn, std::initializer_list<int64_t> args = {});
+    };
+
+    // deterministic so runs are comparable between machines and commits
+    class Random {
+    public:
+        explicit Random(uint64_t seed = 0x5C0A910Full) : mState(seed) {}
+
+        uint64_t next() {
+            uint64_t x = mState;
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            mState = x;
+            return x;
+        }
+
+        float nextFloat(float min, float max) {
+            return min + (max - min) * static_cast<float>(next() >> 40) / static_cast<float>(1ull << 24);
+        }
+
+    private:
+        uint64_t mState;
+    };
+
+    template<class T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+}
+
+#define SCORPION_BENCH_CONCAT_(a, b) a##b
+#define SCORPION_BENCH_CONCAT(a, b) SCORPION_BENCH_CONCAT_(a, b)
+
+// SCORPION_BENCHMARK(Name) or SCORPION_BENCHMARK(Name, 1000, 10000) to run once per argument
+#define SCORPION_BENCHMARK(name, ...) \
+    static void name(::bench::State& state); \
+    static ::bench::Registration SCORPION_BENCH_CONCAT(name, Registration)(#name, name, {__VA_ARGS__}); \
+    static void name(::bench::State& state)
+
+#endif // SCORPION_BENCH_H
@@ -0,0 +1,203 @@
+// Copyright 2025 JesusTouchMe
+
+#include "bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace bench {
+    struct Benchmark {
+        std::string name;
+        BenchmarkFn fn;
+        int64_t arg;
+        bool hasArg;
+    };
+
+    static std::vector<Benchmark>& GetBenchmarks() {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    State::State(size_t iterations, int64_t arg)
+        : mIterations(iterations)
+        , mRemaining(iterations)
+        , mArg(arg) {}
+
+    void State::pauseTiming() {
+        mElapsed += Clock::now() - mStart;
+    }
+
+    void State::resumeTiming() {
+        mStart = Clock::now();
+    }
+
+    size_t State::getIterations() const {
+        return mIterations;
+    }
+
+    int64_t State::getArg() const {
+        return mArg;
+    }
+
+    void State::setItemsPerIteration(size_t items) {
+        mItemsPerIteration = items;
+    }
+
+    size_t State::getItemsPerIteration() const {
+        return mItemsPerIteration;
+    }
+
+    Clock::duration State::getElapsed() const {
+        return mElapsed;
+    }
+
+    Registration::Registration(const char* name, BenchmarkFn fn, std::initializer_list<int64_t> args) {
+        if (args.size() == 0) {
+            GetBenchmarks().push_back({name, fn, 0, false});
+            return;
+        }
+
+        for (int64_t arg : args) {
+            GetBenchmarks().push_back({std::string(name) + "/" + std::to_string(arg), fn, arg, true});
+        }
+    }
+
+    struct Options {
+        const char* filter = nullptr;
+        const char* csvPath = nullptr;
+        double minTime = 0.25;
+        int repetitions = 5;
+        bool list = false;
+    };
+
+    struct Result {
+        std::string name;
+        size_t iterations;
+        double medianNs;
+        double minNs;
+        double maxNs;
+        double itemsPerSecond;
+    };
+
+    static double RunOnce(const Benchmark& benchmark, size_t iterations, size_t* itemsPerIteration) {
+        State state(iterations, benchmark.arg);
+        benchmark.fn(state);
+
+        *itemsPerIteration = state.getItemsPerIteration();
+        return std::chrono::duration<double>(state.getElapsed()).count();
+    }
+
+    static Result Run(const Benchmark& benchmark, const Options& options) {
+        size_t itemsPerIteration = 1;
+
+        // grow the iteration count until a single run takes long enough to measure
+        size_t iterations = 1;
+        while (true) {
+            double seconds = RunOnce(benchmark, iterations, &itemsPerIteration);
+            if (seconds >= options.minTime || iterations >= 1'000'000'000) break;
+
+            double scale = seconds > 0 ? options.minTime * 1.4 / seconds : 10.0;
+            scale = std::clamp(scale, 2.0, 10.0);
+            iterations = static_cast<size_t>(static_cast<double>(iterations) * scale);
+        }
+
+        std::vector<double> samples;
+        for (int i = 0; i < options.repetitions; i++) {
+            double seconds = RunOnce(benchmark, iterations, &itemsPerIteration);
+            samples.push_back(seconds * 1e9 / static_cast<double>(iterations));
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = benchmark.name;
+        result.iterations = iterations;
+        result.medianNs = samples[samples.size() / 2];
+        result.minNs = samples.front();
+        result.maxNs = samples.back();
+        result.itemsPerSecond = static_cast<double>(itemsPerIteration) * 1e9 / result.medianNs;
+        return result;
+    }
+
+    static void PrintUsage(const char* program) {
+        printf("usage: %s [--filter <substring>] [--min-time <seconds>] [--repetitions <n>] [--csv <path>] [--list]\n", program);
+    }
+
+    static bool ParseOptions(int argc, char** argv, Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (strcmp(arg, "--filter") == 0 && hasValue) {
+                options.filter = argv[++i];
+            } else if (strcmp(arg, "--min-time") == 0 && hasValue) {
+                options.minTime = atof(argv[++i]);
+            } else if (strcmp(arg, "--repetitions") == 0 && hasValue) {
+                options.repetitions = std::max(1, atoi(argv[++i]));
+            } else if (strcmp(arg, "--csv") == 0 && hasValue) {
+                options.csvPath = argv[++i];
+            } else if (strcmp(arg, "--list") == 0) {
+                options.list = true;
+            } else {
+                PrintUsage(argv[0]);
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    using namespace bench;
+
+    Options options;
+    if (!ParseOptions(argc, argv, options)) return 1;
+
+    std::vector<Benchmark> benchmarks = GetBenchmarks();
+    std::stable_sort(benchmarks.begin(), benchmarks.end(), [](const Benchmark& a, const Benchmark& b) {
+        return a.name.substr(0, a.name.find('/')) < b.name.substr(0, b.name.find('/'));
+    });
+
+    if (options.filter != nullptr) {
+        std::erase_if(benchmarks, [&](const Benchmark& benchmark) {
+            return benchmark.name.find(options.filter) == std::string::npos;
+        });
+    }
+
+    if (options.list) {
+        for (const Benchmark& benchmark : benchmarks) {
+            printf("%s\n", benchmark.name.c_str());
+        }
+        return 0;
+    }
+
+    FILE* csv = nullptr;
+    if (options.csvPath != nullptr) {
+        csv = fopen(options.csvPath, "w");
+        if (csv == nullptr) {
+            printf("Failed to open %s\n", options.csvPath);
+            return 1;
+        }
+        fprintf(csv, "name,iterations,median_ns,min_ns,max_ns,items_per_second\n");
+    }
+
+    printf("%-40s %14s %14s %14s %16s\n", "Benchmark", "Median ns", "Min ns", "Max ns", "Items/s");
+    for (const Benchmark& benchmark : benchmarks) {
+        Result result = Run(benchmark, options);
+
+        printf("%-40s %14.1f %14.1f %14.1f %16.0f\n", result.name.c_str(), result.medianNs, result.minNs, result.maxNs, result.itemsPerSecond);
+        fflush(stdout);
+
+        if (csv != nullptr) {
+            fprintf(csv, "%s,%zu,%.3f,%.3f,%.3f,%.0f\n", result.name.c_str(), result.iterations, result.medianNs, result.minNs, result.maxNs, result.itemsPerSecond);
+        }
+    }
+
+    if (csv != nullptr) fclose(csv);
+
+    return 0;
+}
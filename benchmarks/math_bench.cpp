@@ -0,0 +1,110 @@
+// Copyright 2025 JesusTouchMe
+
+#include "bench.h"
+
+#include <scorpion/util/math.h>
+
+#include <vector>
+
+using namespace scorpion;
+
+static std::vector<math::Matrix4> MakeMatrices(size_t count) {
+    bench::Random random;
+    std::vector<math::Matrix4> matrices(count);
+
+    for (math::Matrix4& matrix : matrices) {
+        for (float& value : matrix.m) {
+            value = random.nextFloat(-1, 1);
+        }
+    }
+
+    return matrices;
+}
+
+static std::vector<math::Quat> MakeRotations(size_t count) {
+    bench::Random random;
+    std::vector<math::Quat> rotations(count);
+
+    for (math::Quat& rotation : rotations) {
+        math::Vec3 axis(random.nextFloat(-1, 1), random.nextFloat(-1, 1), random.nextFloat(0.1f, 1));
+        rotation = math::Quat::fromAxisAngle(axis.normalized(), random.nextFloat(-3.14f, 3.14f));
+    }
+
+    return rotations;
+}
+
+SCORPION_BENCHMARK(Matrix4Multiply) {
+    std::vector<math::Matrix4> matrices = MakeMatrices(256);
+    size_t i = 0;
+
+    while (state.keepRunning()) {
+        math::Matrix4 result = matrices[i & 255] * matrices[(i + 1) & 255];
+        bench::DoNotOptimize(result);
+        i++;
+    }
+}
+
+SCORPION_BENCHMARK(Matrix4Rotation) {
+    std::vector<math::Quat> rotations = MakeRotations(256);
+    size_t i = 0;
+
+    while (state.keepRunning()) {
+        math::Matrix4 result = math::Matrix4::rotation(rotations[i & 255]);
+        bench::DoNotOptimize(result);
+        i++;
+    }
+}
+
+SCORPION_BENCHMARK(Matrix4TRS) {
+    std::vector<math::Quat> rotations = MakeRotations(256);
+    math::Vec3 position(1, 2, 3);
+    math::Vec3 size(2, 2, 2);
+    size_t i = 0;
+
+    while (state.keepRunning()) {
+        math::Matrix4 result = math::Matrix4::translation(position) * math::Matrix4::rotation(rotations[i & 255]) * math::Matrix4::scale(size);
+        bench::DoNotOptimize(result);
+        i++;
+    }
+}
+
+SCORPION_BENCHMARK(Matrix4LookAtPerspective) {
+    bench::Random random;
+    math::Vec3 target = math::Vec3::zero;
+    math::Vec3 up(0, 1, 0);
+
+    while (state.keepRunning()) {
+        math::Vec3 eye(random.nextFloat(5, 10), random.nextFloat(5, 10), random.nextFloat(5, 10));
+        math::Matrix4 result = math::Matrix4::perspective(0.785f, 16.0f / 9.0f, 0.1f, 100.0f) * math::Matrix4::lookAt(eye, target, up);
+        bench::DoNotOptimize(result);
+    }
+}
+
+SCORPION_BENCHMARK(QuatRotateVec3) {
+    std::vector<math::Quat> rotations = MakeRotations(256);
+    math::Vec3 v(1, 0, 0);
+    size_t i = 0;
+
+    while (state.keepRunning()) {
+        v = rotations[i & 255] * v;
+        bench::DoNotOptimize(v);
+        i++;
+    }
+}
+
+SCORPION_BENCHMARK(Matrix3Inverse) {
+    bench::Random random;
+    std::vector<math::Matrix3> matrices(256);
+    for (math::Matrix3& matrix : matrices) {
+        for (float& value : matrix.m) {
+            value = random.nextFloat(-1, 1);
+        }
+    }
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        math::Matrix3 result = matrices[i & 255].inverse();
+        bench::DoNotOptimize(result);
+        i++;
+    }
+}
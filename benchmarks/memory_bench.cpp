@@ -0,0 +1,57 @@
+// Copyright 2025 JesusTouchMe
+
+#include "bench.h"
+
+#include <scorpion/foundation/memory/allocator.h>
+
+#include <vector>
+
+using namespace scorpion;
+
+// mixed small sizes, roughly what components and per-frame scratch data look like
+static constexpr size_t AllocationSizes[8] = { 16, 24, 48, 64, 96, 128, 32, 80 };
+static constexpr size_t AllocationsPerFrame = 1024;
+
+SCORPION_BENCHMARK(ArenaAllocFrame) {
+    memory::Arena arena(64 * 1024, 64 * 1024);
+
+    state.setItemsPerIteration(AllocationsPerFrame);
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < AllocationsPerFrame; i++) {
+            void* ptr = arena.allocate(AllocationSizes[i & 7]);
+            bench::DoNotOptimize(ptr);
+        }
+        arena.reset();
+    }
+}
+
+SCORPION_BENCHMARK(HeapAllocFrame) {
+    std::vector<void*> pointers(AllocationsPerFrame);
+
+    state.setItemsPerIteration(AllocationsPerFrame);
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < AllocationsPerFrame; i++) {
+            pointers[i] = ScorpionHeapAlloc(AllocationSizes[i & 7]);
+            bench::DoNotOptimize(pointers[i]);
+        }
+        for (void* ptr : pointers) {
+            ScorpionHeapFree(ptr);
+        }
+    }
+}
+
+SCORPION_BENCHMARK(PoolAllocFrame) {
+    memory::Pool pool(128, 1024);
+    std::vector<void*> pointers(AllocationsPerFrame);
+
+    state.setItemsPerIteration(AllocationsPerFrame);
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < AllocationsPerFrame; i++) {
+            pointers[i] = pool.allocate();
+            bench::DoNotOptimize(pointers[i]);
+        }
+        for (void* ptr : pointers) {
+            pool.free(ptr);
+        }
+    }
+}
@@ -0,0 +1,294 @@
+// Copyright 2025 JesusTouchMe
+
+#include "bench.h"
+
+#include <scorpion/core/scene.h>
+
+#include <scorpion/engine_std/camera.h>
+#include <scorpion/engine_std/cube_renderer.h>
+#include <scorpion/engine_std/mesh_renderer.h>
+#include <scorpion/engine_std/particle_emitter.h>
+#include <scorpion/engine_std/sprite_renderer.h>
+#include <scorpion/engine_std/transform.h>
+
+#include <scorpion/hal/renderer.h>
+#include <scorpion/hal/software_backend.h>
+#include <scorpion/hal/sprite_batch.h>
+#include <scorpion/hal/texture_atlas.h>
+
+#include <cmath>
+
+using namespace scorpion;
+using namespace scorpion::components;
+
+static const char* vsBench = R"(
+#version 330
+in vec3 vertexPosition;
+uniform mat4 mvp;
+void main() {
+    gl_Position = mvp * vec4(vertexPosition, 1.0);
+}
+)";
+
+static const char* fsBench = R"(
+#version 330
+out vec4 finalColor;
+void main() {
+    finalColor = vec4(1.0);
+}
+)";
+
+// with a mesh every cube goes through the instanced MeshRenderer path instead of CubeRenderer
+static void PopulateCubes(Scene& scene, size_t count, const SharedPtr<render::Mesh>& mesh = nullptr, const SharedPtr<render::Shader>& shader = nullptr) {
+    bench::Random random;
+
+    Actor* cameraActor = scene.addActor<Actor>();
+    cameraActor->addComponent<Transform>(math::Vec3(10, 10, 10), math::Vec3::one, math::Quat::identity);
+    scene.setActiveCamera(cameraActor->addComponent<Camera>(math::Vec3(10, 10, 10), math::Vec3::zero, math::Vec3(0, 1, 0), 45.0f, Camera::Projection::Perspective));
+
+    for (size_t i = 0; i < count; i++) {
+        Actor* actor = scene.addActor<Actor>();
+
+        math::Vec3 position(random.nextFloat(-50, 50), random.nextFloat(-50, 50), random.nextFloat(-50, 50));
+        actor->addComponent<Transform>(position, math::Vec3::one, math::Quat::identity);
+        if (mesh != nullptr) {
+            actor->addComponent<MeshRenderer>(mesh, math::Color::red);
+        } else {
+            actor->addComponent<CubeRenderer>(math::Color::red);
+        }
+
+        if (shader != nullptr) actor->applyShader(shader);
+    }
+
+    scene.update(1.0 / 60.0);
+}
+
+// Rendering goes through the null backend so these measure the engine side of a frame and run without a GPU
+SCORPION_BENCHMARK(SceneRenderCubes, 1000, 10000) {
+    render::InitHeadless(1280, 720);
+
+    Scene scene;
+    size_t count = static_cast<size_t>(state.getArg());
+    PopulateCubes(scene, count);
+
+    state.setItemsPerIteration(count);
+    while (state.keepRunning()) {
+        scene.render();
+    }
+}
+
+SCORPION_BENCHMARK(SceneRenderMeshes, 1000, 10000) {
+    render::InitHeadless(1280, 720);
+
+    Scene scene;
+    size_t count = static_cast<size_t>(state.getArg());
+    PopulateCubes(scene, count, render::GetCubeMesh());
+
+    state.setItemsPerIteration(count);
+    while (state.keepRunning()) {
+        scene.render();
+    }
+}
+
+// every cube binds a shader and uploads its own mvp, the camera part comes along with the bind
+SCORPION_BENCHMARK(SceneRenderShadedCubes, 1000, 10000) {
+    render::InitHeadless(1280, 720);
+
+    Scene scene;
+    size_t count = static_cast<size_t>(state.getArg());
+    PopulateCubes(scene, count, nullptr, render::CompileShader(vsBench, fsBench));
+
+    state.setItemsPerIteration(count);
+    while (state.keepRunning()) {
+        scene.render();
+    }
+}
+
+// four player split screen, each view culls and records on its own before anything gets submitted
+SCORPION_BENCHMARK(SceneRenderViews, 1000, 10000) {
+    render::InitHeadless(1280, 720);
+
+    Scene scene;
+    size_t count = static_cast<size_t>(state.getArg());
+    PopulateCubes(scene, count);
+
+    for (int i = 0; i < 4; i++) {
+        float angle = static_cast<float>(i) * 1.5707964f;
+        math::Vec3 position(std::cos(angle) * 60.0f, 20.0f, std::sin(angle) * 60.0f);
+
+        Actor* cameraActor = scene.addActor<Actor>();
+        cameraActor->addComponent<Transform>(position, math::Vec3::one, math::Quat::identity);
+
+        RenderView& view = scene.getViews().emplace_back();
+        view.camera = cameraActor->addComponent<Camera>(position, math::Vec3::zero, math::Vec3(0, 1, 0), 60.0f, Camera::Projection::Perspective);
+        view.x = static_cast<float>(i % 2) * 0.5f;
+        view.y = static_cast<float>(i / 2) * 0.5f;
+        view.width = 0.5f;
+        view.height = 0.5f;
+    }
+
+    scene.update(1.0 / 60.0);
+
+    state.setItemsPerIteration(count * 4);
+    while (state.keepRunning()) {
+        scene.render();
+    }
+}
+
+// a single emitter, the whole thing is one instanced draw
+SCORPION_BENCHMARK(SceneRenderParticles, 100000) {
+    render::InitHeadless(1280, 720);
+
+    Scene scene;
+    PopulateCubes(scene, 0);
+
+    auto count = static_cast<uint32_t>(state.getArg());
+
+    ParticleEmitter::Settings settings;
+    settings.maxParticles = count;
+    settings.rate = static_cast<float>(count) / 1.5f;
+    settings.startSize = 0.5f;
+
+    Actor* actor = scene.addActor<Actor>();
+    actor->addComponent<Transform>(math::Vec3::zero, math::Vec3::one, math::Quat::identity);
+    ParticleEmitter* emitter = actor->addComponent<ParticleEmitter>(settings);
+
+    for (int i = 0; i < 180; i++) {
+        scene.update(1.0 / 60.0);
+    }
+
+    state.setItemsPerIteration(emitter->getParticleCount());
+    while (state.keepRunning()) {
+        scene.render();
+    }
+}
+
+SCORPION_BENCHMARK(SoftwareRenderCubes, 1000, 5000) {
+    render::Backend* previous = render::GetBackend();
+
+    render::SoftwareBackend backend(1280, 720);
+    render::SetBackend(&backend);
+
+    {
+        Scene scene;
+        size_t count = static_cast<size_t>(state.getArg());
+        PopulateCubes(scene, count);
+
+        state.setItemsPerIteration(count);
+        while (state.keepRunning()) {
+            scene.render();
+        }
+    }
+
+    render::SetBackend(previous);
+}
+
+// 32 different images, all on one atlas page
+static Vector<render::TextureRegion> PackImages(render::TextureAtlas& atlas) {
+    Vector<render::TextureRegion> regions;
+    Vector<uint8_t> pixels(32 * 32 * 4, 0xFF);
+
+    for (int i = 0; i < 32; i++) {
+        int size = 8 + i % 4 * 8;
+        regions.push_back(atlas.add(size, size, pixels.data()));
+    }
+
+    return regions;
+}
+
+// sprites on two layers with a few orders each, every one of them from the atlas so the whole scene is one draw per layer
+SCORPION_BENCHMARK(SceneRenderSprites, 1000, 10000) {
+    render::InitHeadless(1280, 720);
+
+    render::TextureAtlas atlas(1024);
+    Vector<render::TextureRegion> regions = PackImages(atlas);
+
+    {
+        Scene scene;
+        bench::Random random;
+        size_t count = static_cast<size_t>(state.getArg());
+
+        for (size_t i = 0; i < count; i++) {
+            Actor* actor = scene.addActor<Actor>();
+
+            math::Vec3 position(random.nextFloat(0, 1280), random.nextFloat(0, 720), 0.0f);
+            actor->addComponent<Transform>(position, math::Vec3(16, 16, 1), math::Quat::identity);
+
+            auto layer = i % 4 == 0 ? RenderableComponent::Layer::UI : RenderableComponent::Layer::World2D;
+            actor->addComponent<SpriteRenderer>(regions[i % regions.size()], math::Color::white, layer, static_cast<int>(i % 3));
+        }
+
+        scene.update(1.0 / 60.0);
+
+        state.setItemsPerIteration(count);
+        while (state.keepRunning()) {
+            scene.render();
+        }
+    }
+}
+
+// the batcher alone, sprites come in with orders out of sequence so they need sorting
+SCORPION_BENCHMARK(DrawSprites, 10000) {
+    render::InitHeadless(1280, 720);
+
+    render::TextureAtlas atlas(1024);
+    Vector<render::TextureRegion> regions = PackImages(atlas);
+
+    size_t count = static_cast<size_t>(state.getArg());
+
+    state.setItemsPerIteration(count);
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < count; i++) {
+            auto x = static_cast<float>(i % 1280);
+            auto y = static_cast<float>(i / 1280 * 16);
+            render::DrawSprite(regions[i % regions.size()], math::Vec2(x, y), math::Vec2(16, 16), math::Color::white, 0.0f, math::Vec2::zero, static_cast<int>(i % 7));
+        }
+
+        render::FlushSprites();
+    }
+}
+
+// packing and copying in, pages included, roughly what loading the sprites of a level costs
+SCORPION_BENCHMARK(AtlasPack, 1000) {
+    render::InitHeadless(1280, 720);
+
+    bench::Random random;
+    Vector<uint8_t> pixels(64 * 64 * 4, 0xFF);
+    size_t count = static_cast<size_t>(state.getArg());
+
+    state.setItemsPerIteration(count);
+    while (state.keepRunning()) {
+        render::TextureAtlas atlas(2048);
+
+        for (size_t i = 0; i < count; i++) {
+            auto width = static_cast<int>(random.nextFloat(4, 64));
+            auto height = static_cast<int>(random.nextFloat(4, 64));
+            bench::DoNotOptimize(atlas.add(width, height, pixels.data()));
+        }
+    }
+}
+
+SCORPION_BENCHMARK(CompileShaderCacheHit) {
+    render::InitHeadless(1280, 720);
+
+    SharedPtr<render::Shader> shader = render::CompileShader(vsBench, fsBench);
+
+    while (state.keepRunning()) {
+        SharedPtr<render::Shader> cached = render::CompileShader(vsBench, fsBench);
+        bench::DoNotOptimize(cached);
+    }
+}
+
+SCORPION_BENCHMARK(ShaderSetUniformMatrix4) {
+    render::InitHeadless(1280, 720);
+
+    SharedPtr<render::Shader> shader = render::CompileShader(vsBench, fsBench);
+    math::Matrix4 mvp = math::Matrix4::identity();
+    String name = "mvp";
+
+    shader->begin();
+    while (state.keepRunning()) {
+        shader->setUniformMatrix4(name, mvp);
+    }
+    shader->end();
+}
@@ -0,0 +1,39 @@
+// Copyright 2025 JesusTouchMe
+
+#include "bench.h"
+
+#include <scorpion/util/math.h>
+
+#include <vector>
+
+using namespace scorpion;
+
+// CPU side of drawing a frame of cubes: camera matrices once, then model and mvp per object, same math CubeRenderer does
+SCORPION_BENCHMARK(RenderPrepCubes, 1000, 10000) {
+    size_t count = static_cast<size_t>(state.getArg());
+
+    bench::Random random;
+    std::vector<math::Vec3> positions(count);
+    std::vector<math::Quat> rotations(count);
+    for (size_t i = 0; i < count; i++) {
+        positions[i] = math::Vec3(random.nextFloat(-50, 50), random.nextFloat(-50, 50), random.nextFloat(-50, 50));
+        rotations[i] = math::Quat::fromAxisAngle(math::Vec3(0, 1, 0), random.nextFloat(-3.14f, 3.14f));
+    }
+
+    std::vector<math::Matrix4> mvps(count);
+    std::vector<math::Matrix4> models(count);
+
+    state.setItemsPerIteration(count);
+    while (state.keepRunning()) {
+        math::Matrix4 view = math::Matrix4::lookAt(math::Vec3(10, 10, 10), math::Vec3::zero, math::Vec3(0, 1, 0));
+        math::Matrix4 projection = math::Matrix4::perspective(0.785f, 16.0f / 9.0f, 0.1f, 100.0f);
+        math::Matrix4 viewProjection = projection * view;
+
+        for (size_t i = 0; i < count; i++) {
+            models[i] = math::Matrix4::translation(positions[i]) * math::Matrix4::rotation(rotations[i]) * math::Matrix4::scale(math::Vec3::one);
+            mvps[i] = viewProjection * models[i];
+        }
+
+        bench::ClobberMemory();
+    }
+}
@@ -0,0 +1,272 @@
+// Copyright 2025 JesusTouchMe
+
+#include "bench.h"
+
+#include <scorpion/core/scene.h>
+#include <scorpion/core/serialization.h>
+
+#include <scorpion/engine_std/camera.h>
+#include <scorpion/engine_std/particle_emitter.h>
+#include <scorpion/engine_std/physics_body.h>
+#include <scorpion/engine_std/transform.h>
+
+#include <vector>
+
+using namespace scorpion;
+using namespace scorpion::components;
+
+static constexpr double FixedDelta = 1.0 / 60.0;
+
+static void PopulateScene(Scene& scene, size_t count, bool physics) {
+    bench::Random random;
+    scene.reserveActors(count);
+
+    for (size_t i = 0; i < count; i++) {
+        Actor* actor = scene.addActor<Actor>();
+
+        math::Vec3 position(random.nextFloat(-100, 100), random.nextFloat(-100, 100), random.nextFloat(-100, 100));
+        actor->addComponent<Transform>(position, math::Vec3::one, math::Quat::identity);
+
+        if (physics) {
+            actor->addComponent<PhysicsBody>(random.nextFloat(1, 10));
+        }
+    }
+
+    // first tick runs onStart for everything, keep it out of the measurement
+    scene.update(FixedDelta);
+}
+
+SCORPION_BENCHMARK(TransformGetMatrix) {
+    Scene scene;
+    PopulateScene(scene, 1024, false);
+
+    std::vector<Transform*> transforms;
+    for (Actor* actor : scene.view<Transform>()) {
+        transforms.push_back(actor->getComponent<Transform>());
+    }
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        math::Matrix4 matrix = transforms[i & 1023]->getMatrix();
+        bench::DoNotOptimize(matrix);
+        i++;
+    }
+}
+
+SCORPION_BENCHMARK(ActorGetComponent) {
+    Scene scene;
+    PopulateScene(scene, 1024, true);
+
+    std::vector<Actor*> actors(scene.view<Transform>().begin(), scene.view<Transform>().end());
+
+    // shuffled so the lookups don't just walk the pools in order
+    bench::Random random;
+    for (size_t i = actors.size() - 1; i > 0; i--) {
+        std::swap(actors[i], actors[random.next() % (i + 1)]);
+    }
+
+    size_t i = 0;
+    while (state.keepRunning()) {
+        PhysicsBody* body = actors[i & 1023]->getComponent<PhysicsBody>();
+        bench::DoNotOptimize(body);
+        i++;
+    }
+}
+
+SCORPION_BENCHMARK(SceneUpdate, 1000, 10000, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), false);
+
+    state.setItemsPerIteration(static_cast<size_t>(state.getArg()));
+    while (state.keepRunning()) {
+        scene.update(FixedDelta);
+    }
+}
+
+SCORPION_BENCHMARK(SceneUpdatePhysics, 1000, 10000, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), true);
+
+    state.setItemsPerIteration(static_cast<size_t>(state.getArg()));
+    while (state.keepRunning()) {
+        scene.update(FixedDelta);
+    }
+}
+
+// most of the world asleep, only every 10th actor is active
+SCORPION_BENCHMARK(SceneUpdateSparse, 10000, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), true);
+
+    size_t i = 0;
+    for (Actor* actor : scene.view<Transform>()) {
+        actor->setActive(i++ % 10 == 0);
+    }
+
+    scene.update(FixedDelta);
+
+    state.setItemsPerIteration(static_cast<size_t>(state.getArg()) / 10);
+    while (state.keepRunning()) {
+        scene.update(FixedDelta);
+    }
+}
+
+// same world with LOD on and every body throttled, the camera sits in the middle so most bodies are in the coarser buckets
+SCORPION_BENCHMARK(SceneUpdateLOD, 10000, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), true);
+
+    scene.view<PhysicsBody>().each([](Actor*, PhysicsBody* body) {
+        body->setThrottled(true);
+    });
+
+    Actor* cameraActor = scene.addActor<Actor>();
+    scene.setActiveCamera(cameraActor->addComponent<Camera>(math::Vec3::zero, math::Vec3(0, 0, 1), math::Vec3(0, 1, 0), 60.0f, Camera::Projection::Perspective));
+    scene.getLODSettings().enabled = true;
+
+    scene.update(FixedDelta);
+
+    state.setItemsPerIteration(static_cast<size_t>(state.getArg()));
+    while (state.keepRunning()) {
+        scene.update(FixedDelta);
+    }
+}
+
+SCORPION_BENCHMARK(PhysicsBodyIntegrate, 10000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), true);
+
+    View<PhysicsBody> bodies = scene.view<PhysicsBody>();
+
+    state.setItemsPerIteration(bodies.size());
+    while (state.keepRunning()) {
+        bodies.each([](Actor*, PhysicsBody* body) {
+            body->onUpdate(FixedDelta);
+        });
+    }
+}
+
+// one emitter at its steady state, as many particles dying every tick as getting spawned
+SCORPION_BENCHMARK(ParticleEmitterUpdate, 10000, 100000) {
+    render::InitHeadless(1280, 720);
+
+    Scene scene;
+    auto count = static_cast<uint32_t>(state.getArg());
+
+    ParticleEmitter::Settings settings;
+    settings.maxParticles = count;
+    settings.rate = static_cast<float>(count) / 1.5f;
+    settings.drag = 0.1f;
+
+    Actor* actor = scene.addActor<Actor>();
+    actor->addComponent<Transform>(math::Vec3::zero, math::Vec3::one, math::Quat::identity);
+    ParticleEmitter* emitter = actor->addComponent<ParticleEmitter>(settings);
+
+    for (int i = 0; i < 180; i++) {
+        scene.update(FixedDelta);
+    }
+
+    state.setItemsPerIteration(emitter->getParticleCount());
+    while (state.keepRunning()) {
+        emitter->onUpdate(FixedDelta);
+    }
+}
+
+SCORPION_BENCHMARK(SceneAddRemoveActor) {
+    Scene scene;
+    PopulateScene(scene, 1024, false);
+
+    while (state.keepRunning()) {
+        Actor* actor = scene.addActor<Actor>();
+        actor->addComponent<Transform>(math::Vec3::zero, math::Vec3::one, math::Quat::identity);
+        scene.removeActor(actor);
+    }
+}
+
+SCORPION_BENCHMARK(SceneSnapshotSave, 1000, 10000, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), true);
+
+    SceneSnapshot snapshot;
+    scene.snapshot(snapshot);
+
+    state.setItemsPerIteration(static_cast<size_t>(state.getArg()));
+    while (state.keepRunning()) {
+        scene.snapshot(snapshot);
+    }
+}
+
+// same actors as the snapshot, so this is the in place rollback path
+SCORPION_BENCHMARK(SceneSnapshotRestore, 1000, 10000, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), true);
+
+    SceneSnapshot snapshot;
+    scene.snapshot(snapshot);
+
+    state.setItemsPerIteration(static_cast<size_t>(state.getArg()));
+    while (state.keepRunning()) {
+        scene.restore(snapshot);
+    }
+}
+
+// 1024 rays per iteration through the batched entry point
+SCORPION_BENCHMARK(SpatialRaycast, 10000, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), false);
+
+    SpatialIndex& index = scene.getSpatialIndex();
+
+    bench::Random random;
+    std::vector<Ray> rays(1024);
+    for (Ray& ray : rays) {
+        ray.origin = math::Vec3(random.nextFloat(-100, 100), random.nextFloat(-100, 100), random.nextFloat(-100, 100));
+        ray.direction = math::Vec3(random.nextFloat(-1, 1), random.nextFloat(-1, 1), random.nextFloat(-1, 1)).normalized();
+        ray.maxDistance = 50.0f;
+    }
+
+    std::vector<RayHit> hits(rays.size());
+
+    state.setItemsPerIteration(rays.size());
+    while (state.keepRunning()) {
+        index.raycast(rays.data(), rays.size(), hits.data());
+        bench::DoNotOptimize(hits.data());
+    }
+}
+
+SCORPION_BENCHMARK(SpatialNearest, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), false);
+
+    SpatialIndex& index = scene.getSpatialIndex();
+
+    bench::Random random;
+    Vector<Actor*> found;
+
+    while (state.keepRunning()) {
+        found.clear();
+        index.nearest(math::Vec3(random.nextFloat(-100, 100), random.nextFloat(-100, 100), random.nextFloat(-100, 100)), 8, found);
+        bench::DoNotOptimize(found.data());
+    }
+}
+
+// everything moves a little every tick, which is the worst case for the scan but mostly stays inside the fat boxes
+SCORPION_BENCHMARK(SpatialRefresh, 10000, 100000) {
+    Scene scene;
+    PopulateScene(scene, static_cast<size_t>(state.getArg()), false);
+
+    SpatialIndex& index = scene.getSpatialIndex();
+    View<Transform> transforms = scene.view<Transform>();
+
+    float step = 0.01f;
+
+    state.setItemsPerIteration(static_cast<size_t>(state.getArg()));
+    while (state.keepRunning()) {
+        transforms.each([step](Actor*, Transform* transform) {
+            transform->setPosition(transform->getPosition() + math::Vec3(step, 0, 0));
+        });
+
+        index.refresh();
+        step = -step;
+    }
+}
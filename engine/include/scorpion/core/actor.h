@@ -4,16 +4,17 @@
 #define SCORPION_ACTOR_H 1
 
 #include "scorpion/core/component.h"
+#include "scorpion/core/component_registry.h"
 
 #include "scorpion/util/std_types.h"
 
-#include <typeindex>
-
 namespace scorpion {
     class Scene;
 
     class SCORPION_API Actor {
     friend class Scene;
+    friend class Prefab;
+    friend class Component;
     public:
         explicit Actor(Scene* scene);
         virtual ~Actor();
@@ -24,54 +25,121 @@ namespace scorpion {
 
         template<class T, typename... Args>
         T* addComponent(Args&&... args) {
-            std::type_index type = typeid(T);
-            if (mComponents.contains(type)) {
-                return static_cast<T*>(mComponents[type].get());
+            static_assert(alignof(T) <= 16, "components are allocated from 16 byte aligned pools");
+
+            ComponentTypeId id = GetComponentTypeId<T>();
+            if (mSignature.test(id)) {
+                return static_cast<T*>(mComponents[id]);
             }
 
-            UniquePtr<Component> component = MakeUnique<T>(this, std::forward<Args>(args)...);
-            T* ptr = static_cast<T*>(component.get());
+            memory::Pool* pool = getComponentPool(sizeof(T));
+            T* component = new(pool->allocate()) T(this, std::forward<Args>(args)...);
+            component->mPool = pool;
+            component->mTypeId = id;
+
+            if (id >= mComponents.size()) mComponents.resize(id + 1, nullptr);
+            mComponents[id] = component;
 
-            mComponents[type] = std::move(component);
+            ComponentSignature previous = mSignature;
+            mSignature.set(id);
+            onSignatureChanged(previous);
+            onComponentAdded(component);
 
-            return ptr;
+            return component;
         }
 
         template<class T>
-        T* getComponent() {
-            auto it = mComponents.find(typeid(T));
-            if (it != mComponents.end()) return static_cast<T*>(it->second.get());
-            else return nullptr;
+        T* getComponent() const {
+            ComponentTypeId id = GetComponentTypeId<T>();
+            return id < mComponents.size() ? static_cast<T*>(mComponents[id]) : nullptr;
+        }
+
+        Component* getComponent(ComponentTypeId id) const {
+            return id < mComponents.size() ? mComponents[id] : nullptr;
+        }
+
+        template<class T>
+        bool hasComponent() const {
+            return mSignature.test(GetComponentTypeId<T>());
         }
 
         template<class T>
         bool removeComponent() {
-            auto it = mComponents.find(typeid(T));
-            if (it != mComponents.end()) {
-                it->second->onDestroy();
-                mComponents.erase(it);
-                return true;
-            }
+            ComponentTypeId id = GetComponentTypeId<T>();
+            if (!mSignature.test(id)) return false;
 
-            return false;
+            Component* component = mComponents[id];
+            component->onDestroy();
+            onComponentRemoved(component);
+
+            ComponentSignature previous = mSignature;
+            mSignature.reset(id);
+            onSignatureChanged(previous); // the scene can still get at the component from in here
+
+            mComponents[id] = nullptr;
+
+            destroyComponent(component);
+
+            return true;
         }
 
+        const ComponentSignature& getSignature() const { return mSignature; }
+
         void applyShader(const SharedPtr<render::Shader>& shader);
 
         Scene* getScene() const { return mScene; }
 
+        // Unique within the scene while the actor is alive, ids of destroyed actors get reused
+        uint32_t getId() const { return mId; }
+
+        // Activating only takes effect at the start of the next tick, deactivating right away
         bool isActive() const { return mActive; }
-        void setActive(bool active) { mActive = active; }
+        void setActive(bool active);
+
+        // LOD bucket the scene put the actor in this tick, see LODSettings. Renderables can go by it to draw with less detail.
+        // Always 0 while the scene's LOD is off, there's no active camera or the actor has no Transform
+        uint32_t getLOD() const { return mLOD; }
 
     private:
         Scene* mScene;
+        memory::Pool* mPool = nullptr;
+        size_t mIndex = 0;
+        uint32_t mId = 0;
         bool mActive = true;
         bool mStarted = false;
-
-        HashMap<std::type_index, UniquePtr<Component>> mComponents;
-
-        void update(double dt);
-        void renderPass(RenderableComponent::Layer pass);
+        bool mDestroyQueued = false;
+        uint8_t mLOD = 0;
+
+        // start queue and active list bookkeeping, see Scene
+        bool mStartQueued = false;
+        bool mListed = false;
+        size_t mStartIndex = 0; // in the start queue while mStartQueued
+        bool mUpdating = false;
+        bool mCompact = false;
+        size_t mListIndex = 0;
+
+        Vector<Component*> mComponents; // indexed by ComponentTypeId, null where the actor doesn't have that type
+        ComponentSignature mSignature;
+
+        // started and active components in ComponentTypeId order, this is all update looks at
+        Vector<Component*> mActiveComponents;
+
+        // LayerBit of every layer the actor has a renderable in, active or not. Render passes skip actors without looking at their components
+        uint32_t mRenderLayers = 0;
+
+        memory::Pool* getComponentPool(size_t size);
+        void onSignatureChanged(const ComponentSignature& previous);
+        void onComponentAdded(Component* component);
+        void onComponentRemoved(Component* component);
+        void onComponentActiveChanged(Component* component);
+
+        void listComponent(Component* component);
+        void unlistComponent(Component* component);
+        static void destroyComponent(Component* component);
+
+        // returns the number of components that got updated, throttled ones only update when due and add to skipped otherwise
+        size_t update(double dt, bool due, size_t& skipped);
+        size_t renderPass(RenderableComponent::Layer pass, const Frustum* frustum = nullptr); // returns how many renderables got culled
     };
 }
 
@@ -0,0 +1,79 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_ASSET_MANAGER_H
+#define SCORPION_ASSET_MANAGER_H 1
+
+#include "scorpion/core/asset_pack.h"
+
+#include "scorpion/hal/mesh.h"
+#include "scorpion/hal/shader_cache.h"
+
+namespace scorpion::assets {
+    enum class Priority : uint8_t {
+        Low,
+        Normal,
+        High,
+    };
+
+    struct Asset;
+
+    // Refcounted reference to an asset inside a mounted pack. The data is used in place, straight out of the mapping,
+    // and stays valid as long as the handle does. Eviction only ever drops pages, it can't pull memory out from under anyone
+    class SCORPION_API AssetHandle {
+    public:
+        AssetHandle() = default;
+        ~AssetHandle();
+
+        AssetHandle(const AssetHandle& other);
+        AssetHandle(AssetHandle&& other) noexcept;
+
+        AssetHandle& operator=(const AssetHandle& other);
+        AssetHandle& operator=(AssetHandle&& other) noexcept;
+
+        bool isValid() const;
+
+        // Paged in, reading it won't stall on the disk
+        bool isReady() const;
+        void wait() const;
+
+        const char* getName() const;
+        AssetType getType() const;
+        const uint8_t* getData() const;
+        size_t getSize() const;
+
+        MeshView getMesh() const;
+        ShaderView getShader() const;
+
+    private:
+        friend class AssetManager;
+
+        explicit AssetHandle(Asset* asset); // adopts a reference that's already been taken
+
+        Asset* mAsset = nullptr;
+    };
+
+    // Maps the pack right away, which is cheap since nothing gets read yet. For names in more than one pack the last mounted wins
+    SCORPION_API bool MountPack(const char* path);
+
+    // Fails while any asset in the pack still has a handle
+    SCORPION_API bool UnmountPack(const char* path);
+
+    // Invalid handle if no mounted pack has it. Paging in happens on the io thread, higher priorities first
+    SCORPION_API AssetHandle Load(const char* name, Priority priority = Priority::Normal);
+
+    // Pages in the whole pack without holding on to anything, so it's all evictable again right away if the budget is tight
+    SCORPION_API void PrefetchPack(const char* path, Priority priority = Priority::Low);
+
+    // Assets nobody has a handle to stay cached until this is exceeded, then the least recently released go first. 0 means no limit (default)
+    SCORPION_API void SetMemoryBudget(size_t bytes);
+    SCORPION_API size_t GetResidentBytes();
+    SCORPION_API size_t GetPendingLoads();
+
+    // The mesh is uploaded straight from the mapping, nullptr if the asset isn't a mesh
+    SCORPION_API SharedPtr<render::Mesh> CreateMesh(const AssetHandle& handle);
+
+    // nullptr if the asset isn't a shader
+    SCORPION_API SharedPtr<render::ShaderRequest> CompileShader(const AssetHandle& handle);
+}
+
+#endif // SCORPION_ASSET_MANAGER_H
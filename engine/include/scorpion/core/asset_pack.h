@@ -0,0 +1,127 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_ASSET_PACK_H
+#define SCORPION_ASSET_PACK_H 1
+
+#include "scorpion/foundation/io/mapped_file.h"
+
+#include "scorpion/hal/render_commands.h"
+
+namespace scorpion::assets {
+    // Pack layout, everything little endian and used straight out of the mapping:
+    //   PackHeader | payloads, each PayloadAlignment aligned | PackEntry table sorted by hash | names, nul terminated
+    // Payloads are laid out so the structs below can be pointed at directly, nothing gets parsed or copied on load
+
+    constexpr uint32_t PackMagic = 0x4B504353; // "SCPK"
+    constexpr uint32_t PackVersion = 1;
+    constexpr size_t PayloadAlignment = 64;
+
+    enum class AssetType : uint32_t {
+        Blob,
+        Mesh,
+        Shader,
+        Scene,
+    };
+
+    struct PackHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t entriesOffset;
+        uint64_t namesOffset;
+    };
+
+    struct PackEntry {
+        uint64_t hash;
+        uint64_t offset;
+        uint64_t size;
+        AssetType type;
+        uint32_t name; // offset into the names block
+    };
+
+    // Offsets are relative to the start of the asset
+    struct MeshHeader {
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint64_t verticesOffset;
+        uint64_t indicesOffset;
+    };
+
+    struct ShaderHeader {
+        uint64_t vertexOffset;
+        uint64_t fragmentOffset;
+    };
+
+    struct MeshView {
+        const render::Vertex* vertices = nullptr;
+        uint32_t vertexCount = 0;
+        const uint16_t* indices = nullptr;
+        uint32_t indexCount = 0;
+    };
+
+    struct ShaderView {
+        const char* vertexSource = nullptr;
+        const char* fragmentSource = nullptr;
+    };
+
+    // 64 bit FNV-1a, the lookup key for every asset
+    SCORPION_API uint64_t HashAssetName(const char* name);
+
+    class SCORPION_API AssetPack {
+    public:
+        // Maps the file and checks the header and table, nothing else is touched
+        bool open(const char* path);
+        void close();
+
+        bool isOpen() const;
+
+        uint32_t getEntryCount() const;
+        const PackEntry& getEntry(uint32_t index) const;
+
+        // nullptr if the pack doesn't have it
+        const PackEntry* find(uint64_t hash) const;
+        const PackEntry* find(const char* name) const;
+
+        const char* getName(const PackEntry& entry) const;
+        const uint8_t* getData(const PackEntry& entry) const;
+
+        // Empty views if the entry has the wrong type or is malformed
+        MeshView getMesh(const PackEntry& entry) const;
+        ShaderView getShader(const PackEntry& entry) const;
+
+        const io::MappedFile& getFile() const;
+
+    private:
+        io::MappedFile mFile;
+
+        const PackHeader* mHeader = nullptr;
+        const PackEntry* mEntries = nullptr;
+        const char* mNames = nullptr;
+        size_t mNamesSize = 0;
+    };
+
+    // Builds a pack in memory, meant for tools and tests
+    class SCORPION_API AssetPackWriter {
+    public:
+        void addBlob(const char* name, AssetType type, const void* data, size_t size);
+        void addMesh(const char* name, const render::Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount);
+        void addShader(const char* name, const char* vertexSource, const char* fragmentSource);
+
+        // Later assets with the same name replace earlier ones
+        bool write(const char* path) const;
+
+    private:
+        struct Asset {
+            String name;
+            AssetType type;
+            Vector<uint8_t> data;
+        };
+
+        Vector<Asset> mAssets;
+
+        Asset& add(const char* name, AssetType type);
+    };
+}
+
+#endif // SCORPION_ASSET_PACK_H
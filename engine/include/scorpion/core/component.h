@@ -7,13 +7,18 @@
 
 #include "scorpion/core/api.h"
 
+#include "scorpion/foundation/memory/allocator.h"
+
 #include "scorpion/hal/renderer.h"
 
+#include "scorpion/util/bounds.h"
+
 namespace scorpion {
     class Actor;
 
     class SCORPION_API Component {
     friend class Actor;
+    friend class Scene;
     public:
         explicit Component(Actor* owner) : mOwner(owner) {}
         virtual ~Component() = default;
@@ -24,13 +29,26 @@ namespace scorpion {
 
         Actor* getOwner() const { return mOwner; }
 
+        // Activating only takes effect at the start of the next tick, deactivating right away
         bool isActive() const { return mActive; }
-        void setActive(bool active) { mActive = active; }
+        void setActive(bool active);
+
+        // Throttled components only get updated every LODSettings::updateIntervals ticks for their actor's LOD, with the time of the
+        // ticks in between added onto dt. Off by default, only turn it on for things that don't mind a big step now and then
+        bool isThrottled() const { return mThrottled; }
+        void setThrottled(bool throttled) { mThrottled = throttled; }
 
     private:
         Actor* mOwner;
+        memory::Pool* mPool = nullptr;
+        uint32_t mTypeId = 0;
         bool mActive = true;
         bool mStarted = false;
+        bool mStartQueued = false;
+        bool mListed = false;
+        size_t mStartIndex = 0; // in the scene's start queue while mStartQueued
+        bool mThrottled = false;
+        double mSkippedTime = 0.0; // throttled only, dt of the ticks it sat out
     };
 
     class SCORPION_API RenderableComponent : public Component {
@@ -43,13 +61,22 @@ namespace scorpion {
 
         RenderableComponent(Actor* owner, Layer layer) : Component(owner), mLayer(layer) {}
 
+        static constexpr uint32_t LayerBit(Layer layer) { return 1u << static_cast<uint32_t>(layer); }
+
+        // Can run on a job worker while the scene records several views at once. Draw and read, don't change anything shared
         virtual void onRender() = 0;
 
+        // World space box around what onRender draws, views skip renderables whose box is outside the camera. False means never culled
+        virtual bool getBounds(AABB& bounds) const { return false; }
+
         void beginShader();
         void endShader();
 
         Layer getLayer() const { return mLayer; }
 
+        // Batched renderables only queue their draw in onRender, so there's no point binding their shader around it
+        bool isBatched() const { return mBatched; }
+
         SharedPtr<render::Shader> getShader() const { return mShader; }
         void setShader(SharedPtr<render::Shader> shader) { mShader = std::move(shader); }
 
@@ -59,9 +86,12 @@ namespace scorpion {
 
         render::Shader* shader() const { return mShader.get(); }
 
+        void setBatched(bool batched) { mBatched = batched; }
+
     private:
         Layer mLayer;
         SharedPtr<render::Shader> mShader;
+        bool mBatched = false;
     };
 }
 
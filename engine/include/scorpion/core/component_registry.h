@@ -0,0 +1,38 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_COMPONENT_REGISTRY_H
+#define SCORPION_COMPONENT_REGISTRY_H 1
+
+#include "scorpion/core/api.h"
+
+#include <bitset>
+#include <cstdint>
+#include <typeinfo>
+
+namespace scorpion {
+    using ComponentTypeId = uint32_t;
+
+    constexpr ComponentTypeId MaxComponentTypes = 128;
+
+    using ComponentSignature = std::bitset<MaxComponentTypes>;
+
+    // Ids are handed out by the engine library so every module agrees on them, typeid is only looked at the first time a type shows up
+    SCORPION_API ComponentTypeId RegisterComponentType(const std::type_info& type);
+
+    SCORPION_API ComponentTypeId GetComponentTypeCount();
+
+    template<class T>
+    ComponentTypeId GetComponentTypeId() {
+        static const ComponentTypeId id = RegisterComponentType(typeid(T));
+        return id;
+    }
+
+    template<class... Ts>
+    ComponentSignature MakeComponentSignature() {
+        ComponentSignature signature;
+        (signature.set(GetComponentTypeId<Ts>()), ...);
+        return signature;
+    }
+}
+
+#endif // SCORPION_COMPONENT_REGISTRY_H
@@ -0,0 +1,274 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_EVENT_BUS_H
+#define SCORPION_EVENT_BUS_H 1
+
+#include "scorpion/core/api.h"
+
+#include "scorpion/util/std_types.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <span>
+#include <typeinfo>
+
+namespace scorpion {
+    using EventTypeId = uint32_t;
+    using SubscriptionId = uint32_t;
+
+    constexpr EventTypeId MaxEventTypes = 256;
+
+    SCORPION_API EventTypeId RegisterEventType(const std::type_info& type);
+
+    template<class T>
+    EventTypeId GetEventTypeId() {
+        static const EventTypeId id = RegisterEventType(typeid(T));
+        return id;
+    }
+
+    class SCORPION_API EventChannelBase {
+    public:
+        virtual ~EventChannelBase() = default;
+
+        virtual void dispatch() = 0;
+    };
+
+    // Bounded multi producer single consumer ring, every slot is allocated up front
+    template<class T>
+    class EventChannel : public EventChannelBase {
+        static_assert(alignof(T) <= 16, "event channels are allocated from the 16 byte aligned heap");
+    public:
+        using Callback = std::function<void(std::span<const T>)>;
+
+        explicit EventChannel(size_t capacity) {
+            size_t size = 1;
+            while (size < capacity) size <<= 1;
+
+            mMask = size - 1;
+            mCells = static_cast<Cell*>(ScorpionHeapAlloc(size * sizeof(Cell)));
+            for (size_t i = 0; i < size; i++) {
+                new(&mCells[i]) Cell();
+                mCells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            mBatch.reserve(size);
+        }
+
+        ~EventChannel() override {
+            size_t pos = mDequeuePos;
+            while (true) {
+                Cell& cell = mCells[pos & mMask];
+                if (cell.sequence.load(std::memory_order_acquire) != pos + 1) break;
+
+                cell.value()->~T();
+                pos++;
+            }
+
+            for (size_t i = 0; i <= mMask; i++) mCells[i].~Cell();
+            ScorpionHeapFree(mCells);
+        }
+
+        // Safe from any thread. Returns false if the ring is full, in which case the event is dropped
+        bool push(T&& event) {
+            size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+
+            while (true) {
+                cell = &mCells[pos & mMask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+                if (diff == 0) {
+                    if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = mEnqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            new(cell->storage) T(std::move(event));
+            cell->sequence.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        // Subscribers added from inside a callback start with the next batch
+        SubscriptionId subscribe(Callback callback) {
+            SubscriptionId id = mNextSubscription++;
+
+            // growing mSubscribers mid dispatch would move the callback that's running right now
+            if (mDispatching) mAdded.push_back({id, std::move(callback), false});
+            else mSubscribers.push_back({id, std::move(callback), false});
+
+            return id;
+        }
+
+        // From inside a callback, including its own, the subscriber is only marked and skipped. It goes away once the dispatch is done
+        void unsubscribe(SubscriptionId id) {
+            auto matches = [id](const Subscriber& subscriber) { return subscriber.id == id; };
+
+            if (!mDispatching) {
+                std::erase_if(mSubscribers, matches);
+                std::erase_if(mAdded, matches);
+                return;
+            }
+
+            for (Subscriber& subscriber : mSubscribers) {
+                if (matches(subscriber)) {
+                    subscriber.removed = true;
+                    mDirty = true;
+                }
+            }
+
+            for (Subscriber& subscriber : mAdded) {
+                if (matches(subscriber)) subscriber.removed = true;
+            }
+        }
+
+        // Only events that were fully published before the drain are delivered, anything published by the subscribers goes out next time
+        void dispatch() override {
+            while (true) {
+                Cell& cell = mCells[mDequeuePos & mMask];
+                if (cell.sequence.load(std::memory_order_acquire) != mDequeuePos + 1) break;
+
+                T* value = cell.value();
+                mBatch.push_back(std::move(*value));
+                value->~T();
+
+                cell.sequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+                mDequeuePos++;
+            }
+
+            if (!mBatch.empty()) {
+                std::span<const T> events(mBatch.data(), mBatch.size());
+
+                mDispatching = true;
+
+                for (Subscriber& subscriber : mSubscribers) {
+                    if (!subscriber.removed) subscriber.callback(events);
+                }
+
+                mDispatching = false;
+
+                mBatch.clear();
+            }
+
+            if (mDirty) {
+                std::erase_if(mSubscribers, [](const Subscriber& subscriber) { return subscriber.removed; });
+                mDirty = false;
+            }
+
+            if (!mAdded.empty()) {
+                for (Subscriber& subscriber : mAdded) {
+                    if (!subscriber.removed) mSubscribers.push_back(std::move(subscriber));
+                }
+
+                mAdded.clear();
+            }
+        }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        struct Subscriber {
+            SubscriptionId id;
+            Callback callback;
+            bool removed;
+        };
+
+        Cell* mCells;
+        size_t mMask;
+
+        // padded rather than aligned apart, channels come from ScorpionHeapAlloc which doesn't do more than 16 bytes
+        std::atomic<size_t> mEnqueuePos = 0;
+        unsigned char mPadding[64];
+        size_t mDequeuePos = 0;
+
+        Vector<T> mBatch;
+        Vector<Subscriber> mSubscribers;
+        Vector<Subscriber> mAdded; // subscribed mid dispatch
+        SubscriptionId mNextSubscription = 1;
+        bool mDispatching = false;
+        bool mDirty = false;
+    };
+
+    // Typed events between components. Publishing is lock free and safe from any thread, delivery happens in batches whenever dispatch is called.
+    // Subscribing, unsubscribing and dispatching belong to the thread that owns the bus
+    class SCORPION_API EventBus {
+    public:
+        static constexpr size_t DefaultCapacity = 4096;
+
+        EventBus();
+        ~EventBus();
+
+        EventBus(const EventBus&) = delete;
+        EventBus& operator=(const EventBus&) = delete;
+
+        template<class T>
+        bool publish(T event) {
+            return getChannel<T>()->push(std::move(event));
+        }
+
+        // fn(std::span<const T>)
+        template<class T, class Fn>
+        SubscriptionId subscribe(Fn&& fn) {
+            return getChannel<T>()->subscribe(std::forward<Fn>(fn));
+        }
+
+        template<class T>
+        void unsubscribe(SubscriptionId id) {
+            getChannel<T>()->unsubscribe(id);
+        }
+
+        // Only has an effect before the channel for T exists, so call it before anything publishes or subscribes to T
+        template<class T>
+        void setCapacity(size_t capacity) {
+            createChannel<T>(capacity);
+        }
+
+        void dispatch();
+
+    private:
+        std::atomic<EventChannelBase*> mChannels[MaxEventTypes];
+        std::atomic<EventTypeId> mChannelCount = 0;
+
+        template<class T>
+        EventChannel<T>* getChannel() {
+            EventTypeId id = GetEventTypeId<T>();
+
+            EventChannelBase* channel = mChannels[id].load(std::memory_order_acquire);
+            if (channel == nullptr) return createChannel<T>(DefaultCapacity);
+
+            return static_cast<EventChannel<T>*>(channel);
+        }
+
+        template<class T>
+        EventChannel<T>* createChannel(size_t capacity) {
+            EventTypeId id = GetEventTypeId<T>();
+
+            EventChannelBase* existing = mChannels[id].load(std::memory_order_acquire);
+            if (existing != nullptr) return static_cast<EventChannel<T>*>(existing);
+
+            auto* channel = new(ScorpionHeapAlloc(sizeof(EventChannel<T>))) EventChannel<T>(capacity);
+            if (!install(id, channel, existing)) {
+                destroyChannel(channel);
+                return static_cast<EventChannel<T>*>(existing);
+            }
+
+            return channel;
+        }
+
+        bool install(EventTypeId id, EventChannelBase* channel, EventChannelBase*& existing);
+        static void destroyChannel(EventChannelBase* channel);
+    };
+}
+
+#endif // SCORPION_EVENT_BUS_H
@@ -0,0 +1,65 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_HOOK_SCHEDULER_H
+#define SCORPION_HOOK_SCHEDULER_H 1
+
+#include "scorpion/core/api.h"
+
+#include "scorpion/util/inplace_function.h"
+#include "scorpion/util/std_types.h"
+
+#include <mutex>
+
+namespace scorpion {
+    enum class HookPhase {
+        PreUpdate = 0,
+        PostUpdate,
+        PreRender,
+        PostRender,
+    };
+
+    constexpr size_t HookPhaseCount = 4;
+
+    class SCORPION_API UpdateHookHandle {
+    friend class HookScheduler;
+    public:
+        void unregister();
+
+    private:
+        bool mUnregistered = false;
+    };
+
+    using UpdateHook = InplaceFunction<void(UpdateHookHandle&), 48>;
+
+    // Hooks run in order of descending priority, hooks with equal priority keep the order they were added in.
+    // Consecutive thread safe hooks of the same priority run in parallel on the job system
+    class SCORPION_API HookScheduler {
+    public:
+        // Hooks added while their phase is running start running the next time the phase comes around. Thread safe hooks can call this too
+        void add(HookPhase phase, UpdateHook hook, int priority = 0, bool threadSafe = false);
+
+        void run(HookPhase phase);
+
+    private:
+        struct Entry {
+            UpdateHook hook;
+            int priority;
+            bool threadSafe;
+            UpdateHookHandle handle;
+        };
+
+        struct Phase {
+            Vector<Entry> entries;
+            Vector<Entry> pending;
+            bool running = false;
+            bool dirty = false;
+        };
+
+        Phase mPhases[HookPhaseCount];
+        std::mutex mMutex; // add, from thread safe hooks running in parallel
+
+        static void insert(Vector<Entry>& entries, Entry&& entry);
+    };
+}
+
+#endif // SCORPION_HOOK_SCHEDULER_H
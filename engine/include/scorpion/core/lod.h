@@ -0,0 +1,32 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_LOD_H
+#define SCORPION_LOD_H 1
+
+#include <cstdint>
+
+namespace scorpion {
+    // Actors get sorted into this many buckets by how much they matter to the active camera, 0 being the closest or biggest on screen
+    constexpr uint32_t LODCount = 4;
+
+    struct LODSettings {
+        enum class Metric {
+            Distance = 0,
+            ScreenSize,
+        };
+
+        bool enabled = false;
+        Metric metric = Metric::Distance;
+
+        // An actor goes into the first bucket whose distance it's closer than, or the first whose screen size it covers at least.
+        // Screen size is the diagonal of the actor's Transform box as a fraction of the view's height, so it doesn't change as the actor
+        // turns. That's about 1.7 times the height for a cube. Past the last one it's the last bucket
+        float distances[LODCount - 1] = { 30.0f, 80.0f, 200.0f };
+        float screenSizes[LODCount - 1] = { 0.2f, 0.05f, 0.01f };
+
+        // Throttled components in a bucket update every this many ticks. Actors are staggered by id so they don't all land on the same tick
+        uint32_t updateIntervals[LODCount] = { 1, 2, 4, 8 };
+    };
+}
+
+#endif // SCORPION_LOD_H
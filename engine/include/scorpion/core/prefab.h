@@ -0,0 +1,48 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_PREFAB_H
+#define SCORPION_PREFAB_H 1
+
+#include "scorpion/core/scene.h"
+
+#include <functional>
+
+namespace scorpion {
+    // A set of component types and their initial values. Build it once and instantiate it as many times as needed
+    class SCORPION_API Prefab {
+    public:
+        // The arguments are copied into the prefab and passed to the component constructor on every instantiation
+        template<class T, typename... Args>
+        Prefab& addComponent(Args&&... args) {
+            ComponentTypeId id = GetComponentTypeId<T>();
+            if (id + 1 > mComponentSlots) mComponentSlots = id + 1;
+
+            mComponents.push_back({sizeof(T), [...args = std::forward<Args>(args)](Actor* actor) {
+                actor->addComponent<T>(args...);
+            }});
+
+            return *this;
+        }
+
+        Actor* instantiate(Scene* scene = nullptr) const;
+
+        // Reserves every pool up front so instantiate doesn't allocate
+        Vector<Actor*> instantiate(size_t count, Scene* scene = nullptr) const;
+
+        void instantiate(size_t count, const std::function<void(Actor*, size_t)>& init, Scene* scene = nullptr) const;
+
+    private:
+        struct ComponentEntry {
+            size_t size;
+            std::function<void(Actor*)> construct;
+        };
+
+        Vector<ComponentEntry> mComponents;
+        size_t mComponentSlots = 0;
+
+        void reserve(Scene* scene, size_t count) const;
+        Actor* construct(Scene* scene) const;
+    };
+}
+
+#endif // SCORPION_PREFAB_H
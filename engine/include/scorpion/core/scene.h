@@ -4,36 +4,216 @@
 #define SCENE_H 1
 
 #include "scorpion/core/actor.h"
+#include "scorpion/core/event_bus.h"
+#include "scorpion/core/lod.h"
+#include "scorpion/core/spatial_index.h"
+#include "scorpion/core/view.h"
 
 #include "scorpion/engine_std/camera.h"
 
+#include "scorpion/hal/command_list.h"
+
+#include <chrono>
+
 namespace scorpion {
+    class SceneSnapshot;
+
+    // A camera drawing into a rectangle of the window or a render target. Views draw in the order they're listed, so one that renders into
+    // a target something else shows should come first
+    struct RenderView {
+        components::Camera* camera = nullptr; // without one the view only draws the 2D and UI layers
+        SharedPtr<render::RenderTarget> target; // nullptr draws to the window
+
+        // fractions of the target, top left origin
+        float x = 0.0f;
+        float y = 0.0f;
+        float width = 1.0f;
+        float height = 1.0f;
+
+        bool clear = true;
+        bool enabled = true;
+
+        uint32_t layers = ~0u; // RenderableComponent::LayerBit of every layer it draws
+    };
+
     class SCORPION_API Scene {
+    friend class Actor;
+    friend class Prefab;
+    friend struct EngineCore;
     public:
+        Scene() = default;
+        ~Scene();
+
+        Scene(const Scene&) = delete;
+        Scene& operator=(const Scene&) = delete;
+
         void update(double dt);
         void render();
 
+        // The actor is started at the start of the next tick, so one added from inside an update doesn't get updated until then either
         template<class T, typename... Args>
         T* addActor(Args&&... args) {
-            UniquePtr<T> actor = MakeUnique<T>(this, std::forward<Args>(args)...);
-            T* ptr = actor.get();
+            static_assert(alignof(T) <= 16, "actors are allocated from 16 byte aligned pools");
+
+            memory::Pool* pool = getObjectPool(sizeof(T));
+            T* actor = new(pool->allocate()) T(this, std::forward<Args>(args)...);
 
-            mActors.push_back(std::move(actor));
+            registerActor(actor, pool);
 
-            return ptr;
+            return actor;
         }
 
+        // Removing an actor while the scene is updating or rendering only queues it, the actor is destroyed at the end of the tick
         bool removeActor(Actor* actor);
 
+        // Makes room for count more actors without reallocating mActors or the actor pool
+        void reserveActors(size_t count);
+
+        // Objects of similar size share a pool, sizes are rounded up to 16 bytes
+        memory::Pool* getObjectPool(size_t size);
+
+        // Every actor that has all of Ts. The first call for a combination builds the matching set, after that it's maintained incrementally
+        template<class... Ts>
+        View<Ts...> view() {
+            return View<Ts...>(getQuery(MakeComponentSignature<Ts...>()));
+        }
+
+        Query* getQuery(const ComponentSignature& signature);
+
+        // Events published during a tick are delivered once every actor has been updated, right before destroyed actors are flushed
+        EventBus& getEventBus() { return mEventBus; }
+
+        // Raycasts, overlaps and nearest neighbour queries over every actor with a Transform. Built the first time it's asked for, scenes that
+        // never use it don't pay for keeping it up to date
+        SpatialIndex& getSpatialIndex();
+
+        // Background scenes keep ticking while another scene is active, spread over the job workers while the active scene ticks and renders.
+        // Only the active scene renders, and its update must not touch a background scene
+        bool isBackground() const { return mBackground; }
+        void setBackground(bool background) { mBackground = background; }
+
+        // Ticks per second when ticking in the background, 0 follows SetTargetTPS
+        int getTickRate() const { return mTickRate; }
+        void setTickRate(int tps) { mTickRate = tps; }
+
         components::Camera* getActiveCamera() const { return mActiveCamera; }
         void setActiveCamera(components::Camera* camera) { mActiveCamera = camera;  }
 
+        // Drawn in order every frame. With none the scene draws a single view of the active camera over the whole window.
+        // Culling and recording run on the job workers, one view and layer and a chunk of actors at a time, and the recorded commands get
+        // submitted on the calling thread in the same order a single threaded pass would draw them
+        Vector<RenderView>& getViews() { return mViews; }
+        const Vector<RenderView>& getViews() const { return mViews; }
+
+        // Buckets every active actor with a Transform by the active camera at the start of its update, which slows down its throttled
+        // components and tells renderables how much detail to bother with
+        LODSettings& getLODSettings() { return mLOD; }
+        const LODSettings& getLODSettings() const { return mLOD; }
+
         void reset();
 
+        // Destroys every actor right away, onDestroy included. Not meant to be called from inside update or render
+        void clear();
+
+        // Overwrites the snapshot with every actor and every component that has a serializer, reusing its memory
+        void snapshot(SceneSnapshot& snapshot) const;
+
+        // False if the data is malformed or the scene is in the middle of updating or rendering, the scene is untouched in that case
+        bool restore(const SceneSnapshot& snapshot);
+        bool restore(const uint8_t* data, size_t size);
+
     private:
-        Vector<UniquePtr<Actor>> mActors;
+        HashMap<size_t, UniquePtr<memory::Pool>> mPools;
+
+        Vector<Actor*> mActors;
+        Vector<Actor*> mDestroyQueue;
+        Vector<Actor*> mDestroying; // scratch for flushing
+        bool mIterating = false;
+
+        // New and reactivated actors and components wait here until the start of the next tick, where they get started if they haven't
+        // been yet and go into the active lists. That way update only ever walks things that are active and started.
+        // Both only get cleared once drained, so everything queued keeps its index and dequeuing just clears that slot
+        Vector<Actor*> mStartQueue;
+        Vector<Component*> mComponentStartQueue;
+
+        Vector<Actor*> mActiveActors; // with holes where actors got deactivated, compacted once per tick
+        bool mCompactActors = false;
+
+        Vector<uint32_t> mFreeIds;
+        uint32_t mNextId = 0;
+
+        HashMap<ComponentSignature, UniquePtr<Query>> mQueryLookup;
+        Vector<Query*> mQueries;
+
+        EventBus mEventBus;
+
+        UniquePtr<SpatialIndex> mSpatialIndex;
 
         components::Camera* mActiveCamera = nullptr;
+
+        Vector<RenderView> mViews;
+
+        LODSettings mLOD;
+        uint32_t mTick = 0; // staggers throttled updates
+
+        // the active camera boiled down to what bucketing an actor needs, per tick
+        struct LODCamera {
+            math::Vec3 position;
+            float thresholds[LODCount - 1]; // squared, distances or screen sizes depending on the metric
+            float sizeScale; // fraction of the view one world unit covers, at a distance of 1 unless orthographic
+            bool screenSize;
+            bool orthographic;
+        };
+
+        struct ViewState {
+            const RenderView* view;
+            int rect[4]; // pixels in its target
+            render::CameraConstants camera;
+            Frustum frustum;
+        };
+
+        struct RenderItem {
+            uint32_t view; // in mViewStates
+            RenderableComponent::Layer layer;
+            size_t begin; // actors
+            size_t end;
+            size_t culled;
+        };
+
+        // scratch for render, the lists keep their memory between frames
+        Vector<ViewState> mViewStates;
+        Vector<RenderItem> mRenderItems;
+        Vector<UniquePtr<render::CommandList>> mRenderLists; // one per item
+
+        Vector<Component*> mRestoreScratch;
+
+        bool mBackground = false;
+        int mTickRate = 0;
+
+        // background scheduling, only touched by the engine
+        std::chrono::high_resolution_clock::time_point mNextTick;
+        std::chrono::high_resolution_clock::time_point mLastTick;
+        double mLastTickCost = 0.0;
+        bool mBackgroundTick = false; // update is running as a background tick
+
+        void registerActor(Actor* actor, memory::Pool* pool);
+        void updateQueries(Actor* actor, const ComponentSignature& previous);
+
+        void queueStart(Actor* actor);
+        void queueStart(Component* component);
+        void dequeueStart(Actor* actor);
+        void dequeueStart(Component* component);
+        void startQueued();
+
+        void listActor(Actor* actor);
+        void unlistActor(Actor* actor);
+        void compactActiveActors();
+
+        bool makeLODCamera(LODCamera& camera) const;
+        uint8_t computeLOD(const Actor* actor, const LODCamera& camera) const;
+
+        void flushDestroyQueue();
+        void eraseActor(Actor* actor);
     };
 }
 
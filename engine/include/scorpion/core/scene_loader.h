@@ -0,0 +1,86 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_SCENE_LOADER_H
+#define SCORPION_SCENE_LOADER_H 1
+
+#include "scorpion/core/asset_manager.h"
+#include "scorpion/core/scene.h"
+
+#include "scorpion/hal/shader_cache.h"
+
+#include <functional>
+#include <mutex>
+
+namespace scorpion {
+    // A scene being built on the loader thread. The scene only becomes visible to the engine once it's built and everything it waits for
+    // is ready, and that happens at the start of a tick so nothing ever sees it half done
+    class SCORPION_API SceneLoad {
+    friend class SceneLoader;
+    public:
+        // Runs on the loader thread, so pass the scene along to anything that would otherwise fall back to the active one. Return false to
+        // throw the scene away
+        using Builder = std::function<bool(Scene* scene, SceneLoad& load)>;
+        using Task = std::function<void(Scene* scene)>;
+
+        enum class Status {
+            Building,
+            Finishing, // built, waiting on dependencies and main thread tasks
+            Done,
+            Failed,
+        };
+
+        SceneLoad(uint32_t id, Builder builder, bool activate);
+
+        uint32_t getId() const { return mId; }
+        Status getStatus() const;
+        bool isDone() const;
+
+        // 0 to 1, building is the first 90%
+        float getProgress() const;
+
+        // The following are for the builder
+
+        void setProgress(float progress);
+
+        // Handing over waits until these are done, so the first frame with the scene doesn't stall on them
+        void waitFor(SharedPtr<render::ShaderRequest> request);
+        void waitFor(assets::AssetHandle handle);
+
+        // For anything that has to happen on the main thread, like creating meshes. Tasks run after the builder returned, a few per tick
+        void onMainThread(Task task);
+
+    private:
+        uint32_t mId;
+        Builder mBuilder;
+        bool mActivate;
+
+        UniquePtr<Scene> mScene;
+
+        std::atomic<Status> mStatus = Status::Building;
+        std::atomic<float> mProgress = 0.0f;
+
+        std::mutex mMutex;
+        Vector<SharedPtr<render::ShaderRequest>> mShaders;
+        Vector<assets::AssetHandle> mAssets;
+        Vector<Task> mTasks;
+        size_t mNextTask = 0;
+        size_t mDependencies = 0; // total shaders and assets, for the progress
+
+        void build();
+
+        // main thread, true once the scene can be handed over or the load failed
+        bool pump(double budgetSeconds);
+    };
+
+    // Queues the load and returns right away, loads run one at a time in the order they were queued.
+    // The scene replaces whatever scene had the id before, and becomes the active one if activate is set or the old one was active
+    SCORPION_API SharedPtr<SceneLoad> LoadSceneAsync(uint32_t id, SceneLoad::Builder builder, bool activate = true);
+
+    // Runs main thread tasks of finished loads until budgetSeconds is used up and hands over every scene that's ready.
+    // The engine calls this at the start of every tick
+    SCORPION_API void PumpSceneLoads(double budgetSeconds);
+
+    SCORPION_API size_t GetPendingSceneLoads();
+}
+
+#endif // SCORPION_SCENE_LOADER_H
@@ -3,35 +3,43 @@
 #ifndef SCORPION_H
 #define SCORPION_H 1
 
+#include "scorpion/core/hook_scheduler.h"
 #include "scorpion/core/scene.h"
-
-#include <functional>
+#include "scorpion/core/scene_loader.h"
+#include "scorpion/core/stats.h"
 
 namespace scorpion {
-    class UpdateHookHandle {
-    friend struct EngineCore;
-    public:
-        void unregister();
-
-    private:
-        bool mUnregistered = false;
-    };
-
     SCORPION_API void Run();
 
     SCORPION_API void SetTargetFPS(int fps);
     SCORPION_API void SetTargetTPS(int tps);
 
     SCORPION_API Scene* CreateScene(uint32_t id);
+
+    // Takes over a scene built elsewhere and replaces whatever had the id. If the replaced scene was active the new one is too
+    SCORPION_API Scene* AddScene(uint32_t id, UniquePtr<Scene> scene);
     SCORPION_API Scene* GetActiveScene();
     SCORPION_API void SetActiveScene(uint32_t id);
 
     SCORPION_API Actor* CreateActor();
     SCORPION_API void DestroyActor(Actor* actor);
 
+    // Run stops after this many update ticks, 0 means no limit. Resets the tick count
+    SCORPION_API void SetTickBudget(uint64_t ticks);
+
+    // Makes ShouldRun return false. Safe to call from signal handlers and other threads
+    SCORPION_API void RequestStop();
+
+    // SIGINT and SIGTERM call RequestStop, mostly for headless servers that have no window to close
+    SCORPION_API void InstallStopSignalHandlers();
+
     // The following functions are exposed in case the user needs more control over the game loop
 
-    SCORPION_API void AddUpdateHook(std::function<void(UpdateHookHandle&)> hook);
+    // Same as AddHook(HookPhase::PreUpdate, hook)
+    SCORPION_API void AddUpdateHook(UpdateHook hook);
+
+    // PreUpdate and PostUpdate run around every scene update, PreRender and PostRender around every rendered frame
+    SCORPION_API void AddHook(HookPhase phase, UpdateHook hook, int priority = 0, bool threadSafe = false);
 
     SCORPION_API bool ShouldRun();
 
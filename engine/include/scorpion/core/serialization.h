@@ -0,0 +1,97 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_SERIALIZATION_H
+#define SCORPION_SERIALIZATION_H 1
+
+#include "scorpion/core/actor.h"
+#include "scorpion/core/asset_manager.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace scorpion {
+    class Scene;
+
+    // Type erased per component type hooks, they work on whole arrays so a snapshot is one indirect call per type instead of per component
+    struct ComponentSerializer {
+        const char* name = nullptr; // stable across builds unlike ComponentTypeId, this is what ends up on disk
+        uint32_t stateSize = 0;
+
+        void (*save)(Component* const* components, size_t count, uint8_t* states) = nullptr;
+        void (*load)(Component* const* components, size_t count, const uint8_t* states) = nullptr;
+        Component* (*create)(Actor* actor, const uint8_t* state) = nullptr;
+    };
+
+    SCORPION_API void RegisterComponentSerializer(ComponentTypeId id, const ComponentSerializer& serializer);
+
+    // nullptr for types that never registered one, those are skipped by snapshots
+    SCORPION_API const ComponentSerializer* GetComponentSerializer(ComponentTypeId id);
+    SCORPION_API const ComponentSerializer* FindComponentSerializer(const char* name, ComponentTypeId* id = nullptr);
+
+    // T needs a trivially copyable T::State, State saveState() const, void loadState(const State&) and a T(Actor*, const State&) constructor.
+    // The state's bytes go into the snapshot as they are, padding included, so saveState should start from a value initialized State{}
+    // Anything the state can't hold (pointers to other components, shared resources) has to be rebuilt in onStart
+    template<class T>
+    void RegisterComponentSerializer(const char* name) {
+        using State = typename T::State;
+        static_assert(std::is_trivially_copyable_v<State>, "component state gets memcpy'd around, it has to be trivially copyable");
+
+        ComponentSerializer serializer;
+        serializer.name = name;
+        serializer.stateSize = sizeof(State);
+
+        // memcpy instead of casting the buffer, snapshots can come straight out of a file at any alignment
+        serializer.save = [](Component* const* components, size_t count, uint8_t* states) {
+            for (size_t i = 0; i < count; i++) {
+                State state = static_cast<const T*>(components[i])->saveState();
+                memcpy(states + i * sizeof(State), &state, sizeof(State));
+            }
+        };
+
+        serializer.load = [](Component* const* components, size_t count, const uint8_t* states) {
+            for (size_t i = 0; i < count; i++) {
+                State state;
+                memcpy(&state, states + i * sizeof(State), sizeof(State));
+                static_cast<T*>(components[i])->loadState(state);
+            }
+        };
+
+        serializer.create = [](Actor* actor, const uint8_t* data) -> Component* {
+            State state;
+            memcpy(&state, data, sizeof(State));
+            return actor->addComponent<T>(state);
+        };
+
+        RegisterComponentSerializer(GetComponentTypeId<T>(), serializer);
+    }
+
+    // A scene's actors and every registered component's state in one flat buffer. The same bytes are the save file format.
+    // Keep one around and snapshot into it repeatedly, the buffer keeps its capacity so rollback doesn't allocate
+    class SCORPION_API SceneSnapshot {
+    friend class Scene;
+    public:
+        const uint8_t* getData() const { return mData.data(); }
+        size_t getSize() const { return mData.size(); }
+
+        bool isEmpty() const { return mData.empty(); }
+        void clear() { mData.clear(); }
+
+        // Copies a snapshot made elsewhere, false if it doesn't look like one
+        bool assign(const uint8_t* data, size_t size);
+
+    private:
+        Vector<uint8_t> mData;
+
+        // scratch for gathering components by type, kept for the capacity
+        Vector<Vector<Component*>> mGather;
+    };
+
+    // Restoring a scene that still has the same actors and components as when the snapshot was taken just overwrites their state, nothing
+    // is reallocated and nothing gets started again. Otherwise the scene is cleared and rebuilt, ids are kept but actor subclasses come back as
+    // plain actors and components without a serializer are gone
+    SCORPION_API bool SaveScene(const Scene* scene, const char* path);
+    SCORPION_API bool LoadScene(Scene* scene, const char* path);
+    SCORPION_API bool LoadScene(Scene* scene, const assets::AssetHandle& handle);
+}
+
+#endif // SCORPION_SERIALIZATION_H
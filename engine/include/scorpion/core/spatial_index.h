@@ -0,0 +1,122 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_SPATIAL_INDEX_H
+#define SCORPION_SPATIAL_INDEX_H 1
+
+#include "scorpion/core/api.h"
+
+#include "scorpion/util/bounds.h"
+#include "scorpion/util/math.h"
+#include "scorpion/util/std_types.h"
+
+#include <cfloat>
+#include <cstdint>
+
+namespace scorpion {
+    class Actor;
+
+    namespace components {
+        class Transform;
+    }
+
+    struct Ray {
+        math::Vec3 origin;
+        math::Vec3 direction; // normalized
+        float maxDistance = FLT_MAX;
+        Actor* ignore = nullptr; // usually whoever is casting it, so rays starting inside their own box don't hit themselves
+    };
+
+    struct RayHit {
+        Actor* actor = nullptr; // nullptr on a miss
+        float distance = 0.0f;
+        math::Vec3 point;
+        math::Vec3 normal;
+    };
+
+    // Dynamic AABB tree over every actor in a scene that has a Transform. An actor's shape is the box its Transform describes, size being the
+    // full extent along each local axis (what CubeRenderer draws). Leaves store a slightly fattened box, so things that only move a little don't
+    // touch the tree at all. Inactive actors stay in the tree but never show up in results.
+    //
+    // Queries see the transforms as of the last refresh. The scene refreshes after every update, call refresh yourself if something has to
+    // be visible right away. Queries are safe to run from several threads at once, refreshing or changing the scene meanwhile isn't
+    class SCORPION_API SpatialIndex {
+    friend class Scene;
+    public:
+        static constexpr uint32_t NullNode = UINT32_MAX;
+
+        SpatialIndex() = default;
+
+        SpatialIndex(const SpatialIndex&) = delete;
+        SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+        // Picks up every transform that changed since the last refresh, only the ones that left their fat box get reinserted
+        void refresh();
+
+        size_t size() const { return mProxies.size(); }
+
+        // Closest hit, false if the ray hits nothing within maxDistance
+        bool raycast(const Ray& ray, RayHit& hit) const;
+
+        // Stops at the first hit, whichever it is. Enough for line of sight and a lot cheaper than finding the closest
+        bool raycastAny(const Ray& ray) const;
+
+        // Batched versions, spread over the job workers
+        void raycast(const Ray* rays, size_t count, RayHit* hits) const;
+        void raycastAny(const Ray* rays, size_t count, bool* results) const;
+
+        // These append to out and return how many they added
+        size_t overlapBox(const AABB& box, Vector<Actor*>& out) const;
+        size_t overlapSphere(math::Vec3 center, float radius, Vector<Actor*>& out) const;
+
+        // Up to k actors closest to point, nearest first. Distance is to the actor's box, not its position
+        size_t nearest(math::Vec3 point, size_t k, Vector<Actor*>& out, float maxDistance = FLT_MAX) const;
+
+    private:
+        struct Node {
+            AABB box; // fattened for leaves
+            uint32_t parent = NullNode;
+            uint32_t child1 = NullNode; // NullNode for leaves
+            uint32_t child2 = NullNode;
+            int32_t height = 0; // 0 for leaves, -1 for free nodes
+
+            components::Transform* transform = nullptr;
+            uint32_t proxy = 0; // index in mProxies
+
+            bool isLeaf() const { return child1 == NullNode; }
+        };
+
+        Vector<Node> mNodes;
+        uint32_t mRoot = NullNode;
+        uint32_t mFreeList = NullNode;
+
+        Vector<uint32_t> mProxies; // leaf per tracked transform, dense for refresh
+        struct BuildItem {
+            math::Vec3 center;
+            uint32_t leaf; // in mScratch
+        };
+
+        Vector<uint32_t> mMoved; // scratch for refresh
+        Vector<Node> mScratch; // for rebuild
+        Vector<BuildItem> mBuildItems;
+
+        void add(components::Transform* transform);
+        void remove(components::Transform* transform);
+
+        // a leaf that isn't in the tree yet, for filling it in bulk before a rebuild
+        uint32_t createLeaf(components::Transform* transform);
+
+        // Builds the whole tree from scratch, top down. A lot faster than inserting leaves one by one and makes a better tree, so it's used
+        // whenever a large part of the tree changes at once
+        void rebuild();
+        uint32_t build(BuildItem* items, size_t count, uint32_t parent);
+
+        uint32_t allocateNode();
+        void freeNode(uint32_t node);
+
+        void insertLeaf(uint32_t leaf);
+        void removeLeaf(uint32_t leaf);
+        uint32_t balance(uint32_t node);
+    };
+}
+
+#endif // SCORPION_SPATIAL_INDEX_H
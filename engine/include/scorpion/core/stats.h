@@ -0,0 +1,67 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_STATS_H
+#define SCORPION_STATS_H 1
+
+#include "scorpion/core/api.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scorpion::stats {
+    enum class Stat {
+        UpdateTime = 0,
+        RenderTime,
+        TicksPerFrame,
+        ActorsUpdated,
+        ComponentsUpdated,
+        DrawCalls,
+        ShaderBinds,
+        UniformUploads,
+        TrianglesSubmitted,
+        Allocations,
+        TimerWait,
+        TimerOvershoot,
+        BackgroundTime, // time spent ticking background scenes, added up over every worker
+        BackgroundTicks,
+        RenderablesCulled,
+        SpritesDrawn,
+        ComponentsThrottled, // throttled components that sat out a tick
+        BackgroundActorsUpdated, // ActorsUpdated and ComponentsUpdated only count the active scene
+        BackgroundComponentsUpdated,
+
+        Count
+    };
+
+    constexpr size_t StatCount = static_cast<size_t>(Stat::Count);
+
+    // Number of frames every summary looks back over
+    constexpr size_t WindowSize = 240;
+
+    // Times are reported in milliseconds, everything else is a per frame count
+    struct Summary {
+        double last = 0.0;
+        double min = 0.0;
+        double avg = 0.0;
+        double p99 = 0.0;
+        size_t samples = 0;
+    };
+
+    // Safe from any thread, adds to the frame that's currently being measured
+    SCORPION_API void Add(Stat stat, uint64_t value = 1);
+    SCORPION_API void AddTime(Stat stat, double seconds);
+
+    // Closes the current frame and pushes its totals into the rolling windows. Called by the engine after every rendered frame
+    SCORPION_API void EndFrame();
+
+    SCORPION_API Summary Get(Stat stat);
+    SCORPION_API const char* GetName(Stat stat);
+    SCORPION_API bool IsTime(Stat stat);
+
+    SCORPION_API void Reset();
+
+    SCORPION_API bool DumpCSV(const char* path);
+    SCORPION_API bool DumpJSON(const char* path);
+}
+
+#endif // SCORPION_STATS_H
@@ -0,0 +1,78 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_VIEW_H
+#define SCORPION_VIEW_H 1
+
+#include "scorpion/core/actor.h"
+
+#include "scorpion/foundation/jobs/job_system.h"
+
+#include <utility>
+
+namespace scorpion {
+    // The set of actors in a scene whose signature contains every bit of the query signature. Kept up to date by the scene as components come and go
+    class SCORPION_API Query {
+    friend class Scene;
+    public:
+        explicit Query(const ComponentSignature& signature) : mSignature(signature) {}
+
+        const ComponentSignature& getSignature() const { return mSignature; }
+        const Vector<Actor*>& getActors() const { return mActors; }
+
+        bool matches(const ComponentSignature& signature) const {
+            return (signature & mSignature) == mSignature;
+        }
+
+    private:
+        ComponentSignature mSignature;
+        Vector<Actor*> mActors;
+        Vector<uint32_t> mSparse; // actor id -> index in mActors + 1, 0 if the actor isn't part of the query
+
+        void add(Actor* actor);
+        void remove(Actor* actor);
+    };
+
+    // Cheap to copy, it only points at the query owned by the scene.
+    // Adding or removing the viewed component types while iterating can make the iteration skip actors, do that after instead
+    template<class... Ts>
+    class View {
+    public:
+        explicit View(Query* query) : mQuery(query) {}
+
+        size_t size() const { return mQuery->getActors().size(); }
+        bool empty() const { return mQuery->getActors().empty(); }
+
+        auto begin() const { return mQuery->getActors().begin(); }
+        auto end() const { return mQuery->getActors().end(); }
+
+        // fn(Actor*, Ts*...)
+        template<class Fn>
+        void each(Fn&& fn) const {
+            eachRange(0, mQuery->getActors().size(), fn, std::index_sequence_for<Ts...>());
+        }
+
+        // Same as each but spread over the job system. fn has to be safe to call from several threads at once, and must not touch the scene structure
+        template<class Fn>
+        void parallelEach(Fn&& fn, size_t grainSize = 256) const {
+            jobs::ParallelFor(mQuery->getActors().size(), grainSize, [this, &fn](size_t begin, size_t end) {
+                eachRange(begin, end, fn, std::index_sequence_for<Ts...>());
+            });
+        }
+
+    private:
+        Query* mQuery;
+
+        template<class Fn, size_t... I>
+        void eachRange(size_t begin, size_t end, Fn& fn, std::index_sequence<I...>) const {
+            const ComponentTypeId ids[] = { GetComponentTypeId<Ts>()..., 0 };
+            const Vector<Actor*>& actors = mQuery->getActors();
+
+            for (size_t i = begin; i < end && i < actors.size(); i++) {
+                Actor* actor = actors[i];
+                fn(actor, static_cast<Ts*>(actor->getComponent(ids[I]))...);
+            }
+        }
+    };
+}
+
+#endif // SCORPION_VIEW_H
@@ -4,6 +4,7 @@
 #define SCORPION_CAMERA_H 1
 
 #include "scorpion/core/component.h"
+#include "scorpion/core/spatial_index.h"
 
 #include "scorpion/engine_std/transform.h"
 
@@ -17,7 +18,19 @@ namespace scorpion::components {
             Orthographic,
         };
 
-        Camera(Actor* owner, math::Vec3 position, math::Vec3 target, math::Vec3 up, float fovY, Projection projection);
+        struct State {
+            math::Vec3 position;
+            math::Vec3 target;
+            math::Vec3 up;
+            float fovY;
+            Projection projection;
+            float nearPlane;
+            float farPlane;
+        };
+
+        // fovY is in degrees for perspective cameras and the height of the view in world units for orthographic ones
+        Camera(Actor* owner, math::Vec3 position, math::Vec3 target, math::Vec3 up, float fovY, Projection projection, float nearPlane = 0.01f, float farPlane = 1000.0f);
+        Camera(Actor* owner, const State& state);
 
         void onStart() override;
         void onUpdate(double dt) override;
@@ -29,12 +42,28 @@ namespace scorpion::components {
         math::Vec3 getRight() const;
         float getFovY() const;
         Projection getProjection() const;
+        float getNearPlane() const;
+        float getFarPlane() const;
 
         void setPosition(math::Vec3 position);
         void setTarget(math::Vec3 target);
         void setUp(math::Vec3 up);
         void setFovY(float fovY);
         void setProjection(Projection projection);
+        void setClipPlanes(float nearPlane, float farPlane);
+
+        // Size of what the camera renders into, only the aspect ratio matters. The scene keeps it in sync with the window
+        void setViewport(int width, int height);
+
+        // Cached, rebuilt on the first call after something they depend on changed. That first call isn't safe to race, so get them once
+        // before handing the camera to other threads
+        const math::Matrix4& getView() const;
+        const math::Matrix4& getProjectionMatrix() const;
+        const math::Matrix4& getViewProjection() const;
+        const Frustum& getFrustum() const;
+
+        State saveState() const;
+        void loadState(const State& state);
 
     private:
         Transform* mTransform;
@@ -44,6 +73,18 @@ namespace scorpion::components {
         math::Vec3 mUp;
         float mFovY;
         Projection mProjection;
+        float mNearPlane;
+        float mFarPlane;
+        float mAspect = 16.0f / 9.0f;
+
+        mutable math::Matrix4 mView;
+        mutable math::Matrix4 mProjectionMatrix;
+        mutable math::Matrix4 mViewProjection;
+        mutable Frustum mFrustum;
+        mutable bool mViewDirty = true;
+        mutable bool mProjectionDirty = true;
+
+        void updateMatrices() const;
     };
 }
 
@@ -12,18 +12,27 @@
 namespace scorpion::components {
     class SCORPION_API CubeRenderer : public RenderableComponent {
     public:
+        struct State {
+            math::Color color;
+        };
+
         CubeRenderer(Actor* actor, math::Color color);
+        CubeRenderer(Actor* actor, const State& state);
 
         void onStart() override;
         void onRender() override;
+        bool getBounds(AABB& bounds) const override;
 
         math::Color getColor() const;
 
+        State saveState() const;
+        void loadState(const State& state);
+
     protected:
         void beginShader0() override;
 
     private:
-        Transform* mTransform;
+        Transform* mTransform = nullptr;
 
         math::Color mColor;
     };
@@ -0,0 +1,47 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_MESH_RENDERER_H
+#define SCORPION_MESH_RENDERER_H 1
+
+#include "scorpion/core/component.h"
+#include "scorpion/core/lod.h"
+
+#include "scorpion/engine_std/transform.h"
+
+#include "scorpion/hal/mesh.h"
+
+#include "scorpion/util/math.h"
+
+namespace scorpion::components {
+    // Draws a shared mesh through the instanced path, every MeshRenderer with the same mesh and shader ends up in one draw call.
+    // Without a shader it gets render::GetInstancedShader when it starts. A custom one needs an instanceTransform attribute (and can
+    // have instanceColor) to stay on that path, otherwise the backend falls back to one draw per instance
+    class SCORPION_API MeshRenderer : public RenderableComponent {
+    public:
+        MeshRenderer(Actor* actor, SharedPtr<render::Mesh> mesh, math::Color color = math::Color::white);
+
+        void onStart() override;
+        void onRender() override;
+        bool getBounds(AABB& bounds) const override;
+
+        const SharedPtr<render::Mesh>& getMesh() const;
+        void setMesh(SharedPtr<render::Mesh> mesh);
+
+        // Drawn instead of the mesh while the actor is in a coarser LOD bucket, buckets without one use the next finer bucket's.
+        // Bucket 0 is the mesh itself. Culling always goes by the mesh's bounds, so keep them inside it
+        const SharedPtr<render::Mesh>& getLODMesh(uint32_t lod) const;
+        void setLODMesh(uint32_t lod, SharedPtr<render::Mesh> mesh);
+
+        math::Color getColor() const;
+        void setColor(math::Color color);
+
+    private:
+        Transform* mTransform = nullptr;
+
+        SharedPtr<render::Mesh> mMesh;
+        SharedPtr<render::Mesh> mLODMeshes[LODCount - 1]; // buckets 1 and up
+        math::Color mColor;
+    };
+}
+
+#endif // SCORPION_MESH_RENDERER_H
@@ -0,0 +1,103 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_PARTICLE_EMITTER_H
+#define SCORPION_PARTICLE_EMITTER_H 1
+
+#include "scorpion/core/component.h"
+
+#include "scorpion/engine_std/transform.h"
+
+#include "scorpion/hal/mesh.h"
+
+#include "scorpion/util/math.h"
+
+namespace scorpion::components {
+    // Lots of short lived, non colliding particles without an actor each. They live in flat arrays per emitter, get simulated 4 at a
+    // time and drawn as one instanced draw of the mesh. Particles are in world space, moving the emitter doesn't drag the live ones along.
+    // Dead particles get the last live one moved into their slot, so the order of particles changes and nothing should depend on it
+    class SCORPION_API ParticleEmitter : public RenderableComponent {
+    public:
+        struct Settings {
+            uint32_t maxParticles = 1000;
+            float rate = 100.0f; // per second, 0 to only emit with burst
+
+            float minLifetime = 1.0f; // seconds
+            float maxLifetime = 2.0f;
+            float minSpeed = 1.0f;
+            float maxSpeed = 3.0f;
+
+            math::Vec3 direction = math::Vec3(0, 1, 0); // local to the emitter's rotation
+            float spread = 0.5f; // radians between direction and the edge of the cone particles fly out in
+            math::Vec3 extents = math::Vec3::zero; // half size of the box around the emitter they spawn in
+
+            math::Vec3 gravity = math::Vec3(0, -9.81f, 0);
+            float drag = 0.0f; // fraction of the velocity lost per second, roughly
+
+            // size is the edge length of the mesh's unit box, both fade linearly over a particle's life
+            float startSize = 0.1f;
+            float endSize = 0.0f;
+            math::Color startColor = math::Color::white;
+            math::Color endColor = { 255, 255, 255, 0 };
+        };
+
+        // mesh nullptr is the cube mesh. Draws with the instanced shader unless another one is set. Both get looked up in onStart, so
+        // constructing one doesn't touch the GPU
+        ParticleEmitter(Actor* actor, const Settings& settings, SharedPtr<render::Mesh> mesh = nullptr);
+
+        void onStart() override;
+        void onUpdate(double dt) override;
+        void onRender() override;
+        bool getBounds(AABB& bounds) const override;
+
+        // Spawns count particles right away, as many as fit under maxParticles
+        void burst(uint32_t count);
+
+        // Kills every particle
+        void clear();
+
+        bool isEmitting() const;
+        void setEmitting(bool emitting);
+
+        const Settings& getSettings() const;
+        void setSettings(const Settings& settings);
+
+        uint32_t getParticleCount() const;
+
+    private:
+        Transform* mTransform = nullptr;
+
+        Settings mSettings;
+        SharedPtr<render::Mesh> mMesh;
+        bool mEmitting = true;
+
+        uint32_t mCount = 0;
+        uint32_t mCapacity = 0;
+        float mSpawnAccumulator = 0.0f;
+        uint64_t mRandom;
+
+        // one array per field so simulate can load 4 of the same thing at once
+        Vector<float> mPositionX;
+        Vector<float> mPositionY;
+        Vector<float> mPositionZ;
+        Vector<float> mVelocityX;
+        Vector<float> mVelocityY;
+        Vector<float> mVelocityZ;
+        Vector<float> mAge; // seconds
+        Vector<float> mInverseLifetime;
+
+        // written in the same pass that moves the particles, so every view that draws this tick shares them
+        Vector<render::MeshInstance> mInstances;
+        AABB mBounds; // around the particle centers only, getBounds grows it by the mesh
+        Vector<uint32_t> mDead; // ascending indices simulate found dead, for compact
+
+        void reserve(uint32_t capacity);
+        void spawn(uint32_t count);
+        void simulate(float dt);
+        void compact();
+        void writeInstance(uint32_t index, float t);
+
+        float nextFloat(float min, float max);
+    };
+}
+
+#endif // SCORPION_PARTICLE_EMITTER_H
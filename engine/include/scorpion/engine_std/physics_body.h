@@ -14,13 +14,29 @@ namespace scorpion::components {
     public:
         static const math::Vec3 gravity;
 
+        // Everything the simulation needs to pick up exactly where it left off, accumulators included
+        struct State {
+            float mass;
+            bool gravity;
+            bool kinematic;
+            math::Vec3 linearVelocity;
+            math::Vec3 angularVelocity;
+            math::Matrix3 inertiaTensor;
+            math::Vec3 forceAccumulator;
+            math::Vec3 torqueAccumulator;
+        };
+
         PhysicsBody(Actor* owner, float mass, bool gravity = true, bool kinematic = false);
+        PhysicsBody(Actor* owner, const State& state);
 
         void onStart() override;
         void onUpdate(double dt) override;
 
         void applyTorque(const math::Vec3& torque);
 
+        State saveState() const;
+        void loadState(const State& state);
+
     private:
         Transform* mTransform;
 
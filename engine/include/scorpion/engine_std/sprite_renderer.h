@@ -0,0 +1,47 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_SPRITE_RENDERER_H
+#define SCORPION_SPRITE_RENDERER_H 1
+
+#include "scorpion/core/component.h"
+
+#include "scorpion/engine_std/transform.h"
+
+#include "scorpion/hal/sprite_batch.h"
+
+#include "scorpion/util/math.h"
+
+namespace scorpion::components {
+    // Draws a texture region through the sprite batcher. The Transform is read in view pixels: position x and y is the center,
+    // size x and y the size and the rotation around z turns it. Sprites from the same atlas page batch into one draw call
+    class SCORPION_API SpriteRenderer : public RenderableComponent {
+    public:
+        SpriteRenderer(Actor* actor, const render::TextureRegion& region, math::Color color = math::Color::white, Layer layer = Layer::World2D, int order = 0);
+
+        void onStart() override;
+        void onRender() override;
+
+        const render::TextureRegion& getRegion() const;
+        void setRegion(const render::TextureRegion& region);
+
+        math::Color getColor() const;
+        void setColor(math::Color color);
+
+        // higher draws on top, see render::SpriteQueue
+        int getOrder() const;
+        void setOrder(int order);
+
+        render::BlendMode getBlend() const;
+        void setBlend(render::BlendMode blend);
+
+    private:
+        Transform* mTransform = nullptr;
+
+        render::TextureRegion mRegion;
+        math::Color mColor;
+        int mOrder;
+        render::BlendMode mBlend = render::BlendMode::Alpha;
+    };
+}
+
+#endif // SCORPION_SPRITE_RENDERER_H
@@ -4,13 +4,22 @@
 #define SCORPION_STD_TRANSFORM_H 1
 
 #include "scorpion/core/component.h"
+#include "scorpion/core/spatial_index.h"
 
 #include "scorpion/util/math.h"
 
 namespace scorpion::components {
     class SCORPION_API Transform : public Component {
+    friend class scorpion::SpatialIndex;
     public:
+        struct State {
+            math::Vec3 position;
+            math::Vec3 size;
+            math::Quat rotation;
+        };
+
         Transform(Actor* owner, math::Vec3 position, math::Vec3 size, math::Quat rotation);
+        Transform(Actor* owner, const State& state);
 
         math::Matrix4 getMatrix() const;
 
@@ -22,10 +31,16 @@ namespace scorpion::components {
         void setSize(math::Vec3 size);
         void setRotation(math::Quat rotation);
 
+        State saveState() const;
+        void loadState(const State& state);
+
     private:
         math::Vec3 mPosition;
         math::Vec3 mSize;
         math::Quat mRotation;
+
+        uint32_t mSpatialNode = SpatialIndex::NullNode;
+        bool mMoved = false; // since the spatial index last looked
     };
 }
 
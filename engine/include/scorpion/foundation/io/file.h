@@ -0,0 +1,21 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_FILE_H
+#define SCORPION_FILE_H 1
+
+#include "scorpion/core/api.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scorpion::io {
+    // Writes the whole file next to path and renames it over, so a crash mid write never eats the previous one
+    SCORPION_API bool WriteFile(const char* path, const void* data, size_t size);
+
+    // Rounds up to 8 bytes, the binary formats keep every array 8 byte aligned
+    constexpr size_t Pad(size_t size) {
+        return (size + 7) & ~static_cast<size_t>(7);
+    }
+}
+
+#endif // SCORPION_FILE_H
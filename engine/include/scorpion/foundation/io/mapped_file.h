@@ -0,0 +1,52 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_MAPPED_FILE_H
+#define SCORPION_MAPPED_FILE_H 1
+
+#include "scorpion/core/api.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace scorpion::io {
+    // Read-only view of a whole file. Pages come in from disk on first touch and the OS can drop them again whenever,
+    // so the pointer stays valid until close() no matter what the residency hints do
+    class SCORPION_API MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        bool open(const char* path);
+        void close();
+
+        bool isOpen() const;
+
+        const uint8_t* data() const;
+        size_t size() const;
+
+        // Faults the range in so later reads don't stall. Blocks until it's resident, meant for io threads
+        void prefetch(size_t offset, size_t size) const;
+
+        // Drops the pages fully inside the range from memory, touching them again just reads them back from disk
+        void evict(size_t offset, size_t size) const;
+
+        static size_t GetPageSize();
+
+    private:
+        const uint8_t* mData = nullptr;
+        size_t mSize = 0;
+
+#ifdef _WIN32
+        void* mFile = nullptr;
+        void* mMapping = nullptr;
+#endif
+    };
+}
+
+#endif // SCORPION_MAPPED_FILE_H
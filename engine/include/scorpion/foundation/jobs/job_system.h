@@ -0,0 +1,53 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_JOB_SYSTEM_H
+#define SCORPION_JOB_SYSTEM_H 1
+
+#include "scorpion/core/api.h"
+
+#include "scorpion/util/std_types.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace scorpion::jobs {
+    // Worker threads are started the first time they're needed, the calling thread always helps out on top of these
+    SCORPION_API size_t GetWorkerCount();
+
+    SCORPION_API bool IsWorkerThread();
+
+    // Splits [0, count) into ranges of at most grainSize and runs fn over them on the workers, returns once every range is done.
+    // Calling this from inside a job runs the whole thing inline
+    SCORPION_API void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& fn);
+
+    // Called over and over by a thread waiting on workers that haven't finished their part yet, instead of just yielding. The renderer
+    // compiles shaders in here, a job blocked on a shader would otherwise wait for a render thread that's waiting for it
+    SCORPION_API void SetWaitCallback(void (*callback)());
+
+    struct Batch;
+
+    // A ParallelFor that doesn't wait. The workers get going on it while the caller does something else, and wait picks up whatever they
+    // haven't gotten to yet. Without workers, or started from inside a job, all of it runs in wait
+    class SCORPION_API AsyncFor {
+    public:
+        AsyncFor();
+        ~AsyncFor(); // waits
+
+        AsyncFor(const AsyncFor&) = delete;
+        AsyncFor& operator=(const AsyncFor&) = delete;
+
+        // Waits for the previous run first, there's only ever one in flight
+        void start(size_t count, size_t grainSize, std::function<void(size_t begin, size_t end)> fn);
+        void wait();
+
+        bool isRunning() const { return mRunning; }
+
+    private:
+        UniquePtr<Batch> mBatch;
+        std::function<void(size_t, size_t)> mFn;
+        bool mRunning = false;
+        bool mSubmitted = false;
+    };
+}
+
+#endif // SCORPION_JOB_SYSTEM_H
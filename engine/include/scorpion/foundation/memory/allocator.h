@@ -23,12 +23,29 @@ SCORPION_API void ScorpionArenaReset(ScorpionArena* arena);
 
 SCORPION_API void* ScorpionArenaAlloc(ScorpionArena* arena, size_t size);
 
+typedef struct ScorpionPool ScorpionPool;
+
+SCORPION_API ScorpionPool* ScorpionCreatePool(size_t blockSize, size_t blocksPerChunk);
+
+SCORPION_API void ScorpionDestroyPool(ScorpionPool* pool);
+
+SCORPION_API void ScorpionPoolReserve(ScorpionPool* pool, size_t count);
+
+SCORPION_API void* ScorpionPoolAlloc(ScorpionPool* pool);
+
+SCORPION_API void ScorpionPoolFree(ScorpionPool* pool, void* ptr);
+
+SCORPION_API size_t ScorpionPoolBlockSize(const ScorpionPool* pool);
+
 SCORPION_API void* ScorpionHeapAlloc(size_t size);
 
 SCORPION_API void* ScorpionHeapRealloc(void* ptr, size_t size);
 
 SCORPION_API void ScorpionHeapFree(void* ptr);
 
+// Total number of ScorpionHeapAlloc calls since startup
+SCORPION_API size_t ScorpionHeapAllocationCount(void);
+
 #ifdef __cplusplus
 }
 
@@ -54,6 +71,39 @@ namespace scorpion::memory {
         ScorpionArena* mArena;
     };
 
+    // Fixed size blocks, freed blocks are reused before new chunks get allocated
+    class Pool {
+    public:
+        Pool(size_t blockSize, size_t blocksPerChunk)
+            : mPool(ScorpionCreatePool(blockSize, blocksPerChunk)) {}
+
+        ~Pool() {
+            ScorpionDestroyPool(mPool);
+        }
+
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        void reserve(size_t count) {
+            ScorpionPoolReserve(mPool, count);
+        }
+
+        void* allocate() {
+            return ScorpionPoolAlloc(mPool);
+        }
+
+        void free(void* ptr) {
+            ScorpionPoolFree(mPool, ptr);
+        }
+
+        size_t getBlockSize() const {
+            return ScorpionPoolBlockSize(mPool);
+        }
+
+    private:
+        ScorpionPool* mPool;
+    };
+
     // Used for stl containers and shit
     template<typename T>
     struct StdHeapAllocator {
@@ -0,0 +1,67 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_PROFILER_H
+#define SCORPION_PROFILER_H 1
+
+#include "scorpion/core/api.h"
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define SCORPION_PROFILER_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define SCORPION_PROFILER_TSC 1
+#endif
+
+// Zones are only recorded when the engine is built with SCORPION_ENABLE_PROFILER, otherwise the macros expand to nothing
+namespace scorpion::profiler {
+    inline uint64_t Now() {
+#ifdef SCORPION_PROFILER_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    SCORPION_API bool IsEnabled();
+    SCORPION_API void SetEnabled(bool enabled);
+
+    // name has to outlive the profiler, string literals are the intended use
+    SCORPION_API void Record(const char* name, uint64_t start, uint64_t end);
+
+    SCORPION_API void SetThreadName(const char* name);
+
+    SCORPION_API void Clear();
+
+    // Chrome trace_event json, opens in chrome://tracing and ui.perfetto.dev. Don't call it while other threads are recording
+    SCORPION_API bool ExportChromeTrace(const char* path);
+
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name) : mName(name), mStart(Now()) {}
+
+        ~ProfileScope() {
+            Record(mName, mStart, Now());
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* mName;
+        uint64_t mStart;
+    };
+}
+
+#ifdef SCORPION_PROFILER
+    #define SCORPION_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define SCORPION_PROFILE_CONCAT(a, b) SCORPION_PROFILE_CONCAT_IMPL(a, b)
+    #define SCORPION_PROFILE_SCOPE(name) ::scorpion::profiler::ProfileScope SCORPION_PROFILE_CONCAT(scorpionProfileScope, __LINE__)(name)
+#else
+    #define SCORPION_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif // SCORPION_PROFILER_H
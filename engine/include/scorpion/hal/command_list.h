@@ -0,0 +1,71 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_COMMAND_LIST_H
+#define SCORPION_COMMAND_LIST_H 1
+
+#include "scorpion/hal/mesh.h"
+#include "scorpion/hal/renderer.h"
+#include "scorpion/hal/sprite_batch.h"
+
+namespace scorpion::render {
+    // Draws recorded on any thread and submitted later, in order, on the render thread. While a list is recording on a thread, every draw,
+    // shader bind and uniform that thread makes goes into the list instead of the backend, so onRender code doesn't need to know about it.
+    // Shaders and meshes are referenced, not copied, and have to stay alive until the list is submitted
+    class SCORPION_API CommandList {
+    public:
+        // camera is what GetCameraConstants returns on this thread until end
+        void begin(const CameraConstants& camera);
+        void end();
+
+        // Render thread only. Mesh instances go to the regular mesh queue so they get drawn when the 3D pass ends, together with
+        // instances of the same mesh from other lists. Sprites work the same way
+        void submit();
+
+        void clear();
+        bool empty() const { return mEntries.empty() && mMeshes.empty() && mSprites.empty(); }
+
+        // nullptr on threads that aren't recording
+        static CommandList* getCurrent();
+
+        // What the renderer records into the current list
+
+        void bindShader(Shader* shader);
+        void unbindShader(Shader* shader);
+        void setUniform(Shader* shader, const String& name, UniformType type, const void* value);
+        void drawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color);
+
+        MeshQueue& getMeshes() { return mMeshes; }
+        SpriteQueue& getSprites() { return mSprites; }
+        const CameraConstants& getCamera() const { return mCamera; }
+
+    private:
+        enum class Op : uint8_t {
+            BindShader,
+            UnbindShader,
+            SetUniform,
+            DrawCube,
+        };
+
+        struct Entry {
+            Op op;
+            UniformType uniformType = UniformType::Float;
+            uint32_t data = 0; // SetUniform, offset of the value in mData followed by the name
+            uint32_t nameLength = 0;
+            Shader* shader = nullptr;
+
+            math::Vec3 position;
+            math::Vec3 size;
+            math::Quat rotation;
+            math::Color color = {0, 0, 0, 0};
+        };
+
+        Vector<Entry> mEntries;
+        Vector<uint8_t> mData;
+        MeshQueue mMeshes;
+        SpriteQueue mSprites;
+        CameraConstants mCamera;
+        CommandList* mPrevious = nullptr;
+    };
+}
+
+#endif // SCORPION_COMMAND_LIST_H
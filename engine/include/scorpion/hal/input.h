@@ -6,6 +6,7 @@
 #include "scorpion/core/api.h"
 
 #include "scorpion/util/math.h"
+#include "scorpion/util/std_types.h"
 
 namespace scorpion::input {
     enum class MouseButton {
@@ -18,12 +19,114 @@ namespace scorpion::input {
         Back = 6,
     };
 
+    constexpr uint32_t MouseButtonCount = 7;
+    constexpr uint32_t KeyCount = 512; // raylib key codes
+
+    enum class EventType : uint8_t {
+        MouseButtonDown = 0,
+        MouseButtonUp,
+        MouseMove,
+        MouseWheel,
+        KeyDown,
+        KeyUp,
+    };
+
+    struct Event {
+        EventType type = EventType::MouseMove;
+        uint32_t code = 0; // MouseButton or key code for button and key events
+        double time = 0.0; // GetTime of the poll that saw it
+        math::Vec2 position; // of the mouse, when it happened
+        math::Vec2 delta; // how far the mouse moved or the wheel turned
+    };
+
+    // Everything a tick consumed, tick by tick, and what was held down when it started. The same bytes are the file format.
+    // Replaying starts from that state and feeds the exact same events to the same ticks, so a fixed step simulation plays out exactly
+    // like it did when it was recorded
+    class SCORPION_API Recording {
+    public:
+        struct StartState {
+            uint32_t buttons = 0; // bit per MouseButton
+            uint64_t keys[KeyCount / 64] = {}; // bit per key code
+            math::Vec2 position; // of the mouse
+        };
+
+        uint32_t getTickCount() const { return static_cast<uint32_t>(mTickEnds.size()); }
+        size_t getEventCount() const { return mEvents.size(); }
+
+        bool isEmpty() const { return mTickEnds.empty(); }
+        void clear();
+
+        const StartState& getStartState() const { return mStart; }
+        void setStartState(const StartState& state) { mStart = state; }
+
+        // Event times in here are seconds since the recording started
+        void addTick(const Event* events, size_t count);
+        const Event* getTick(uint32_t tick, size_t& count) const;
+
+        // False and untouched if the data doesn't look like a recording
+        bool assign(const uint8_t* data, size_t size);
+        void serialize(Vector<uint8_t>& data) const;
+
+        bool save(const char* path) const;
+        bool load(const char* path);
+
+    private:
+        StartState mStart;
+        Vector<Event> mEvents;
+        Vector<uint32_t> mTickEnds; // per tick, one past its last event
+    };
+
+    // Seconds on a steady clock, what event times are measured in
+    SCORPION_API double GetTime();
+
+    // Samples the window and queues an event for everything that changed since the last poll. The engine polls once at the start of
+    // every tick and around GetPollRate times a second while it waits, so events get times close to when they happened and nothing short
+    // lived falls between two ticks. Only on the main thread, that's the only place the window gets its events
+    SCORPION_API void Poll();
+
+    // Backends whose end of frame pumps the window themselves call this right after, before the next pump overwrites what it saw
+    SCORPION_API void SampleWindow();
+
+    // How often the engine polls while it's waiting for the next tick or frame, 0 only polls once per tick. 1000 by default
+    SCORPION_API int GetPollRate();
+    SCORPION_API void SetPollRate(int hz);
+
+    // Queues an event as if a poll had seen it, for input that doesn't come from the window. Safe from any thread
+    SCORPION_API void PushEvent(const Event& event);
+
+    // Moves everything queued so far over to the tick that's starting and updates the state below with it. Called by the engine right
+    // before every update, call it yourself when driving scenes without it
+    SCORPION_API void BeginTick();
+
+    // Everything that happened since the last tick, oldest first. Stays the same for the whole tick
+    SCORPION_API const Vector<Event>& GetEvents();
+
+    // Events that didn't fit because nothing consumed the queue for too long
+    SCORPION_API uint64_t GetDroppedEvents();
+
+    // Clears the recording and takes the current state as its start. It has to stay alive until StopRecording
+    SCORPION_API void StartRecording(Recording* recording);
+    SCORPION_API void StopRecording();
+    SCORPION_API bool IsRecording();
+
+    // Puts the state back to the recording's start, then every tick gets the events of the next recorded tick instead of the window's until
+    // the recording runs out or StopReplay. Same here, the recording has to stay alive
+    SCORPION_API void StartReplay(const Recording* recording);
+    SCORPION_API void StopReplay();
+    SCORPION_API bool IsReplaying();
+
+    // State as of the start of the current tick. Pressed and released cover everything since the last tick,
+    // so a click that starts and ends between two ticks still counts as pressed and released
     SCORPION_API bool IsMouseButtonPressed(MouseButton button);
     SCORPION_API bool IsMouseButtonDown(MouseButton button);
     SCORPION_API bool IsMouseButtonReleased(MouseButton button);
     SCORPION_API math::Vec2 GetMousePosition();
     SCORPION_API math::Vec2 GetMousePositionDelta();
     SCORPION_API float GetMouseWheel();
+
+    SCORPION_API bool IsKeyPressed(int key);
+    SCORPION_API bool IsKeyDown(int key);
+    SCORPION_API bool IsKeyReleased(int key);
 }
 
-#endif //SCORPION_INPUT_H
\ No newline at end of file
+#endif //SCORPION_INPUT_H
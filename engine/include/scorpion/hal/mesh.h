@@ -0,0 +1,124 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_MESH_H
+#define SCORPION_MESH_H 1
+
+#include "scorpion/hal/renderer.h"
+
+#include "scorpion/util/bounds.h"
+
+namespace scorpion::render {
+    // Geometry that lives on the GPU. Static meshes are uploaded once and never touched again,
+    // dynamic ones keep a CPU copy and only re-upload the range that changed since the last draw
+    class SCORPION_API Mesh {
+    public:
+        enum class Usage {
+            Static,
+            Dynamic,
+        };
+
+        Mesh(const Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount, Usage usage);
+        ~Mesh();
+
+        Mesh(const Mesh&) = delete;
+        Mesh& operator=(const Mesh&) = delete;
+
+        Usage getUsage() const;
+        uint32_t getVertexCount() const;
+        uint32_t getIndexCount() const;
+
+        // Local space box around every vertex. Edits to dynamic meshes only ever grow it
+        const AABB& getBounds() const;
+
+        // Dynamic meshes only, static ones return nullptr and ignore the setters
+        const Vertex* getVertices() const;
+        const uint16_t* getIndices() const;
+
+        void setVertices(uint32_t first, const Vertex* vertices, uint32_t count);
+        void setIndices(uint32_t first, const uint16_t* indices, uint32_t count);
+
+        // Sends the dirty ranges to the backend. Drawing does this already
+        void upload();
+
+        void* getHandle() const;
+
+    private:
+        struct Range {
+            uint32_t begin = UINT32_MAX;
+            uint32_t end = 0;
+
+            void add(uint32_t first, uint32_t count);
+            bool empty() const { return begin >= end; }
+        };
+
+        void* mHandle;
+        Usage mUsage;
+
+        uint32_t mVertexCount;
+        uint32_t mIndexCount;
+
+        AABB mBounds;
+
+        Vector<Vertex> mVertices;
+        Vector<uint16_t> mIndices;
+
+        Range mDirtyVertices;
+        Range mDirtyIndices;
+    };
+
+    // Instances grouped by mesh and shader, every group turns into one instanced draw. Both pointers have to stay alive until the flush
+    class SCORPION_API MeshQueue {
+    public:
+        void add(Mesh* mesh, Shader* shader, const math::Matrix4& transform, math::Color color);
+        void add(Mesh* mesh, Shader* shader, const MeshInstance* instances, uint32_t count);
+
+        // Moves everything queued here into other, keeping the groups
+        void appendTo(MeshQueue& other);
+
+        void flush();
+        void clear();
+
+        bool empty() const { return mBatchCount == 0; }
+
+    private:
+        struct Batch {
+            Mesh* mesh;
+            Shader* shader;
+            Vector<MeshInstance> instances;
+        };
+
+        // batches stay around between frames so the instance vectors keep their capacity
+        Vector<Batch> mBatches;
+        size_t mBatchCount = 0;
+        size_t mLastBatch = 0;
+
+        Batch& find(Mesh* mesh, Shader* shader);
+    };
+
+    // Has to happen on the render thread like everything else that touches the backend
+    SCORPION_API SharedPtr<Mesh> CreateMesh(const Vector<Vertex>& vertices, const Vector<uint16_t>& indices, Mesh::Usage usage = Mesh::Usage::Static);
+
+    // Unit cube around the origin with per face normals. Made by InitWindow and InitHeadless and kept until CloseWindow, so any thread
+    // can grab it without creating or destroying GPU resources. nullptr outside of that
+    SCORPION_API SharedPtr<Mesh> GetCubeMesh();
+
+    // Draws every instance in one call with its instance color and a bit of directional shading. Shared like the cube mesh
+    SCORPION_API SharedPtr<Shader> GetInstancedShader();
+
+    // InitWindow and InitHeadless call this on the render thread, CloseWindow the release
+    SCORPION_API void CreateSharedMeshes();
+    SCORPION_API void ReleaseSharedMeshes();
+
+    // Queues one instance. Instances are grouped by mesh and shader and drawn when the 3D pass ends, FlushMeshes does it early.
+    // Both pointers have to stay alive until then. Threads recording a command list queue into the list instead
+    SCORPION_API void DrawMesh(Mesh* mesh, Shader* shader, const math::Matrix4& transform, math::Color color);
+
+    // Same thing for a whole array of instances, copied into the queue
+    SCORPION_API void DrawMeshInstances(Mesh* mesh, Shader* shader, const MeshInstance* instances, uint32_t count);
+    SCORPION_API void FlushMeshes();
+
+    // Moves everything in queue over to what DrawMesh queues into
+    SCORPION_API void QueueMeshes(MeshQueue& queue);
+}
+
+#endif // SCORPION_MESH_H
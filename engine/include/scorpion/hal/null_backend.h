@@ -0,0 +1,159 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_NULL_BACKEND_H
+#define SCORPION_NULL_BACKEND_H 1
+
+#include "scorpion/hal/render_backend.h"
+
+namespace scorpion::render {
+    // Accepts everything and draws nothing. Meant for servers, CI and benchmarks where there's no GPU or display
+    class SCORPION_API NullBackend : public Backend {
+    public:
+        struct Counters {
+            uint64_t frames = 0;
+            uint64_t clears = 0;
+            uint64_t passes3D = 0;
+            uint64_t drawCalls = 0;
+            uint64_t triangles = 0;
+            uint64_t shadersCompiled = 0;
+            uint64_t shaderBinariesLoaded = 0;
+            uint64_t shaderBinds = 0;
+            uint64_t uniformUploads = 0;
+            uint64_t meshesCreated = 0;
+            uint64_t meshBytesUploaded = 0;
+            uint64_t instances = 0;
+            uint64_t views = 0;
+            uint64_t renderTargetsCreated = 0;
+            uint64_t texturesCreated = 0;
+            uint64_t textureBytesUploaded = 0;
+            uint64_t sprites = 0;
+        };
+
+        NullBackend(int width = 1280, int height = 720);
+
+        const char* getName() const override;
+        bool isHeadless() const override;
+
+        void initWindow(int width, int height, const char* title) override;
+        void closeWindow() override;
+        bool windowShouldClose() override;
+
+        int getWindowWidth() override;
+        int getWindowHeight() override;
+
+        bool isCursorVisible() override;
+        void setCursorVisible(bool visible) override;
+
+        void* compileShader(const char* vShaderCode, const char* fShaderCode) override;
+        void destroyShader(void* shader) override;
+        void bindShader(void* shader) override;
+        void unbindShader() override;
+
+        int getUniformLocation(void* shader, const char* name) override;
+        int getAttribLocation(void* shader, const char* name) override;
+        void setUniform(void* shader, int location, UniformType type, const void* value) override;
+
+        bool getShaderBinary(void* shader, Vector<uint8_t>& binary, uint32_t& format) override;
+        void* loadShaderBinary(const uint8_t* binary, size_t size, uint32_t format) override;
+
+        void* createMesh(const Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount, bool dynamic) override;
+        void updateMeshVertices(void* mesh, uint32_t first, const Vertex* vertices, uint32_t count) override;
+        void updateMeshIndices(void* mesh, uint32_t first, const uint16_t* indices, uint32_t count) override;
+        void destroyMesh(void* mesh) override;
+        void drawMesh(void* mesh, const MeshInstance* instances, uint32_t count) override;
+
+        void* createRenderTarget(int width, int height) override;
+        void destroyRenderTarget(void* target) override;
+        void beginView(void* target, int x, int y, int width, int height) override;
+        void endView() override;
+
+        void* createTexture(int width, int height, const uint8_t* pixels) override;
+        void updateTexture(void* texture, int x, int y, int width, int height, const uint8_t* pixels) override;
+        void destroyTexture(void* texture) override;
+        void drawSprites(void* texture, BlendMode blend, const SpriteVertex* vertices, uint32_t count) override;
+
+        void beginDrawing() override;
+        void endDrawing() override;
+        void clear() override;
+
+        void begin3D(const math::Matrix4& view, const math::Matrix4& projection) override;
+        void end3D() override;
+
+        void drawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color) override;
+
+        void setWindowSize(int width, int height);
+
+        // windowShouldClose returns true from now on
+        void requestClose();
+
+        const Counters& getCounters() const;
+        void resetCounters();
+
+        void setRecording(bool recording);
+        bool isRecording() const;
+
+        const CommandBuffer& getCommands() const;
+        void clearCommands();
+
+    private:
+        struct ShaderEntry {
+            String vertexSource;
+            String fragmentSource;
+            Vector<String> uniforms;
+            Vector<String> attribs;
+            Vector<uint32_t> uniformStrings; // per uniform, its string index in mCommands or UINT32_MAX
+            bool alive = true;
+            bool recorded = false; // whether mCommands has a CompileShader for it yet
+        };
+
+        struct MeshEntry {
+            Vector<Vertex> vertices;
+            Vector<uint16_t> indices;
+            bool dynamic = false;
+            bool alive = true;
+            bool recorded = false;
+        };
+
+        struct RenderTargetEntry {
+            int width = 0;
+            int height = 0;
+            bool alive = true;
+            bool recorded = false;
+        };
+
+        struct TextureEntry {
+            int width = 0;
+            int height = 0;
+            Vector<uint8_t> pixels; // empty until something is uploaded
+            bool alive = true;
+            bool recorded = false;
+        };
+
+        int mWidth;
+        int mHeight;
+        bool mCursorVisible = true;
+        bool mCloseRequested = false;
+
+        Vector<ShaderEntry> mShaders; // handle is index + 1
+        Vector<MeshEntry> mMeshes; // same here
+        Vector<RenderTargetEntry> mRenderTargets; // and here
+        Vector<TextureEntry> mTextures;
+
+        Counters mCounters;
+
+        bool mRecording = false;
+        CommandBuffer mCommands;
+
+        ShaderEntry* getShader(void* shader, uint32_t* id);
+        void recordShader(uint32_t id);
+        MeshEntry* getMesh(void* mesh, uint32_t* id);
+        void recordMesh(uint32_t id);
+        RenderTargetEntry* getRenderTarget(void* target, uint32_t* id);
+        void recordRenderTarget(uint32_t id);
+        TextureEntry* getTexture(void* texture, uint32_t* id);
+        void recordTexture(uint32_t id);
+        Command* record(CommandType type);
+    };
+}
+
+#endif // SCORPION_NULL_BACKEND_H
@@ -0,0 +1,89 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_RENDER_BACKEND_H
+#define SCORPION_RENDER_BACKEND_H 1
+
+#include "scorpion/hal/render_commands.h"
+
+namespace scorpion::render {
+    // Everything the renderer needs from the platform. Shader handles are opaque and only mean something to the backend that made them
+    class SCORPION_API Backend {
+    public:
+        virtual ~Backend() = default;
+
+        virtual const char* getName() const = 0;
+        virtual bool isHeadless() const = 0;
+
+        virtual void initWindow(int width, int height, const char* title) = 0;
+        virtual void closeWindow() = 0;
+        virtual bool windowShouldClose() = 0;
+
+        virtual int getWindowWidth() = 0;
+        virtual int getWindowHeight() = 0;
+
+        virtual bool isCursorVisible() = 0;
+        virtual void setCursorVisible(bool visible) = 0;
+
+        // Returns nullptr if the program failed to compile
+        virtual void* compileShader(const char* vShaderCode, const char* fShaderCode) = 0;
+        virtual void destroyShader(void* shader) = 0;
+        virtual void bindShader(void* shader) = 0;
+        virtual void unbindShader() = 0;
+
+        virtual int getUniformLocation(void* shader, const char* name) = 0;
+        virtual int getAttribLocation(void* shader, const char* name) = 0;
+        virtual void setUniform(void* shader, int location, UniformType type, const void* value) = 0;
+
+        // Program binaries for the on-disk shader cache, backends that can't do them just keep these defaults.
+        // The driver string goes into the cache key since binaries are only valid for the exact driver that made them
+        virtual const char* getDriverString() { return getName(); }
+        virtual bool getShaderBinary(void* shader, Vector<uint8_t>& binary, uint32_t& format) { return false; }
+        virtual void* loadShaderBinary(const uint8_t* binary, size_t size, uint32_t format) { return nullptr; }
+
+        // Indices are 16 bit like raylib's meshes, bigger meshes have to be split. Without indices the vertices are drawn as a triangle list
+        virtual void* createMesh(const Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount, bool dynamic) = 0;
+        virtual void updateMeshVertices(void* mesh, uint32_t first, const Vertex* vertices, uint32_t count) = 0;
+        virtual void updateMeshIndices(void* mesh, uint32_t first, const uint16_t* indices, uint32_t count) = 0;
+        virtual void destroyMesh(void* mesh) = 0;
+
+        // One draw of count instances with the bound shader, or the default one if none is bound
+        virtual void drawMesh(void* mesh, const MeshInstance* instances, uint32_t count) = 0;
+
+        // Offscreen color and depth buffers to render a view into. nullptr if the backend can't do them
+        virtual void* createRenderTarget(int width, int height) = 0;
+        virtual void destroyRenderTarget(void* target) = 0;
+
+        // Everything until endView goes into target, nullptr being the window, and only inside the viewport. Clears included.
+        // The viewport is in pixels with the origin in the top left corner
+        virtual void beginView(void* target, int x, int y, int width, int height) = 0;
+        virtual void endView() = 0;
+
+        // RGBA8, rows tightly packed top to bottom. pixels can be nullptr, the contents are undefined until updated then
+        virtual void* createTexture(int width, int height, const uint8_t* pixels) = 0;
+        virtual void updateTexture(void* texture, int x, int y, int width, int height, const uint8_t* pixels) = 0;
+        virtual void destroyTexture(void* texture) = 0;
+
+        // count quads in one draw, no depth test, on top of whatever the view has so far. texture nullptr draws the vertex colors alone
+        virtual void drawSprites(void* texture, BlendMode blend, const SpriteVertex* vertices, uint32_t count) = 0;
+
+        virtual void beginDrawing() = 0;
+        virtual void endDrawing() = 0;
+        virtual void clear() = 0;
+
+        // The camera builds both matrices, backends only load them
+        virtual void begin3D(const math::Matrix4& view, const math::Matrix4& projection) = 0;
+        virtual void end3D() = 0;
+
+        virtual void drawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color) = 0;
+    };
+
+    SCORPION_API Backend* GetRaylibBackend();
+
+    // Raylib unless something else was set
+    SCORPION_API Backend* GetBackend();
+
+    // Has to happen before InitWindow/InitHeadless. The backend isn't owned and must outlive the window
+    SCORPION_API void SetBackend(Backend* backend);
+}
+
+#endif // SCORPION_RENDER_BACKEND_H
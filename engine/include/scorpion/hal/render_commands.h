@@ -0,0 +1,145 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_RENDER_COMMANDS_H
+#define SCORPION_RENDER_COMMANDS_H 1
+
+#include "scorpion/core/api.h"
+
+#include "scorpion/util/math.h"
+#include "scorpion/util/std_types.h"
+
+namespace scorpion::render {
+    class Backend;
+
+    enum class UniformType : uint8_t {
+        Float,
+        Int,
+        UInt,
+        Vec2,
+        Vec3,
+        Vec4,
+        Vec2I,
+        Vec3I,
+        Vec4I,
+        Matrix4,
+    };
+
+    SCORPION_API size_t GetUniformSize(UniformType type);
+
+    // Interleaved, every backend keeps its vertex buffers in this layout
+    struct Vertex {
+        math::Vec3 position;
+        math::Vec2 texCoord;
+        math::Vec3 normal;
+        math::Color color;
+    };
+
+    struct MeshInstance {
+        math::Matrix4 transform;
+        math::Color color;
+    };
+
+    // Sprites go to the backend as quads of four of these, clockwise from the top left corner, in pixels of the current view
+    struct SpriteVertex {
+        math::Vec2 position;
+        math::Vec2 texCoord;
+        math::Color color;
+    };
+
+    enum class BlendMode : uint8_t {
+        Alpha,
+        Additive,
+        Multiply,
+        Premultiplied, // colors already multiplied by their alpha
+    };
+
+    enum class CommandType : uint8_t {
+        BeginDrawing,
+        EndDrawing,
+        Clear,
+        Begin3D,
+        End3D,
+        DrawCube,
+        CompileShader,
+        DestroyShader,
+        BindShader,
+        UnbindShader,
+        SetUniform,
+        CreateMesh,
+        UpdateMeshVertices,
+        UpdateMeshIndices,
+        DestroyMesh,
+        DrawMesh,
+        CreateRenderTarget,
+        DestroyRenderTarget,
+        BeginView,
+        EndView,
+        CreateTexture,
+        UpdateTexture,
+        DestroyTexture,
+        DrawSprites,
+    };
+
+    // Flat on purpose, most fields are unused for most commands but it keeps recording a plain push_back
+    struct Command {
+        CommandType type;
+
+        uint32_t shader = 0; // id of the shader in the recording backend
+        uint32_t name = 0; // string index, vertex source for CompileShader and uniform name for SetUniform
+        uint32_t source = 0; // string index, fragment source for CompileShader
+
+        // DrawCube uses position/size/rotation/color, Begin3D keeps its view and projection matrices in the data blob
+        math::Vec3 position;
+        math::Vec3 size;
+        math::Quat rotation;
+        math::Color color = {0, 0, 0, 0};
+
+        UniformType uniformType = UniformType::Float;
+        alignas(4) uint8_t uniform[64] = {};
+
+        // Mesh commands. data and indexData are offsets into the data blob, count is vertices, indices or instances
+        uint32_t mesh = 0;
+        uint32_t data = 0;
+        uint32_t indexData = 0;
+        uint32_t first = 0;
+        uint32_t count = 0;
+        uint32_t indexCount = 0;
+        bool dynamic = false;
+
+        // Render target commands, UINT32_MAX is the window. rect is the viewport for BeginView and only the size for CreateRenderTarget
+        uint32_t renderTarget = UINT32_MAX;
+        int rect[4] = {};
+
+        // Texture commands, UINT32_MAX draws sprites untextured. rect is the size for CreateTexture and the region for UpdateTexture,
+        // count is quads for DrawSprites and the pixel bytes for CreateTexture, 0 when it was created empty
+        uint32_t texture = UINT32_MAX;
+        BlendMode blend = BlendMode::Alpha;
+    };
+
+    class SCORPION_API CommandBuffer {
+    public:
+        Command& push(CommandType type);
+        uint32_t addString(const char* string);
+
+        // Copies size bytes into the data blob and returns the offset. Offsets are aligned for any vertex/instance type
+        uint32_t addData(const void* data, size_t size);
+
+        const Vector<Command>& getCommands() const;
+        const String& getString(uint32_t index) const;
+        const uint8_t* getData(uint32_t offset) const;
+
+        size_t size() const;
+        bool empty() const;
+        void clear();
+
+        // Shaders, meshes, render targets and textures created by the stream are created again on the target and destroyed once the replay is done
+        void replay(Backend& target) const;
+
+    private:
+        Vector<Command> mCommands;
+        Vector<String> mStrings;
+        Vector<uint8_t> mData;
+    };
+}
+
+#endif // SCORPION_RENDER_COMMANDS_H
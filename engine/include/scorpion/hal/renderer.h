@@ -5,12 +5,28 @@
 
 #include "scorpion/core/api.h"
 
+#include "scorpion/hal/render_backend.h"
+
 #include "scorpion/util/math.h"
 #include "scorpion/util/std_types.h"
 
 // This whole module exists only to make the potential future transition away from raylib a bit easier on the soul
 namespace scorpion::render {
+    // What the current 3D pass was begun with. Every shader gets these as the view, projection, viewProjection and cameraPosition uniforms
+    // when it's bound, and only if they changed since that shader last got them, so it's one upload per camera per shader instead of per draw
+    struct CameraConstants {
+        math::Matrix4 view;
+        math::Matrix4 projection;
+        math::Matrix4 viewProjection;
+        math::Vec3 position;
+        uint32_t version = 0; // bumped whenever the matrices change
+    };
+
+    // Everything but the version, for recording command lists with a camera that isn't bound yet
+    SCORPION_API CameraConstants MakeCameraConstants(const math::Matrix4& view, const math::Matrix4& projection);
+
     class SCORPION_API Shader {
+    friend class CommandList;
     public:
         Shader(void* handle);
         ~Shader();
@@ -33,30 +49,75 @@ namespace scorpion::render {
         void setUniformMatrix4(const String& name, math::Matrix4 value);
 
     private:
+        void setUniform(const String& name, UniformType type, const void* value);
+        void setUniform(int location, UniformType type, const void* value);
+
+        void uploadCamera();
+
         void* mHandle;
-        void* mInternalState;
         HashMap<String, int> mUniformLocs; //NOTE: this is not fully backend-independent (some platforms use pointers and other shit, but we only have rlgl int for now)
         HashMap<String, int> mAttribLocs;
         bool mBegun = false;
+
+        int mCameraLocs[4] = { -2, -2, -2, -2 }; // -2 until looked up
+        uint32_t mCameraVersion = 0;
+    };
+
+    // Offscreen color and depth buffers a view can render into
+    class SCORPION_API RenderTarget {
+    public:
+        RenderTarget(void* handle, int width, int height);
+        ~RenderTarget();
+
+        RenderTarget(const RenderTarget&) = delete;
+        RenderTarget& operator=(const RenderTarget&) = delete;
+
+        int getWidth() const { return mWidth; }
+        int getHeight() const { return mHeight; }
+
+        void* getHandle() const { return mHandle; }
+
+    private:
+        void* mHandle;
+        int mWidth;
+        int mHeight;
     };
 
     SCORPION_API void InitWindow(int width, int height, const char* title);
+
+    // Switches to the null backend (unless a headless one was already set) so nothing needs a display or GPU
+    SCORPION_API void InitHeadless(int width = 1280, int height = 720);
+    SCORPION_API bool IsHeadless();
+
     SCORPION_API void CloseWindow();
+    SCORPION_API bool WindowShouldClose();
 
     SCORPION_API int GetWindowWidth();
     SCORPION_API int GetWindowHeight();
 
+    // Blocks until the program exists, see shader_cache.h for the async version. nullptr if it failed to compile
     SCORPION_API SharedPtr<Shader> CompileShader(const char* vShaderCode, const char* fShaderCode);
 
+    // nullptr if the backend can't render offscreen
+    SCORPION_API SharedPtr<RenderTarget> CreateRenderTarget(int width, int height);
+
     SCORPION_API bool IsCursorVisible();
     SCORPION_API void SetCursorVisible(bool visible);
 
     SCORPION_API void BeginDrawing();
     SCORPION_API void EndDrawing();
 
-    SCORPION_API void Begin3D(math::Vec3 position, math::Vec3 target, math::Vec3 up, float fovY, int projection);
+    // Draws into target, or the window if it's nullptr, restricted to the viewport. Pixels with the origin in the top left
+    SCORPION_API void BeginView(RenderTarget* target, int x, int y, int width, int height);
+    SCORPION_API void EndView();
+
+    // Usually straight from a camera's cached matrices
+    SCORPION_API void Begin3D(const math::Matrix4& view, const math::Matrix4& projection);
     SCORPION_API void End3D();
 
+    // The recording command list's camera on threads that are recording one
+    SCORPION_API const CameraConstants& GetCameraConstants();
+
     SCORPION_API void ClearWindow();
 
     SCORPION_API void DrawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color);
@@ -0,0 +1,72 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_SHADER_CACHE_H
+#define SCORPION_SHADER_CACHE_H 1
+
+#include "scorpion/hal/renderer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+namespace scorpion::render {
+    // 64 bit FNV-1a over both sources, this is the key for both the in-memory and the on-disk cache. In-memory hits compare the sources too
+    SCORPION_API uint64_t HashShaderSource(const char* vShaderCode, const char* fShaderCode);
+
+    class SCORPION_API ShaderRequest {
+    public:
+        enum class State {
+            Pending,
+            Ready,
+            Failed,
+        };
+
+        ShaderRequest(uint64_t hash, const char* vShaderCode, const char* fShaderCode);
+
+        uint64_t getHash() const;
+        State getState() const;
+        bool isDone() const;
+
+        // nullptr until the request is Ready
+        SharedPtr<Shader> get() const;
+
+        // On the render thread this compiles right away, anywhere else it blocks until the render thread got to it. A render thread that's
+        // waiting on jobs keeps compiling, so this is fine from inside a ParallelFor too
+        SharedPtr<Shader> wait();
+
+    private:
+        friend class ShaderCache;
+
+        uint64_t mHash;
+        String mVertexSource;
+        String mFragmentSource;
+
+        Vector<uint8_t> mBinary; // filled in by the io thread on a disk cache hit
+        uint32_t mBinaryFormat = 0;
+
+        std::atomic<State> mState = State::Pending;
+        SharedPtr<Shader> mShader;
+
+        mutable std::mutex mMutex;
+        std::condition_variable mCondition;
+
+        void finish(SharedPtr<Shader> shader);
+    };
+
+    // Queues a compile and returns straight away, requests for the same source share one request.
+    // GL programs can only be made on the render thread, so the actual work happens in PumpShaderCompiles
+    SCORPION_API SharedPtr<ShaderRequest> CompileShaderAsync(const char* vShaderCode, const char* fShaderCode);
+
+    // Finishes queued compiles until budgetSeconds is used up, always at least one. The engine calls this every rendered frame
+    SCORPION_API void PumpShaderCompiles(double budgetSeconds);
+
+    SCORPION_API size_t GetPendingShaderCompiles();
+
+    // InitWindow and InitHeadless call this. If it never happens the first thread to pump or wait becomes the render thread
+    SCORPION_API void SetRenderThread();
+
+    // Program binaries get stored here keyed by source hash and driver, so warm starts skip compiling. Empty turns it off (default)
+    SCORPION_API void SetShaderCacheDirectory(const char* path);
+}
+
+#endif // SCORPION_SHADER_CACHE_H
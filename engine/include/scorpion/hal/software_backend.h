@@ -0,0 +1,167 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_SOFTWARE_BACKEND_H
+#define SCORPION_SOFTWARE_BACKEND_H 1
+
+#include "scorpion/hal/render_backend.h"
+
+namespace scorpion::render {
+    // Tile based CPU rasterizer drawing into an RGBA8 framebuffer, for golden image tests and thumbnails on machines without a GPU.
+    // Cubes are flat shaded with a single directional light, shaders are accepted but never run. Sprites sample their texture nearest
+    // neighbour and take the color of their first vertex.
+    // Output only depends on the draw calls, not on the thread count
+    class SCORPION_API SoftwareBackend : public Backend {
+    public:
+        static constexpr int TileSize = 64;
+
+        SoftwareBackend(int width = 1280, int height = 720);
+
+        const char* getName() const override;
+        bool isHeadless() const override;
+
+        void initWindow(int width, int height, const char* title) override;
+        void closeWindow() override;
+        bool windowShouldClose() override;
+
+        int getWindowWidth() override;
+        int getWindowHeight() override;
+
+        bool isCursorVisible() override;
+        void setCursorVisible(bool visible) override;
+
+        void* compileShader(const char* vShaderCode, const char* fShaderCode) override;
+        void destroyShader(void* shader) override;
+        void bindShader(void* shader) override;
+        void unbindShader() override;
+
+        int getUniformLocation(void* shader, const char* name) override;
+        int getAttribLocation(void* shader, const char* name) override;
+        void setUniform(void* shader, int location, UniformType type, const void* value) override;
+
+        void* createMesh(const Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount, bool dynamic) override;
+        void updateMeshVertices(void* mesh, uint32_t first, const Vertex* vertices, uint32_t count) override;
+        void updateMeshIndices(void* mesh, uint32_t first, const uint16_t* indices, uint32_t count) override;
+        void destroyMesh(void* mesh) override;
+        void drawMesh(void* mesh, const MeshInstance* instances, uint32_t count) override;
+
+        void* createRenderTarget(int width, int height) override;
+        void destroyRenderTarget(void* target) override;
+        void beginView(void* target, int x, int y, int width, int height) override;
+        void endView() override;
+
+        void* createTexture(int width, int height, const uint8_t* pixels) override;
+        void updateTexture(void* texture, int x, int y, int width, int height, const uint8_t* pixels) override;
+        void destroyTexture(void* texture) override;
+        void drawSprites(void* texture, BlendMode blend, const SpriteVertex* vertices, uint32_t count) override;
+
+        void beginDrawing() override;
+        void endDrawing() override;
+        void clear() override;
+
+        void begin3D(const math::Matrix4& view, const math::Matrix4& projection) override;
+        void end3D() override;
+
+        void drawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color) override;
+
+        void resize(int width, int height);
+
+        void setClearColor(math::Color color);
+
+        // direction the light travels in, ambient is the minimum brightness of faces pointing away from it
+        void setLight(math::Vec3 direction, float ambient);
+
+        // Rasterizes everything submitted so far. EndDrawing does this already
+        void flush();
+
+        // Row major, getPitch() pixels per row, each pixel is r, g, b, a bytes in memory order. Render targets the same way, their pitch
+        // is their width rounded up to 4
+        const uint32_t* getPixels() const;
+        const uint32_t* getPixels(void* target) const;
+        int getPitch() const;
+
+        // Binary PPM, alpha is dropped
+        bool savePPM(const char* path) const;
+
+    private:
+        struct Mesh {
+            Vector<Vertex> vertices;
+            Vector<uint16_t> indices;
+        };
+
+        // while a target is bound its buffers and size are swapped with the window's
+        struct RenderTarget {
+            int width;
+            int height;
+            int pitch;
+            Vector<uint32_t> color;
+            Vector<float> depth;
+        };
+
+        struct Texture {
+            int width;
+            int height;
+            Vector<uint32_t> pixels;
+        };
+
+        struct Rect {
+            int x0, y0, x1, y1; // x1 and y1 exclusive
+        };
+
+        struct Triangle {
+            float edgeA[3];
+            float edgeB[3];
+            float edgeC[3];
+            bool inclusive[3];
+
+            float z0;
+            float dzdx;
+            float dzdy;
+
+            int minX;
+            int minY;
+            int maxX;
+            int maxY;
+
+            uint32_t color;
+        };
+
+        int mWidth;
+        int mHeight;
+        int mPitch;
+        int mTilesX;
+        int mTilesY;
+
+        Vector<uint32_t> mColorBuffer;
+        Vector<float> mDepthBuffer;
+
+        uint32_t mClearColor;
+        bool mClearPending = false;
+        Rect mClearRect;
+
+        RenderTarget* mViewTarget = nullptr;
+        Rect mViewport;
+
+        math::Vec3 mLightDirection;
+        float mAmbient;
+
+        math::Matrix4 mViewProjection;
+
+        Vector<math::Vec4> mClipVertices; // scratch for drawMesh
+        Vector<math::Vec3> mWorldVertices;
+
+        Vector<Triangle> mTriangles;
+        Vector<Vector<uint32_t>> mBins;
+
+        void swapTarget(RenderTarget* target);
+
+        uint32_t shade(math::Vec3 normal, math::Color color) const;
+        void submitTriangle(const math::Vec4& v0, const math::Vec4& v1, const math::Vec4& v2, uint32_t color);
+        void setupTriangle(const math::Vec4& v0, const math::Vec4& v1, const math::Vec4& v2, uint32_t color);
+        void rasterizeTile(int tileIndex);
+
+        // straight into the color buffer, sprites don't go through the tiles
+        void rasterizeSprite(const SpriteVertex& v0, const SpriteVertex& v1, const SpriteVertex& v2, const Texture* texture, BlendMode blend, uint32_t color);
+    };
+}
+
+#endif // SCORPION_SOFTWARE_BACKEND_H
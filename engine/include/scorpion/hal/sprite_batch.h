@@ -0,0 +1,61 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_SPRITE_BATCH_H
+#define SCORPION_SPRITE_BATCH_H 1
+
+#include "scorpion/hal/texture.h"
+
+namespace scorpion::render {
+    // Screen space quads, sorted by order, then blend mode and texture, and drawn with one call per run of the same texture and blend mode.
+    // Sprites with the same order can be reordered among each other to batch better, use order for anything that has to be on top.
+    // Textures have to stay alive until the flush
+    class SCORPION_API SpriteQueue {
+    public:
+        // position is where origin ends up, origin is relative to the top left of the sprite and the sprite rotates around it.
+        // rotation is in radians, clockwise on screen. Everything is in pixels of the current view
+        void add(const TextureRegion& region, math::Vec2 position, math::Vec2 size, math::Color tint, float rotation, math::Vec2 origin, int order, BlendMode blend);
+
+        // Moves everything queued here into other, after what other already has
+        void appendTo(SpriteQueue& other);
+
+        void flush();
+        void clear();
+
+        bool empty() const { return mSprites.empty(); }
+        size_t size() const { return mSprites.size(); }
+
+    private:
+        struct Sprite {
+            uint64_t key; // order, blend and texture id from the top bits down
+            uint32_t index; // in mTextures, and over 4 in mVertices
+        };
+
+        // in the order they were added
+        Vector<Sprite> mSprites;
+        Vector<Texture*> mTextures;
+        Vector<SpriteVertex> mVertices; // 4 per sprite
+
+        // scratch for flush
+        Vector<Sprite> mSortedSprites;
+        Vector<SpriteVertex> mSortedVertices;
+
+        static uint64_t makeKey(int order, BlendMode blend, const Texture* texture);
+    };
+
+    // Queues one sprite, drawn when the layer or view ends or on FlushSprites. See SpriteQueue::add for the parameters.
+    // A thread recording a command list queues into its own list. Without one there's a single queue shared by everything, unlocked, so
+    // only the render thread may call this outside of recording. Views recorded in parallel each draw through their own list
+    SCORPION_API void DrawSprite(const TextureRegion& region, math::Vec2 position, math::Vec2 size, math::Color tint = math::Color::white,
+                                 float rotation = 0.0f, math::Vec2 origin = math::Vec2::zero, int order = 0, BlendMode blend = BlendMode::Alpha);
+
+    // Solid rectangle, top left at position
+    SCORPION_API void DrawRect(math::Vec2 position, math::Vec2 size, math::Color color, int order = 0, BlendMode blend = BlendMode::Alpha);
+
+    // Render thread only, same goes for QueueSprites
+    SCORPION_API void FlushSprites();
+
+    // Moves everything in queue over to the shared queue DrawSprite uses outside of recording
+    SCORPION_API void QueueSprites(SpriteQueue& queue);
+}
+
+#endif // SCORPION_SPRITE_BATCH_H
@@ -0,0 +1,74 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_TEXTURE_H
+#define SCORPION_TEXTURE_H 1
+
+#include "scorpion/hal/renderer.h"
+
+namespace scorpion::render {
+    // RGBA8 image that lives on the GPU. Like meshes, static textures are uploaded once and dynamic ones keep a CPU copy and only
+    // re-upload the rectangle that changed since the last draw
+    class SCORPION_API Texture {
+    public:
+        enum class Usage {
+            Static,
+            Dynamic,
+        };
+
+        // pixels may be nullptr, the texture starts out white then
+        Texture(const uint8_t* pixels, int width, int height, Usage usage);
+        ~Texture();
+
+        Texture(const Texture&) = delete;
+        Texture& operator=(const Texture&) = delete;
+
+        Usage getUsage() const;
+        int getWidth() const;
+        int getHeight() const;
+
+        // Dynamic textures only, static ones return nullptr and ignore the setter
+        const uint8_t* getPixels() const;
+        void setPixels(int x, int y, int width, int height, const uint8_t* pixels);
+
+        // Sends the dirty rectangle to the backend. Drawing does this already
+        void upload();
+
+        void* getHandle() const;
+
+        // Never reused, unlike handles. Sprite batching sorts by it
+        uint32_t getId() const;
+
+    private:
+        void* mHandle;
+        Usage mUsage;
+        uint32_t mId;
+
+        int mWidth;
+        int mHeight;
+
+        Vector<uint8_t> mPixels;
+
+        // empty while x0 >= x1
+        int mDirtyX0 = INT32_MAX;
+        int mDirtyY0 = INT32_MAX;
+        int mDirtyX1 = 0;
+        int mDirtyY1 = 0;
+    };
+
+    // Part of a texture, usually handed out by a TextureAtlas. width and height are in texels
+    struct TextureRegion {
+        Texture* texture = nullptr; // nullptr draws a solid quad
+        math::Vec2 uvMin = math::Vec2(0.0f, 0.0f);
+        math::Vec2 uvMax = math::Vec2(1.0f, 1.0f);
+        int width = 0;
+        int height = 0;
+    };
+
+    // Has to happen on the render thread like everything else that touches the backend
+    SCORPION_API SharedPtr<Texture> CreateTexture(int width, int height, const uint8_t* pixels = nullptr, Texture::Usage usage = Texture::Usage::Static);
+
+    // The whole texture
+    SCORPION_API TextureRegion GetRegion(Texture* texture);
+}
+
+#endif // SCORPION_TEXTURE_H
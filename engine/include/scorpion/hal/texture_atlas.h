@@ -0,0 +1,58 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_TEXTURE_ATLAS_H
+#define SCORPION_TEXTURE_ATLAS_H 1
+
+#include "scorpion/hal/texture.h"
+
+namespace scorpion::render {
+    // Packs lots of small images into a few big dynamic textures, so sprites from different images still batch into one draw. Pages are
+    // filled with a skyline packer and a new one is started when an image doesn't fit anywhere. Every image gets a border of its own edge
+    // pixels, so filtering never bleeds in a neighbour. Render thread only, images are never removed one at a time
+    class SCORPION_API TextureAtlas {
+    public:
+        explicit TextureAtlas(int pageSize = 2048, int padding = 1);
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        // Copies the RGBA8 pixels in. The region has no texture if the image is bigger than a page
+        TextureRegion add(int width, int height, const uint8_t* pixels);
+
+        // A single white texel. Solid quads drawn with it batch with everything else on its page
+        TextureRegion getWhite();
+
+        size_t getPageCount() const { return mPages.size(); }
+        Texture* getPage(size_t index) const { return mPages[index].texture.get(); }
+        int getPageSize() const { return mPageSize; }
+
+        // Drops every page, regions handed out so far point to freed textures after this
+        void clear();
+
+    private:
+        // top edge of the packed area, one segment per run of equal height
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        struct Page {
+            SharedPtr<Texture> texture;
+            Vector<Segment> skyline;
+        };
+
+        int mPageSize;
+        int mPadding;
+
+        Vector<Page> mPages;
+        Vector<uint8_t> mScratch; // padded copy of the image being added
+
+        TextureRegion mWhite;
+
+        bool pack(Page& page, int width, int height, int& x, int& y);
+        Page& addPage();
+    };
+}
+
+#endif // SCORPION_TEXTURE_ATLAS_H
@@ -5,6 +5,8 @@
 
 #include "scorpion/core/scene.h"
 
+#include "scorpion/hal/mesh.h"
+
 #include "scorpion/util/math.h"
 
 namespace scorpion::actors {
@@ -12,6 +14,7 @@ namespace scorpion::actors {
 
     SCORPION_API Actor* CreateActorWithTransform(math::Vec3 position = math::Vec3::zero, math::Vec3 size = math::Vec3::zero, math::Quat rotation = math::Quat::identity, Scene* scene = nullptr);
     SCORPION_API Actor* CreateCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color, Scene* scene = nullptr);
+    SCORPION_API Actor* CreateMesh(SharedPtr<render::Mesh> mesh, math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color = math::Color::white, Scene* scene = nullptr);
 }
 
 #endif // SCORPION_ACTOR_FACTORY_H
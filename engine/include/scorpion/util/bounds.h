@@ -0,0 +1,97 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_BOUNDS_H
+#define SCORPION_BOUNDS_H 1
+
+#include "scorpion/util/math.h"
+
+#include <cmath>
+
+namespace scorpion {
+    struct AABB {
+        math::Vec3 min;
+        math::Vec3 max;
+
+        bool overlaps(const AABB& other) const {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                   min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        bool contains(const AABB& other) const {
+            return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+                   max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+        }
+
+        // Box around this one after going through matrix, a little bigger than the transformed box itself unless the matrix only scales
+        AABB transformed(const math::Matrix4& matrix) const {
+            const float* m = matrix.m;
+            math::Vec3 center = (min + max) * 0.5f;
+            math::Vec3 half = (max - min) * 0.5f;
+
+            math::Vec3 newCenter(m[0] * center.x + m[4] * center.y + m[8] * center.z + m[12],
+                                 m[1] * center.x + m[5] * center.y + m[9] * center.z + m[13],
+                                 m[2] * center.x + m[6] * center.y + m[10] * center.z + m[14]);
+            math::Vec3 newHalf(std::abs(m[0]) * half.x + std::abs(m[4]) * half.y + std::abs(m[8]) * half.z,
+                               std::abs(m[1]) * half.x + std::abs(m[5]) * half.y + std::abs(m[9]) * half.z,
+                               std::abs(m[2]) * half.x + std::abs(m[6]) * half.y + std::abs(m[10]) * half.z);
+
+            return { newCenter - newHalf, newCenter + newHalf };
+        }
+    };
+
+    // Six planes facing inwards, xyz is the normal and w the distance so a point p is inside a plane when dot(xyz, p) + w >= 0
+    struct Frustum {
+        math::Vec4 planes[6]; // left, right, bottom, top, near, far
+
+        // Gribb/Hartmann, works for perspective and orthographic alike
+        static Frustum fromMatrix(const math::Matrix4& viewProjection) {
+            const float* m = viewProjection.m;
+            math::Vec4 row0(m[0], m[4], m[8], m[12]);
+            math::Vec4 row1(m[1], m[5], m[9], m[13]);
+            math::Vec4 row2(m[2], m[6], m[10], m[14]);
+            math::Vec4 row3(m[3], m[7], m[11], m[15]);
+
+            Frustum frustum;
+            frustum.planes[0] = row3 + row0;
+            frustum.planes[1] = row3 - row0;
+            frustum.planes[2] = row3 + row1;
+            frustum.planes[3] = row3 - row1;
+            frustum.planes[4] = row3 + row2;
+            frustum.planes[5] = row3 - row2;
+
+            for (math::Vec4& plane : frustum.planes) {
+                float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+                if (length > 0.0f) plane = math::Vec4(plane.x / length, plane.y / length, plane.z / length, plane.w / length);
+            }
+
+            return frustum;
+        }
+
+        bool contains(math::Vec3 point) const {
+            for (const math::Vec4& plane : planes) {
+                if (plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w < 0.0f) return false;
+            }
+            return true;
+        }
+
+        // Conservative, big boxes just outside a corner can still pass. Good enough for culling.
+        // No early out, whether a box is in or out is a coin toss while culling a scene and a mispredict costs more than the other planes
+        bool intersects(const AABB& box) const {
+            math::Vec3 center = (box.min + box.max) * 0.5f;
+            math::Vec3 half = (box.max - box.min) * 0.5f;
+
+            bool inside = true;
+            for (const math::Vec4& plane : planes) {
+                // distance of the corner furthest along the normal
+                float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w +
+                                 std::abs(plane.x) * half.x + std::abs(plane.y) * half.y + std::abs(plane.z) * half.z;
+
+                inside &= distance >= 0.0f;
+            }
+            return inside;
+        }
+    };
+}
+
+#endif // SCORPION_BOUNDS_H
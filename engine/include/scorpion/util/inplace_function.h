@@ -0,0 +1,89 @@
+// Copyright 2025 JesusTouchMe
+
+#ifndef SCORPION_INPLACE_FUNCTION_H
+#define SCORPION_INPLACE_FUNCTION_H 1
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace scorpion {
+    template<class Signature, size_t Capacity = 48>
+    class InplaceFunction;
+
+    // Like std::function but the callable always lives inside the object, anything that doesn't fit is a compile error instead of a heap allocation
+    template<class R, class... Args, size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity> {
+    public:
+        InplaceFunction() = default;
+        InplaceFunction(std::nullptr_t) {}
+
+        template<class F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InplaceFunction>>>
+        InplaceFunction(F&& f) {
+            using Fn = std::decay_t<F>;
+
+            static_assert(sizeof(Fn) <= Capacity, "callable doesn't fit in the InplaceFunction, capture less or capture by pointer");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable is over aligned");
+            static_assert(std::is_nothrow_move_constructible_v<Fn>, "callable has to be nothrow move constructible");
+
+            new(mStorage) Fn(std::forward<F>(f));
+
+            mInvoke = [](void* storage, Args&&... args) -> R {
+                return (*std::launder(reinterpret_cast<Fn*>(storage)))(std::forward<Args>(args)...);
+            };
+            mManage = [](void* dst, void* src) {
+                Fn* source = std::launder(reinterpret_cast<Fn*>(src));
+                if (dst != nullptr) new(dst) Fn(std::move(*source));
+                source->~Fn();
+            };
+        }
+
+        InplaceFunction(InplaceFunction&& other) noexcept {
+            moveFrom(other);
+        }
+
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        InplaceFunction(const InplaceFunction&) = delete;
+        InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+        ~InplaceFunction() {
+            reset();
+        }
+
+        R operator()(Args... args) {
+            return mInvoke(mStorage, std::forward<Args>(args)...);
+        }
+
+        explicit operator bool() const { return mInvoke != nullptr; }
+
+        void reset() {
+            if (mManage != nullptr) mManage(nullptr, mStorage);
+            mInvoke = nullptr;
+            mManage = nullptr;
+        }
+
+    private:
+        alignas(std::max_align_t) unsigned char mStorage[Capacity];
+        R (*mInvoke)(void*, Args&&...) = nullptr;
+        void (*mManage)(void* dst, void* src) = nullptr;
+
+        void moveFrom(InplaceFunction& other) {
+            if (other.mManage != nullptr) other.mManage(mStorage, other.mStorage);
+
+            mInvoke = other.mInvoke;
+            mManage = other.mManage;
+            other.mInvoke = nullptr;
+            other.mManage = nullptr;
+        }
+    };
+}
+
+#endif // SCORPION_INPLACE_FUNCTION_H
@@ -643,6 +643,19 @@ namespace scorpion::math {
 
             return result;
         }
+
+        static Matrix4 orthographic(float left, float right, float bottom, float top, float nearPlane, float farPlane) {
+            Matrix4 result = identity();
+
+            result.m[0] = 2.0f / (right - left);
+            result.m[5] = 2.0f / (top - bottom);
+            result.m[10] = -2.0f / (farPlane - nearPlane);
+            result.m[12] = -(right + left) / (right - left);
+            result.m[13] = -(top + bottom) / (top - bottom);
+            result.m[14] = -(farPlane + nearPlane) / (farPlane - nearPlane);
+
+            return result;
+        }
     };
 
     inline Quat Quat::fromMatrix(const Matrix4& matrix) {
@@ -3,6 +3,7 @@
 #ifndef SCORPION_TIMER_H
 #define SCORPION_TIMER_H 1
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -35,14 +36,41 @@ namespace scorpion {
             mDelta = delta.count();
         }
 
-        void wait() {
-            if (mTarget <= 0.0) return;
+        // Returns how long it asked the OS to sleep for, in seconds
+        double wait() {
+            if (mTarget <= 0.0) return 0.0;
 
             auto target = std::chrono::duration<double>(mTarget);
             auto elapsed = Clock::now() - mPrevious;
             if (elapsed < target) {
-                std::this_thread::sleep_for(target - elapsed); // TODO: maybe use a different way to sleep 90% of the wait time, then busy wait the last 10% for accuracy
+                auto sleep = target - elapsed;
+                std::this_thread::sleep_for(sleep); // TODO: maybe use a different way to sleep 90% of the wait time, then busy wait the last 10% for accuracy
+                return std::chrono::duration<double>(sleep).count();
             }
+
+            return 0.0;
+        }
+
+        // Same as wait, but sleeps at most slice seconds at a time and calls between after every nap. For things that have to keep
+        // happening on this thread while it waits
+        template<class F>
+        double wait(double slice, F&& between) {
+            if (mTarget <= 0.0) return 0.0;
+
+            auto due = nextDue();
+            auto now = Clock::now();
+            if (now >= due) return 0.0;
+
+            auto step = std::chrono::duration_cast<typename Clock::duration>(std::chrono::duration<double>(slice));
+            double requested = std::chrono::duration<double>(due - now).count();
+
+            while (now < due) {
+                std::this_thread::sleep_for(slice > 0.0 ? std::min<typename Clock::duration>(due - now, step) : due - now);
+                between();
+                now = Clock::now();
+            }
+
+            return requested;
         }
 
         double getTarget() const { return mTarget; }
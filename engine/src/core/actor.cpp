@@ -1,48 +1,180 @@
 // Copyright 2025 JesusTouchMe
 
 #include "scorpion/core/actor.h"
+#include "scorpion/core/scene.h"
 
 #include "scorpion/engine_std/transform.h"
 
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include <algorithm>
+
 namespace scorpion {
     Actor::Actor(Scene* scene)
         : mScene(scene) {}
 
     Actor::~Actor() {
-        for (auto& [key, component] : mComponents) {
-            component->onDestroy();
+        for (Component* component : mComponents) {
+            if (component != nullptr) component->onDestroy();
+        }
+
+        for (Component* component : mComponents) {
+            if (component != nullptr) destroyComponent(component);
         }
     }
 
+    void Actor::setActive(bool active) {
+        if (active == mActive) return;
+
+        mActive = active;
+
+        if (active) mScene->queueStart(this);
+        else mScene->unlistActor(this);
+    }
+
     void Actor::applyShader(const SharedPtr<render::Shader>& shader) {
-        for (auto& [key, component] : mComponents) {
+        for (Component* component : mComponents) {
             //NOTE: this applies to inactive renderables too
-            if (auto* renderable = dynamic_cast<RenderableComponent*>(component.get())) {
+            if (auto* renderable = dynamic_cast<RenderableComponent*>(component)) {
                 renderable->setShader(shader);
             }
         }
     }
 
-    void Actor::update(double dt) {
+    memory::Pool* Actor::getComponentPool(size_t size) {
+        return mScene->getObjectPool(size);
+    }
+
+    void Actor::onSignatureChanged(const ComponentSignature& previous) {
+        mScene->updateQueries(this, previous);
+    }
+
+    void Actor::onComponentAdded(Component* component) {
+        mScene->queueStart(component);
+
+        if (auto* renderable = dynamic_cast<RenderableComponent*>(component)) mRenderLayers |= RenderableComponent::LayerBit(renderable->getLayer());
+    }
+
+    void Actor::onComponentRemoved(Component* component) {
+        mScene->dequeueStart(component);
+        unlistComponent(component);
+
+        if (dynamic_cast<RenderableComponent*>(component) != nullptr) {
+            mRenderLayers = 0;
+            for (Component* other : mComponents) {
+                if (other == nullptr || other == component) continue;
+                if (auto* renderable = dynamic_cast<RenderableComponent*>(other)) mRenderLayers |= RenderableComponent::LayerBit(renderable->getLayer());
+            }
+        }
+    }
+
+    void Actor::onComponentActiveChanged(Component* component) {
+        if (component->mActive) mScene->queueStart(component);
+        else unlistComponent(component);
+    }
+
+    void Actor::listComponent(Component* component) {
+        if (component->mListed) return;
+
+        component->mListed = true;
+        component->mSkippedTime = 0.0; // it wasn't updated while it was off the list, that doesn't count as skipped
+
+        auto it = std::upper_bound(mActiveComponents.begin(), mActiveComponents.end(), component, [](const Component* a, const Component* b) {
+            return a->mTypeId < b->mTypeId;
+        });
+        mActiveComponents.insert(it, component);
+    }
+
+    void Actor::unlistComponent(Component* component) {
+        if (!component->mListed) return;
+
+        component->mListed = false;
+
+        auto it = std::find(mActiveComponents.begin(), mActiveComponents.end(), component);
+
+        // update is walking the list, it gets compacted once it's done
+        if (mUpdating) {
+            *it = nullptr;
+            mCompact = true;
+        } else {
+            mActiveComponents.erase(it);
+        }
+    }
+
+    void Actor::destroyComponent(Component* component) {
+        memory::Pool* pool = component->mPool;
+        void* memory = dynamic_cast<void*>(component);
+
+        component->~Component();
+        pool->free(memory);
+    }
+
+    size_t Actor::update(double dt, bool due, size_t& skipped) {
+        SCORPION_PROFILE_SCOPE("Actor::update");
+
         onUpdate(dt);
 
-        for (auto& [key, component] : mComponents) {
-            if (!component->isActive()) continue;
+        // nothing gets added to the list mid update, new and reactivated components wait in the scene's start queue.
+        // Deactivated ones leave a hole behind
+        mUpdating = true;
+
+        size_t count = mActiveComponents.size();
+        size_t updated = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            Component* component = mActiveComponents[i];
+            if (component == nullptr) continue;
+
+            if (!component->mThrottled) {
+                component->onUpdate(dt);
+                updated++;
+                continue;
+            }
 
-            if (!component->mStarted) {
-                component->onStart();
-                component->mStarted = true;
+            component->mSkippedTime += dt;
+            if (!due) {
+                skipped++;
+                continue;
             }
 
-            component->onUpdate(dt);
+            double time = component->mSkippedTime;
+            component->mSkippedTime = 0.0;
+
+            component->onUpdate(time);
+            updated++;
         }
+
+        mUpdating = false;
+
+        if (mCompact) {
+            mActiveComponents.erase(std::remove(mActiveComponents.begin(), mActiveComponents.end(), nullptr), mActiveComponents.end());
+            mCompact = false;
+        }
+
+        return updated;
     }
 
-    void Actor::renderPass(RenderableComponent::Layer pass) {
-        for (auto& [key, component] : mComponents) {
-            if (component->isActive()) {
-                if (auto* renderable = dynamic_cast<RenderableComponent*>(component.get())) {
-                    if (renderable->getLayer() == pass) {
+    size_t Actor::renderPass(RenderableComponent::Layer pass, const Frustum* frustum) {
+        SCORPION_PROFILE_SCOPE("Actor::renderPass");
+
+        size_t culled = 0;
+
+        for (Component* component : mComponents) {
+            if (component != nullptr && component->isActive()) {
+                if (auto* renderable = dynamic_cast<RenderableComponent*>(component)) {
+                    if (renderable->getLayer() != pass) continue;
+
+                    if (frustum != nullptr) {
+                        AABB bounds;
+                        if (renderable->getBounds(bounds) && !frustum->intersects(bounds)) {
+                            culled++;
+                            continue;
+                        }
+                    }
+
+                    if (renderable->isBatched()) {
+                        renderable->onRender();
+                    } else {
                         renderable->beginShader();
                         renderable->onRender();
                         renderable->endShader();
@@ -50,5 +182,7 @@ namespace scorpion {
                 }
             }
         }
+
+        return culled;
     }
 }
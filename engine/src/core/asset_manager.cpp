@@ -0,0 +1,440 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/asset_manager.h"
+
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace scorpion::assets {
+    struct Pack;
+
+    struct Asset {
+        Pack* pack = nullptr;
+        const PackEntry* entry = nullptr;
+
+        std::atomic<uint32_t> refs = 0;
+        std::atomic<bool> resident = false;
+
+        // everything below is guarded by the manager's mutex
+        bool queued = false;
+        Priority queuedPriority = Priority::Low;
+
+        bool cached = false; // in the lru list
+        Asset* older = nullptr;
+        Asset* newer = nullptr;
+    };
+
+    struct Pack {
+        String path;
+        AssetPack file;
+        Vector<Asset> assets; // one per entry, same order, sized once on mount and never grown
+    };
+
+    class AssetManager {
+    public:
+        ~AssetManager() {
+            {
+                std::lock_guard lock(mMutex);
+                mStop = true;
+            }
+            mCondition.notify_all();
+
+            if (mThread.joinable()) mThread.join();
+        }
+
+        bool mount(const char* path) {
+            auto pack = MakeUnique<Pack>();
+            pack->path = path;
+
+            if (!pack->file.open(path)) return false;
+
+            uint32_t count = pack->file.getEntryCount();
+            pack->assets = Vector<Asset>(count);
+
+            for (uint32_t i = 0; i < count; i++) {
+                pack->assets[i].pack = pack.get();
+                pack->assets[i].entry = &pack->file.getEntry(i);
+            }
+
+            std::lock_guard lock(mMutex);
+            mPacks.push_back(std::move(pack));
+            return true;
+        }
+
+        bool unmount(const char* path) {
+            std::unique_lock lock(mMutex);
+
+            Pack* pack;
+            uint32_t count;
+
+            // the io thread reads from the mapping outside the lock, and waiting for it lets go of the lock too. Anything can happen
+            // to the pack in the meantime, including a load taking a handle or another unmount, so everything gets checked again after
+            while (true) {
+                auto it = std::find_if(mPacks.begin(), mPacks.end(), [path](const UniquePtr<Pack>& pack) {
+                    return pack->path == path;
+                });
+                if (it == mPacks.end()) return false;
+
+                pack = it->get();
+                count = pack->file.getEntryCount();
+
+                for (uint32_t i = 0; i < count; i++) {
+                    if (pack->assets[i].refs.load() > 0) return false;
+                }
+
+                if (mInFlight == nullptr || mInFlight->pack != pack) break;
+
+                mReadyCondition.wait(lock);
+            }
+
+            for (uint32_t i = 0; i < count; i++) {
+                Asset& asset = pack->assets[i];
+
+                if (asset.cached) uncache(&asset);
+                if (asset.resident.load()) mResident -= asset.entry->size;
+            }
+
+            mQueue.erase(std::remove_if(mQueue.begin(), mQueue.end(), [pack](const Request& request) {
+                return request.asset->pack == pack;
+            }), mQueue.end());
+            std::make_heap(mQueue.begin(), mQueue.end(), RequestOrder());
+
+            mPacks.erase(std::find_if(mPacks.begin(), mPacks.end(), [pack](const UniquePtr<Pack>& other) {
+                return other.get() == pack;
+            }));
+
+            return true;
+        }
+
+        AssetHandle load(const char* name, Priority priority) {
+            std::lock_guard lock(mMutex);
+
+            Asset* asset = find(name);
+            if (asset == nullptr) return {};
+
+            if (asset->refs.fetch_add(1) == 0 && asset->cached) uncache(asset);
+
+            request(asset, priority);
+            return AssetHandle(asset);
+        }
+
+        void prefetch(const char* path, Priority priority) {
+            std::lock_guard lock(mMutex);
+
+            for (const UniquePtr<Pack>& pack : mPacks) {
+                if (pack->path != path) continue;
+
+                for (uint32_t i = 0; i < pack->file.getEntryCount(); i++) {
+                    request(&pack->assets[i], priority);
+                }
+            }
+        }
+
+        void acquire(Asset* asset) {
+            if (asset->refs.fetch_add(1) != 0) return;
+
+            std::lock_guard lock(mMutex);
+            if (asset->cached) uncache(asset);
+        }
+
+        void release(Asset* asset) {
+            if (asset->refs.fetch_sub(1) != 1) return;
+
+            std::lock_guard lock(mMutex);
+
+            // someone might have grabbed it again in between
+            if (asset->refs.load() == 0 && asset->resident.load() && !asset->cached) {
+                cache(asset);
+                evictOverBudget();
+            }
+        }
+
+        void wait(Asset* asset) {
+            if (asset->resident.load(std::memory_order_acquire)) return;
+
+            std::unique_lock lock(mMutex);
+
+            // a live handle keeps it out of the lru so this shouldn't happen, but don't hang forever if it does
+            if (!asset->queued && !asset->resident.load()) request(asset, Priority::High);
+
+            mReadyCondition.wait(lock, [asset] { return asset->resident.load(); });
+        }
+
+        void setBudget(size_t bytes) {
+            std::lock_guard lock(mMutex);
+
+            mBudget = bytes;
+            evictOverBudget();
+        }
+
+        size_t getResident() {
+            std::lock_guard lock(mMutex);
+            return mResident;
+        }
+
+        size_t getPending() {
+            std::lock_guard lock(mMutex);
+            return mQueue.size() + (mInFlight != nullptr ? 1 : 0);
+        }
+
+    private:
+        struct Request {
+            Asset* asset;
+            Priority priority;
+            uint64_t sequence;
+        };
+
+        // max heap, so "less" means served later: lower priority, then newer
+        struct RequestOrder {
+            bool operator()(const Request& a, const Request& b) const {
+                if (a.priority != b.priority) return a.priority < b.priority;
+                return a.sequence > b.sequence;
+            }
+        };
+
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::condition_variable mReadyCondition;
+
+        Vector<UniquePtr<Pack>> mPacks;
+
+        Vector<Request> mQueue;
+        uint64_t mSequence = 0;
+        Asset* mInFlight = nullptr;
+
+        size_t mBudget = 0;
+        size_t mResident = 0;
+
+        Asset* mOldest = nullptr;
+        Asset* mNewest = nullptr;
+
+        std::thread mThread;
+        bool mStop = false;
+
+        Asset* find(const char* name) {
+            for (auto it = mPacks.rbegin(); it != mPacks.rend(); ++it) {
+                Pack& pack = **it;
+
+                if (const PackEntry* entry = pack.file.find(name)) {
+                    return &pack.assets[entry - &pack.file.getEntry(0)];
+                }
+            }
+
+            return nullptr;
+        }
+
+        void request(Asset* asset, Priority priority) {
+            if (asset->resident.load()) return;
+
+            // a bump in priority just queues it again, the io thread skips whichever copy comes second
+            if (asset->queued && priority <= asset->queuedPriority) return;
+
+            asset->queued = true;
+            asset->queuedPriority = priority;
+
+            mQueue.push_back({ asset, priority, mSequence++ });
+            std::push_heap(mQueue.begin(), mQueue.end(), RequestOrder());
+
+            if (!mThread.joinable()) mThread = std::thread([this] { ioLoop(); });
+            mCondition.notify_one();
+        }
+
+        void cache(Asset* asset) {
+            asset->cached = true;
+            asset->older = mNewest;
+            asset->newer = nullptr;
+
+            if (mNewest != nullptr) mNewest->newer = asset;
+            else mOldest = asset;
+
+            mNewest = asset;
+        }
+
+        void uncache(Asset* asset) {
+            if (asset->older != nullptr) asset->older->newer = asset->newer;
+            else mOldest = asset->newer;
+
+            if (asset->newer != nullptr) asset->newer->older = asset->older;
+            else mNewest = asset->older;
+
+            asset->cached = false;
+            asset->older = nullptr;
+            asset->newer = nullptr;
+        }
+
+        void evictOverBudget() {
+            if (mBudget == 0) return;
+
+            while (mResident > mBudget && mOldest != nullptr) {
+                Asset* asset = mOldest;
+                uncache(asset);
+
+                asset->pack->file.getFile().evict(asset->entry->offset, asset->entry->size);
+                asset->resident.store(false);
+                mResident -= asset->entry->size;
+            }
+        }
+
+        void ioLoop() {
+#ifdef SCORPION_PROFILER
+            profiler::SetThreadName("Asset IO");
+#endif
+
+            std::unique_lock lock(mMutex);
+
+            while (true) {
+                mCondition.wait(lock, [this] { return mStop || !mQueue.empty(); });
+                if (mStop) break;
+
+                std::pop_heap(mQueue.begin(), mQueue.end(), RequestOrder());
+                Request request = mQueue.back();
+                mQueue.pop_back();
+
+                Asset* asset = request.asset;
+                if (asset->resident.load() || !asset->queued || request.priority != asset->queuedPriority) continue;
+
+                mInFlight = asset;
+                lock.unlock();
+
+                {
+                    SCORPION_PROFILE_SCOPE("AssetManager::pageIn");
+                    asset->pack->file.getFile().prefetch(asset->entry->offset, asset->entry->size);
+                }
+
+                lock.lock();
+                mInFlight = nullptr;
+
+                asset->queued = false;
+                asset->resident.store(true, std::memory_order_release);
+                mResident += asset->entry->size;
+
+                // prefetched without a handle, or every handle went away while it was loading
+                if (asset->refs.load() == 0) cache(asset);
+                evictOverBudget();
+
+                mReadyCondition.notify_all();
+            }
+        }
+    };
+
+    static AssetManager& GetAssetManager() {
+        static AssetManager manager;
+        return manager;
+    }
+
+    AssetHandle::AssetHandle(Asset* asset)
+        : mAsset(asset) {}
+
+    AssetHandle::~AssetHandle() {
+        if (mAsset != nullptr) GetAssetManager().release(mAsset);
+    }
+
+    AssetHandle::AssetHandle(const AssetHandle& other)
+        : mAsset(other.mAsset) {
+        if (mAsset != nullptr) GetAssetManager().acquire(mAsset);
+    }
+
+    AssetHandle::AssetHandle(AssetHandle&& other) noexcept
+        : mAsset(std::exchange(other.mAsset, nullptr)) {}
+
+    AssetHandle& AssetHandle::operator=(const AssetHandle& other) {
+        if (other.mAsset != nullptr) GetAssetManager().acquire(other.mAsset);
+        if (mAsset != nullptr) GetAssetManager().release(mAsset);
+
+        mAsset = other.mAsset;
+        return *this;
+    }
+
+    AssetHandle& AssetHandle::operator=(AssetHandle&& other) noexcept {
+        if (this != &other) {
+            if (mAsset != nullptr) GetAssetManager().release(mAsset);
+            mAsset = std::exchange(other.mAsset, nullptr);
+        }
+
+        return *this;
+    }
+
+    bool AssetHandle::isValid() const {
+        return mAsset != nullptr;
+    }
+
+    bool AssetHandle::isReady() const {
+        return mAsset != nullptr && mAsset->resident.load(std::memory_order_acquire);
+    }
+
+    void AssetHandle::wait() const {
+        if (mAsset != nullptr) GetAssetManager().wait(mAsset);
+    }
+
+    const char* AssetHandle::getName() const {
+        return mAsset != nullptr ? mAsset->pack->file.getName(*mAsset->entry) : "";
+    }
+
+    AssetType AssetHandle::getType() const {
+        return mAsset != nullptr ? mAsset->entry->type : AssetType::Blob;
+    }
+
+    const uint8_t* AssetHandle::getData() const {
+        return mAsset != nullptr ? mAsset->pack->file.getData(*mAsset->entry) : nullptr;
+    }
+
+    size_t AssetHandle::getSize() const {
+        return mAsset != nullptr ? mAsset->entry->size : 0;
+    }
+
+    MeshView AssetHandle::getMesh() const {
+        return mAsset != nullptr ? mAsset->pack->file.getMesh(*mAsset->entry) : MeshView();
+    }
+
+    ShaderView AssetHandle::getShader() const {
+        return mAsset != nullptr ? mAsset->pack->file.getShader(*mAsset->entry) : ShaderView();
+    }
+
+    bool MountPack(const char* path) {
+        return GetAssetManager().mount(path);
+    }
+
+    bool UnmountPack(const char* path) {
+        return GetAssetManager().unmount(path);
+    }
+
+    AssetHandle Load(const char* name, Priority priority) {
+        return GetAssetManager().load(name, priority);
+    }
+
+    void PrefetchPack(const char* path, Priority priority) {
+        GetAssetManager().prefetch(path, priority);
+    }
+
+    void SetMemoryBudget(size_t bytes) {
+        GetAssetManager().setBudget(bytes);
+    }
+
+    size_t GetResidentBytes() {
+        return GetAssetManager().getResident();
+    }
+
+    size_t GetPendingLoads() {
+        return GetAssetManager().getPending();
+    }
+
+    SharedPtr<render::Mesh> CreateMesh(const AssetHandle& handle) {
+        MeshView view = handle.getMesh();
+        if (view.vertices == nullptr) return nullptr;
+
+        return MakeShared<render::Mesh>(view.vertices, view.vertexCount, view.indices, view.indexCount, render::Mesh::Usage::Static);
+    }
+
+    SharedPtr<render::ShaderRequest> CompileShader(const AssetHandle& handle) {
+        ShaderView view = handle.getShader();
+        if (view.vertexSource == nullptr) return nullptr;
+
+        return render::CompileShaderAsync(view.vertexSource, view.fragmentSource);
+    }
+}
@@ -0,0 +1,272 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/asset_pack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace scorpion::assets {
+    uint64_t HashAssetName(const char* name) {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (; *name != '\0'; name++) {
+            hash ^= static_cast<uint8_t>(*name);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    bool AssetPack::open(const char* path) {
+        close();
+
+        if (!mFile.open(path)) return false;
+
+        size_t size = mFile.size();
+        auto header = reinterpret_cast<const PackHeader*>(mFile.data());
+
+        bool valid = size >= sizeof(PackHeader)
+            && header->magic == PackMagic
+            && header->version == PackVersion
+            && header->entriesOffset % alignof(PackEntry) == 0
+            && header->entriesOffset <= size
+            && header->entryCount <= (size - header->entriesOffset) / sizeof(PackEntry)
+            && header->namesOffset <= size
+            && (header->namesOffset == size || mFile.data()[size - 1] == '\0'); // so a name can't run off the end of the mapping
+
+        if (!valid) {
+            mFile.close();
+            return false;
+        }
+
+        mHeader = header;
+        mEntries = reinterpret_cast<const PackEntry*>(mFile.data() + header->entriesOffset);
+        mNames = reinterpret_cast<const char*>(mFile.data() + header->namesOffset);
+        mNamesSize = size - header->namesOffset;
+
+        return true;
+    }
+
+    void AssetPack::close() {
+        mFile.close();
+
+        mHeader = nullptr;
+        mEntries = nullptr;
+        mNames = nullptr;
+        mNamesSize = 0;
+    }
+
+    bool AssetPack::isOpen() const {
+        return mHeader != nullptr;
+    }
+
+    uint32_t AssetPack::getEntryCount() const {
+        return mHeader != nullptr ? mHeader->entryCount : 0;
+    }
+
+    const PackEntry& AssetPack::getEntry(uint32_t index) const {
+        return mEntries[index];
+    }
+
+    const PackEntry* AssetPack::find(uint64_t hash) const {
+        const PackEntry* end = mEntries + getEntryCount();
+        const PackEntry* it = std::lower_bound(mEntries, end, hash, [](const PackEntry& entry, uint64_t hash) {
+            return entry.hash < hash;
+        });
+
+        return it != end && it->hash == hash ? it : nullptr;
+    }
+
+    const PackEntry* AssetPack::find(const char* name) const {
+        const PackEntry* end = mEntries + getEntryCount();
+        uint64_t hash = HashAssetName(name);
+
+        // the hash only narrows it down, two names can still share one
+        for (const PackEntry* it = find(hash); it != nullptr && it != end && it->hash == hash; it++) {
+            if (strcmp(getName(*it), name) == 0) return it;
+        }
+
+        return nullptr;
+    }
+
+    const char* AssetPack::getName(const PackEntry& entry) const {
+        if (entry.name >= mNamesSize) return "";
+        return mNames + entry.name;
+    }
+
+    const uint8_t* AssetPack::getData(const PackEntry& entry) const {
+        if (entry.offset % PayloadAlignment != 0 || entry.offset > mFile.size() || entry.size > mFile.size() - entry.offset) return nullptr;
+        return mFile.data() + entry.offset;
+    }
+
+    // offset and count come straight from the file, so the check can't be allowed to overflow
+    template<class T>
+    static bool FitsArray(uint64_t offset, uint64_t count, uint64_t size) {
+        return offset % alignof(T) == 0 && offset <= size && count <= (size - offset) / sizeof(T);
+    }
+
+    MeshView AssetPack::getMesh(const PackEntry& entry) const {
+        const uint8_t* data = getData(entry);
+        if (entry.type != AssetType::Mesh || data == nullptr || entry.size < sizeof(MeshHeader)) return {};
+
+        auto header = reinterpret_cast<const MeshHeader*>(data);
+
+        if (!FitsArray<render::Vertex>(header->verticesOffset, header->vertexCount, entry.size)) return {};
+        if (!FitsArray<uint16_t>(header->indicesOffset, header->indexCount, entry.size)) return {};
+
+        MeshView view;
+        view.vertices = reinterpret_cast<const render::Vertex*>(data + header->verticesOffset);
+        view.vertexCount = header->vertexCount;
+        view.indices = header->indexCount > 0 ? reinterpret_cast<const uint16_t*>(data + header->indicesOffset) : nullptr;
+        view.indexCount = header->indexCount;
+        return view;
+    }
+
+    ShaderView AssetPack::getShader(const PackEntry& entry) const {
+        const uint8_t* data = getData(entry);
+        if (entry.type != AssetType::Shader || data == nullptr || entry.size < sizeof(ShaderHeader)) return {};
+
+        auto header = reinterpret_cast<const ShaderHeader*>(data);
+        if (header->vertexOffset >= entry.size || header->fragmentOffset >= entry.size || data[entry.size - 1] != '\0') return {};
+
+        return { reinterpret_cast<const char*>(data + header->vertexOffset), reinterpret_cast<const char*>(data + header->fragmentOffset) };
+    }
+
+    const io::MappedFile& AssetPack::getFile() const {
+        return mFile;
+    }
+
+    static size_t Align(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    AssetPackWriter::Asset& AssetPackWriter::add(const char* name, AssetType type) {
+        Asset& asset = mAssets.emplace_back();
+        asset.name = name;
+        asset.type = type;
+        return asset;
+    }
+
+    void AssetPackWriter::addBlob(const char* name, AssetType type, const void* data, size_t size) {
+        Asset& asset = add(name, type);
+
+        auto bytes = static_cast<const uint8_t*>(data);
+        asset.data.assign(bytes, bytes + size);
+    }
+
+    void AssetPackWriter::addMesh(const char* name, const render::Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount) {
+        Asset& asset = add(name, AssetType::Mesh);
+
+        MeshHeader header;
+        header.vertexCount = vertexCount;
+        header.indexCount = indices != nullptr ? indexCount : 0;
+        header.verticesOffset = Align(sizeof(MeshHeader), 16);
+        header.indicesOffset = header.verticesOffset + vertexCount * sizeof(render::Vertex);
+
+        asset.data.resize(header.indicesOffset + header.indexCount * sizeof(uint16_t));
+        memcpy(asset.data.data(), &header, sizeof(header));
+        if (vertexCount > 0) memcpy(asset.data.data() + header.verticesOffset, vertices, vertexCount * sizeof(render::Vertex));
+        if (header.indexCount > 0) memcpy(asset.data.data() + header.indicesOffset, indices, header.indexCount * sizeof(uint16_t));
+    }
+
+    void AssetPackWriter::addShader(const char* name, const char* vertexSource, const char* fragmentSource) {
+        Asset& asset = add(name, AssetType::Shader);
+
+        size_t vertexSize = strlen(vertexSource) + 1;
+        size_t fragmentSize = strlen(fragmentSource) + 1;
+
+        ShaderHeader header;
+        header.vertexOffset = sizeof(ShaderHeader);
+        header.fragmentOffset = header.vertexOffset + vertexSize;
+
+        asset.data.resize(header.fragmentOffset + fragmentSize);
+        memcpy(asset.data.data(), &header, sizeof(header));
+        memcpy(asset.data.data() + header.vertexOffset, vertexSource, vertexSize);
+        memcpy(asset.data.data() + header.fragmentOffset, fragmentSource, fragmentSize);
+    }
+
+    bool AssetPackWriter::write(const char* path) const {
+        struct Sorted {
+            uint64_t hash;
+            const Asset* asset;
+        };
+
+        Vector<Sorted> sorted;
+        sorted.reserve(mAssets.size());
+
+        for (const Asset& asset : mAssets) {
+            sorted.push_back({ HashAssetName(asset.name.c_str()), &asset });
+        }
+
+        // stable, so for duplicate names the one added last ends up last and wins below
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Sorted& a, const Sorted& b) {
+            return a.hash < b.hash;
+        });
+
+        Vector<Sorted> unique;
+        unique.reserve(sorted.size());
+
+        for (size_t i = 0; i < sorted.size(); i++) {
+            bool replaced = false;
+            for (size_t j = i + 1; j < sorted.size() && sorted[j].hash == sorted[i].hash; j++) {
+                if (sorted[j].asset->name == sorted[i].asset->name) replaced = true;
+            }
+
+            if (!replaced) unique.push_back(sorted[i]);
+        }
+
+        Vector<PackEntry> entries(unique.size());
+        String names;
+
+        size_t offset = Align(sizeof(PackHeader), PayloadAlignment);
+        for (size_t i = 0; i < unique.size(); i++) {
+            PackEntry& entry = entries[i];
+            entry.hash = unique[i].hash;
+            entry.offset = offset;
+            entry.size = unique[i].asset->data.size();
+            entry.type = unique[i].asset->type;
+            entry.name = static_cast<uint32_t>(names.size());
+
+            names += unique[i].asset->name;
+            names += '\0';
+
+            offset = Align(offset + entry.size, PayloadAlignment);
+        }
+
+        PackHeader header = {};
+        header.magic = PackMagic;
+        header.version = PackVersion;
+        header.entryCount = static_cast<uint32_t>(entries.size());
+        header.entriesOffset = offset;
+        header.namesOffset = offset + entries.size() * sizeof(PackEntry);
+
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) return false;
+
+        static const uint8_t padding[PayloadAlignment] = {};
+        size_t written = 0;
+
+        auto put = [&](const void* data, size_t size) {
+            if (size > 0 && fwrite(data, 1, size, file) != size) return false;
+            written += size;
+            return true;
+        };
+
+        auto pad = [&](size_t to) {
+            return put(padding, to - written);
+        };
+
+        bool ok = put(&header, sizeof(header));
+        for (size_t i = 0; ok && i < unique.size(); i++) {
+            ok = pad(entries[i].offset) && put(unique[i].asset->data.data(), unique[i].asset->data.size());
+        }
+
+        ok = ok && pad(header.entriesOffset)
+            && put(entries.data(), entries.size() * sizeof(PackEntry))
+            && put(names.data(), names.size());
+
+        if (fclose(file) != 0) ok = false;
+        return ok;
+    }
+}
@@ -1,8 +1,16 @@
 // Copyright 2025 JesusTouchMe
 
 #include "scorpion/core/component.h"
+#include "scorpion/core/actor.h"
 
 namespace scorpion {
+    void Component::setActive(bool active) {
+        if (active == mActive) return;
+
+        mActive = active;
+        mOwner->onComponentActiveChanged(this);
+    }
+
     void RenderableComponent::beginShader() {
         if (mShader != nullptr) {
             mShader->begin();
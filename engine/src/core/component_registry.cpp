@@ -0,0 +1,37 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/component_registry.h"
+
+#include "scorpion/util/std_types.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <typeindex>
+
+namespace scorpion {
+    static std::mutex registryMutex;
+    static HashMap<std::type_index, ComponentTypeId> registry;
+
+    ComponentTypeId RegisterComponentType(const std::type_info& type) {
+        std::lock_guard lock(registryMutex);
+
+        if (auto it = registry.find(type); it != registry.end()) return it->second;
+
+        ComponentTypeId id = static_cast<ComponentTypeId>(registry.size());
+        if (id >= MaxComponentTypes) {
+            //TODO: NICE ERROR SYSTEM RAHHH
+            printf("Too many component types registered (max %u) when registering %s\n", MaxComponentTypes, type.name());
+            exit(1);
+        }
+
+        registry.emplace(type, id);
+
+        return id;
+    }
+
+    ComponentTypeId GetComponentTypeCount() {
+        std::lock_guard lock(registryMutex);
+        return static_cast<ComponentTypeId>(registry.size());
+    }
+}
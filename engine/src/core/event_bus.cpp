@@ -0,0 +1,67 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/event_bus.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <typeindex>
+
+namespace scorpion {
+    static std::mutex registryMutex;
+    static HashMap<std::type_index, EventTypeId> registry;
+
+    EventTypeId RegisterEventType(const std::type_info& type) {
+        std::lock_guard lock(registryMutex);
+
+        if (auto it = registry.find(type); it != registry.end()) return it->second;
+
+        EventTypeId id = static_cast<EventTypeId>(registry.size());
+        if (id >= MaxEventTypes) {
+            //TODO: NICE ERROR SYSTEM RAHHH
+            printf("Too many event types registered (max %u) when registering %s\n", MaxEventTypes, type.name());
+            exit(1);
+        }
+
+        registry.emplace(type, id);
+
+        return id;
+    }
+
+    EventBus::EventBus() {
+        for (auto& channel : mChannels) {
+            channel.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    EventBus::~EventBus() {
+        for (auto& channel : mChannels) {
+            EventChannelBase* ptr = channel.load(std::memory_order_acquire);
+            if (ptr != nullptr) destroyChannel(ptr);
+        }
+    }
+
+    void EventBus::dispatch() {
+        EventTypeId count = mChannelCount.load(std::memory_order_acquire);
+
+        for (EventTypeId id = 0; id < count; id++) {
+            EventChannelBase* channel = mChannels[id].load(std::memory_order_acquire);
+            if (channel != nullptr) channel->dispatch();
+        }
+    }
+
+    bool EventBus::install(EventTypeId id, EventChannelBase* channel, EventChannelBase*& existing) {
+        existing = nullptr;
+        if (!mChannels[id].compare_exchange_strong(existing, channel, std::memory_order_acq_rel)) return false;
+
+        EventTypeId count = mChannelCount.load(std::memory_order_relaxed);
+        while (count < id + 1 && !mChannelCount.compare_exchange_weak(count, id + 1, std::memory_order_acq_rel)) {}
+
+        return true;
+    }
+
+    void EventBus::destroyChannel(EventChannelBase* channel) {
+        channel->~EventChannelBase();
+        ScorpionHeapFree(channel);
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/hook_scheduler.h"
+
+#include "scorpion/foundation/jobs/job_system.h"
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include <algorithm>
+
+namespace scorpion {
+    void UpdateHookHandle::unregister() {
+        mUnregistered = true;
+    }
+
+    void HookScheduler::add(HookPhase phase, UpdateHook hook, int priority, bool threadSafe) {
+        Phase& p = mPhases[static_cast<size_t>(phase)];
+        Entry entry = { std::move(hook), priority, threadSafe, {} };
+
+        std::lock_guard lock(mMutex);
+        if (p.running) p.pending.push_back(std::move(entry));
+        else insert(p.entries, std::move(entry));
+    }
+
+    void HookScheduler::run(HookPhase phase) {
+        SCORPION_PROFILE_SCOPE("HookScheduler::run");
+
+        Phase& p = mPhases[static_cast<size_t>(phase)];
+        p.running = true;
+
+        size_t count = p.entries.size();
+        for (size_t i = 0; i < count;) {
+            Entry& entry = p.entries[i];
+
+            if (!entry.threadSafe) {
+                entry.hook(entry.handle);
+                if (entry.handle.mUnregistered) p.dirty = true;
+
+                i++;
+                continue;
+            }
+
+            size_t end = i + 1;
+            while (end < count && p.entries[end].threadSafe && p.entries[end].priority == entry.priority) end++;
+
+            Entry* first = &p.entries[i];
+            jobs::ParallelFor(end - i, 1, [first](size_t begin, size_t last) {
+                for (size_t j = begin; j < last; j++) first[j].hook(first[j].handle);
+            });
+
+            for (size_t j = i; j < end; j++) {
+                if (p.entries[j].handle.mUnregistered) p.dirty = true;
+            }
+
+            i = end;
+        }
+
+        // one pass keeps the priority order intact no matter how many hooks went away
+        if (p.dirty) {
+            std::erase_if(p.entries, [](const Entry& entry) { return entry.handle.mUnregistered; });
+            p.dirty = false;
+        }
+
+        for (Entry& entry : p.pending) {
+            insert(p.entries, std::move(entry));
+        }
+        p.pending.clear();
+
+        p.running = false;
+    }
+
+    void HookScheduler::insert(Vector<Entry>& entries, Entry&& entry) {
+        auto it = std::upper_bound(entries.begin(), entries.end(), entry.priority, [](int priority, const Entry& other) {
+            return priority > other.priority;
+        });
+
+        entries.insert(it, std::move(entry));
+    }
+}
@@ -0,0 +1,68 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/prefab.h"
+#include "scorpion/core/scorpion.h"
+
+namespace scorpion {
+    Actor* Prefab::instantiate(Scene* scene) const {
+        if (scene == nullptr) scene = GetActiveScene();
+        if (scene == nullptr) return nullptr;
+
+        return construct(scene);
+    }
+
+    Vector<Actor*> Prefab::instantiate(size_t count, Scene* scene) const {
+        Vector<Actor*> actors;
+
+        if (scene == nullptr) scene = GetActiveScene();
+        if (scene == nullptr) return actors;
+
+        reserve(scene, count);
+        actors.reserve(count);
+
+        for (size_t i = 0; i < count; i++) {
+            actors.push_back(construct(scene));
+        }
+
+        return actors;
+    }
+
+    void Prefab::instantiate(size_t count, const std::function<void(Actor*, size_t)>& init, Scene* scene) const {
+        if (scene == nullptr) scene = GetActiveScene();
+        if (scene == nullptr) return;
+
+        reserve(scene, count);
+
+        for (size_t i = 0; i < count; i++) {
+            init(construct(scene), i);
+        }
+    }
+
+    void Prefab::reserve(Scene* scene, size_t count) const {
+        scene->mActors.reserve(scene->mActors.size() + count);
+
+        // components of similar size share a pool, with each other and with actors, so sum up what every pool needs before reserving.
+        // Pool::reserve makes sure there are that many free blocks, reserving the same pool twice doesn't add up
+        HashMap<memory::Pool*, size_t> blocks;
+        blocks[scene->getObjectPool(sizeof(Actor))] += count;
+
+        for (const ComponentEntry& entry : mComponents) {
+            blocks[scene->getObjectPool(entry.size)] += count;
+        }
+
+        for (auto& [pool, needed] : blocks) {
+            pool->reserve(needed);
+        }
+    }
+
+    Actor* Prefab::construct(Scene* scene) const {
+        Actor* actor = scene->addActor<Actor>();
+        actor->mComponents.resize(mComponentSlots, nullptr);
+
+        for (const ComponentEntry& entry : mComponents) {
+            entry.construct(actor);
+        }
+
+        return actor;
+    }
+}
@@ -1,63 +1,618 @@
 // Copyright 2025 JesusTouchMe
 
 #include "scorpion/core/scene.h"
+#include "scorpion/core/stats.h"
+
+#include "scorpion/engine_std/transform.h"
+
+#include "scorpion/foundation/jobs/job_system.h"
+#include "scorpion/foundation/profiling/profiler.h"
 
 #include "scorpion/hal/renderer.h"
+#include "scorpion/hal/sprite_batch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 namespace scorpion {
+    static inline void Prefetch(const void* address) {
+#ifdef _MSC_VER
+        _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+        __builtin_prefetch(address);
+#endif
+    }
+
+    Scene::~Scene() {
+        // ~Actor runs every component's onDestroy, which can remove or even add actors. Removing only queues with this set, and
+        // everything still in mActors gets destroyed below either way
+        mIterating = true;
+
+        while (!mActors.empty()) {
+            Actor* actor = mActors.back();
+            mActors.pop_back();
+
+            memory::Pool* pool = actor->mPool;
+            void* memory = dynamic_cast<void*>(actor);
+
+            actor->~Actor();
+            pool->free(memory);
+        }
+    }
+
     void Scene::update(double dt) {
-        for (auto& actor: mActors) {
-            if (!actor->isActive()) continue;
+        SCORPION_PROFILE_SCOPE("Scene::update");
+
+        mIterating = true;
 
-            if (!actor->mStarted) {
-                actor->onStart();
-                actor->mStarted = true;
+        startQueued();
+        compactActiveActors();
+
+        size_t actorsUpdated = mActiveActors.size();
+        size_t componentsUpdated = 0;
+        size_t componentsThrottled = 0;
+
+        LODCamera camera;
+        bool lod = makeLODCamera(camera);
+        uint32_t tick = mTick++;
+
+        // actors added or activated from here on wait for the next tick, deactivated ones leave a hole.
+        // The list skips over inactive actors so the hardware prefetcher can't guess what comes next, fetch a few ahead by hand
+        for (size_t i = 0; i < actorsUpdated; i++) {
+            if (i + 4 < actorsUpdated && mActiveActors[i + 4] != nullptr) Prefetch(mActiveActors[i + 4]);
+
+            Actor* actor = mActiveActors[i];
+            if (actor == nullptr) continue;
+
+            bool due = true;
+            if (lod) {
+                actor->mLOD = computeLOD(actor, camera);
+
+                uint32_t interval = mLOD.updateIntervals[actor->mLOD];
+                due = interval <= 1 || (tick + actor->mId) % interval == 0;
+            } else {
+                actor->mLOD = 0;
             }
 
-            actor->update(dt);
+            componentsUpdated += actor->update(dt, due, componentsThrottled);
         }
+
+        // before events go out, handlers tend to want to query where things are now
+        if (mSpatialIndex != nullptr) mSpatialIndex->refresh();
+
+        // background scenes tick alongside the active one, they get their own counters so they don't inflate its numbers
+        if (mBackgroundTick) {
+            stats::Add(stats::Stat::BackgroundActorsUpdated, actorsUpdated);
+            stats::Add(stats::Stat::BackgroundComponentsUpdated, componentsUpdated);
+        } else {
+            stats::Add(stats::Stat::ActorsUpdated, actorsUpdated);
+            stats::Add(stats::Stat::ComponentsUpdated, componentsUpdated);
+            stats::Add(stats::Stat::ComponentsThrottled, componentsThrottled);
+        }
+
+        {
+            SCORPION_PROFILE_SCOPE("EventBus::dispatch");
+            mEventBus.dispatch();
+        }
+
+        flushDestroyQueue();
+
+        mIterating = false;
     }
 
     void Scene::render() {
-        render::BeginDrawing();
-        render::ClearWindow();
+        SCORPION_PROFILE_SCOPE("Scene::render");
+
+        mIterating = true;
+
+        // the implicit view keeps the old single camera frame, no viewport changes at all
+        RenderView windowView;
+        windowView.camera = mActiveCamera;
+
+        bool implicitView = mViews.empty();
+        size_t viewCount = implicitView ? 1 : mViews.size();
+
+        mViewStates.clear();
+        for (size_t i = 0; i < viewCount; i++) {
+            const RenderView& view = implicitView ? windowView : mViews[i];
+            if (!view.enabled) continue;
+
+            int targetWidth = view.target != nullptr ? view.target->getWidth() : render::GetWindowWidth();
+            int targetHeight = view.target != nullptr ? view.target->getHeight() : render::GetWindowHeight();
 
-        if (mActiveCamera != nullptr) {
-            render::Begin3D(mActiveCamera->getPosition(), mActiveCamera->getTarget(), mActiveCamera->getUp(), mActiveCamera->getFovY(), static_cast<int>(mActiveCamera->getProjection()));
-            for (auto& actor: mActors) {
-                if (actor->isActive()) actor->renderPass(RenderableComponent::Layer::World3D);
+            ViewState& state = mViewStates.emplace_back();
+            state.view = &view;
+            state.rect[0] = static_cast<int>(view.x * static_cast<float>(targetWidth));
+            state.rect[1] = static_cast<int>(view.y * static_cast<float>(targetHeight));
+            state.rect[2] = static_cast<int>((view.x + view.width) * static_cast<float>(targetWidth)) - state.rect[0];
+            state.rect[3] = static_cast<int>((view.y + view.height) * static_cast<float>(targetHeight)) - state.rect[1];
+
+            if (state.rect[2] <= 0 || state.rect[3] <= 0) {
+                mViewStates.pop_back();
+                continue;
+            }
+
+            // cameras are shared between views, so everything the workers need gets copied out here
+            if (view.camera != nullptr) {
+                view.camera->setViewport(state.rect[2], state.rect[3]);
+                state.camera = render::MakeCameraConstants(view.camera->getView(), view.camera->getProjectionMatrix());
+                state.frustum = view.camera->getFrustum();
             }
-            render::End3D();
         }
 
-        for (auto& actor : mActors) {
-            if (actor->isActive()) actor->renderPass(RenderableComponent::Layer::World2D);
+        // small chunks balance better, big ones mean fewer lists to submit
+        constexpr size_t ActorsPerItem = 256;
+        constexpr RenderableComponent::Layer Layers[] = {
+            RenderableComponent::Layer::World3D,
+            RenderableComponent::Layer::World2D,
+            RenderableComponent::Layer::UI,
+        };
+
+        mRenderItems.clear();
+        for (size_t i = 0; i < mViewStates.size(); i++) {
+            const RenderView* view = mViewStates[i].view;
+
+            for (RenderableComponent::Layer layer : Layers) {
+                if ((view->layers & RenderableComponent::LayerBit(layer)) == 0) continue;
+                if (layer == RenderableComponent::Layer::World3D && view->camera == nullptr) continue;
+
+                for (size_t begin = 0; begin < mActors.size(); begin += ActorsPerItem) {
+                    mRenderItems.push_back({ static_cast<uint32_t>(i), layer, begin, std::min(begin + ActorsPerItem, mActors.size()), 0 });
+                }
+            }
+        }
+
+        auto drawItem = [this](RenderItem& item) {
+            const Frustum* frustum = item.layer == RenderableComponent::Layer::World3D ? &mViewStates[item.view].frustum : nullptr;
+            uint32_t layerBit = RenderableComponent::LayerBit(item.layer);
+
+            for (size_t i = item.begin; i < item.end; i++) {
+                Actor* actor = mActors[i];
+                if (actor->isActive() && (actor->mRenderLayers & layerBit) != 0) item.culled += actor->renderPass(item.layer, frustum);
+            }
+        };
+
+        // without workers recording would only add a copy, so everything draws straight from the submit loop below instead
+        bool record = jobs::GetWorkerCount() > 0 && !jobs::IsWorkerThread() && mRenderItems.size() > 1;
+
+        if (record) {
+            SCORPION_PROFILE_SCOPE("Scene::record");
+
+            while (mRenderLists.size() < mRenderItems.size()) {
+                mRenderLists.push_back(MakeUnique<render::CommandList>());
+            }
+
+            jobs::ParallelFor(mRenderItems.size(), 1, [this, &drawItem](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    render::CommandList& list = *mRenderLists[i];
+                    list.clear();
+
+                    list.begin(mViewStates[mRenderItems[i].view].camera);
+                    drawItem(mRenderItems[i]);
+                    list.end();
+                }
+            });
         }
 
-        for (auto& actor : mActors) {
-            if (actor->isActive()) actor->renderPass(RenderableComponent::Layer::UI);
+        size_t culled = 0;
+
+        render::BeginDrawing();
+
+        // items are grouped by view and then by layer, in the order they have to draw in
+        size_t item = 0;
+        for (size_t i = 0; i < mViewStates.size(); i++) {
+            const ViewState& state = mViewStates[i];
+            const RenderView* view = state.view;
+
+            if (!implicitView) render::BeginView(view->target.get(), state.rect[0], state.rect[1], state.rect[2], state.rect[3]);
+            if (view->clear) render::ClearWindow();
+
+            for (; item < mRenderItems.size() && mRenderItems[item].view == i; ) {
+                RenderableComponent::Layer layer = mRenderItems[item].layer;
+                bool pass3D = layer == RenderableComponent::Layer::World3D;
+
+                if (pass3D) render::Begin3D(state.camera.view, state.camera.projection);
+
+                for (; item < mRenderItems.size() && mRenderItems[item].view == i && mRenderItems[item].layer == layer; item++) {
+                    if (record) {
+                        mRenderLists[item]->submit();
+                    } else {
+                        drawItem(mRenderItems[item]);
+                    }
+
+                    culled += mRenderItems[item].culled;
+                }
+
+                if (pass3D) render::End3D();
+                else render::FlushSprites(); // so they end up under the next layer
+            }
+
+            if (!implicitView) render::EndView();
         }
 
         render::EndDrawing();
+
+        stats::Add(stats::Stat::RenderablesCulled, culled);
+
+        flushDestroyQueue();
+
+        mIterating = false;
     }
 
     bool Scene::removeActor(Actor* actor) {
-        for (size_t i = 0; i < mActors.size(); i++) {
-            if (mActors[i].get() == actor) {
-                mActors[i]->onDestroy();
-                mActors[i] = std::move(mActors.back());
-                mActors.pop_back();
-                return true;
+        if (actor == nullptr || actor->mScene != this) return false;
+        if (actor->mIndex >= mActors.size() || mActors[actor->mIndex] != actor) return false;
+
+        if (mIterating) {
+            if (actor->mDestroyQueued) return false;
+
+            actor->mDestroyQueued = true;
+            mDestroyQueue.push_back(actor);
+            return true;
+        }
+
+        actor->onDestroy();
+        eraseActor(actor);
+
+        return true;
+    }
+
+    void Scene::reserveActors(size_t count) {
+        mActors.reserve(mActors.size() + count);
+        getObjectPool(sizeof(Actor))->reserve(count);
+    }
+
+    memory::Pool* Scene::getObjectPool(size_t size) {
+        size = (size + 15) & ~static_cast<size_t>(15);
+
+        UniquePtr<memory::Pool>& pool = mPools[size];
+        if (pool == nullptr) {
+            size_t blocksPerChunk = 16384 / size;
+            if (blocksPerChunk < 16) blocksPerChunk = 16;
+
+            pool = MakeUnique<memory::Pool>(size, blocksPerChunk);
+        }
+
+        return pool.get();
+    }
+
+    Query* Scene::getQuery(const ComponentSignature& signature) {
+        UniquePtr<Query>& query = mQueryLookup[signature];
+        if (query == nullptr) {
+            query = MakeUnique<Query>(signature);
+
+            for (Actor* actor : mActors) {
+                if (query->matches(actor->mSignature)) query->add(actor);
             }
+
+            mQueries.push_back(query.get());
         }
 
-        return false;
+        return query.get();
+    }
+
+    SpatialIndex& Scene::getSpatialIndex() {
+        if (mSpatialIndex == nullptr) {
+            mSpatialIndex = MakeUnique<SpatialIndex>();
+
+            for (Actor* actor : mActors) {
+                if (auto* transform = actor->getComponent<components::Transform>()) mSpatialIndex->createLeaf(transform);
+            }
+
+            mSpatialIndex->rebuild();
+        }
+
+        return *mSpatialIndex;
     }
 
     void Scene::reset() {
-        for (auto& actor : mActors) {
+        // same as ~Scene, onDestroy removing actors only queues them so mActors stays put. Actors added in there are new and left alone
+        mIterating = true;
+
+        size_t count = mActors.size();
+        for (size_t i = 0; i < count; i++) {
+            Actor* actor = mActors[i];
+
             actor->onDestroy();
             actor->mStarted = false;
+
+            unlistActor(actor);
+            if (actor->mActive) queueStart(actor);
+        }
+
+        flushDestroyQueue();
+
+        mIterating = false;
+    }
+
+    void Scene::clear() {
+        // onDestroy can remove other actors too, so always take whatever is last right now
+        while (!mActors.empty()) {
+            Actor* actor = mActors.back();
+            actor->onDestroy();
+            eraseActor(actor);
+        }
+
+        mDestroyQueue.clear();
+    }
+
+    void Scene::registerActor(Actor* actor, memory::Pool* pool) {
+        actor->mPool = pool;
+        actor->mIndex = mActors.size();
+
+        if (!mFreeIds.empty()) {
+            actor->mId = mFreeIds.back();
+            mFreeIds.pop_back();
+        } else {
+            actor->mId = mNextId++;
+        }
+
+        mActors.push_back(actor);
+
+        queueStart(actor);
+    }
+
+    void Scene::updateQueries(Actor* actor, const ComponentSignature& previous) {
+        for (Query* query : mQueries) {
+            bool was = query->matches(previous);
+            bool is = query->matches(actor->mSignature);
+
+            if (was && !is) query->remove(actor);
+            else if (!was && is) query->add(actor);
+        }
+
+        if (mSpatialIndex != nullptr) {
+            ComponentTypeId id = GetComponentTypeId<components::Transform>();
+            bool was = previous.test(id);
+            bool is = actor->mSignature.test(id);
+
+            if (was != is) {
+                auto* transform = static_cast<components::Transform*>(actor->getComponent(id));
+
+                if (is) mSpatialIndex->add(transform);
+                else mSpatialIndex->remove(transform);
+            }
+        }
+    }
+
+    void Scene::queueStart(Actor* actor) {
+        if (actor->mStartQueued) return;
+
+        actor->mStartQueued = true;
+        actor->mStartIndex = mStartQueue.size();
+        mStartQueue.push_back(actor);
+    }
+
+    void Scene::queueStart(Component* component) {
+        if (component->mStartQueued) return;
+
+        component->mStartQueued = true;
+        component->mStartIndex = mComponentStartQueue.size();
+        mComponentStartQueue.push_back(component);
+    }
+
+    // these leave a hole instead of erasing since the queue might be getting drained right now
+
+    void Scene::dequeueStart(Actor* actor) {
+        if (!actor->mStartQueued) return;
+
+        actor->mStartQueued = false;
+        mStartQueue[actor->mStartIndex] = nullptr;
+    }
+
+    void Scene::dequeueStart(Component* component) {
+        if (!component->mStartQueued) return;
+
+        component->mStartQueued = false;
+        mComponentStartQueue[component->mStartIndex] = nullptr;
+    }
+
+    void Scene::startQueued() {
+        SCORPION_PROFILE_SCOPE("Scene::startQueued");
+
+        size_t nextActor = 0;
+        size_t nextComponent = 0;
+
+        // onStart can add and activate even more, those are started in the same go
+        while (nextActor < mStartQueue.size() || nextComponent < mComponentStartQueue.size()) {
+            for (; nextActor < mStartQueue.size(); nextActor++) {
+                Actor* actor = mStartQueue[nextActor];
+                if (actor == nullptr) continue;
+
+                actor->mStartQueued = false;
+
+                // inactive ones are queued again once they're activated
+                if (!actor->mActive) continue;
+
+                if (!actor->mStarted) {
+                    actor->onStart();
+                    actor->mStarted = true;
+                }
+
+                if (!actor->mActive) continue; // onStart deactivated it
+
+                listActor(actor);
+
+                // components that were added or activated while the actor was inactive got dropped from the queue
+                for (Component* component : actor->mComponents) {
+                    if (component != nullptr && component->mActive && !component->mListed) queueStart(component);
+                }
+            }
+
+            // only up to what's queued now, ones that have to wait for their owner go to the back for the next round
+            size_t componentEnd = mComponentStartQueue.size();
+
+            for (; nextComponent < componentEnd; nextComponent++) {
+                Component* component = mComponentStartQueue[nextComponent];
+                if (component == nullptr) continue;
+
+                Actor* owner = component->mOwner;
+
+                // the owner was only just queued by another onStart, it has to go first
+                if (owner->mStartQueued) {
+                    mComponentStartQueue[nextComponent] = nullptr;
+                    component->mStartIndex = mComponentStartQueue.size();
+                    mComponentStartQueue.push_back(component);
+                    continue;
+                }
+
+                if (component->mActive && owner->mActive && owner->mStarted && !component->mStarted) {
+                    component->mStarted = true;
+                    component->onStart();
+
+                    // removing it from onStart dequeues it, which clears the slot
+                    if (mComponentStartQueue[nextComponent] == nullptr) continue;
+                }
+
+                component->mStartQueued = false;
+                if (component->mActive && owner->mActive && owner->mStarted) owner->listComponent(component);
+            }
+        }
+
+        mStartQueue.clear();
+        mComponentStartQueue.clear();
+    }
+
+    void Scene::listActor(Actor* actor) {
+        if (actor->mListed) return;
+
+        actor->mListed = true;
+        actor->mListIndex = mActiveActors.size();
+        mActiveActors.push_back(actor);
+    }
+
+    void Scene::unlistActor(Actor* actor) {
+        if (!actor->mListed) return;
+
+        // no swap and pop, the list stays in the order actors were added which is roughly the order they sit in the pools
+        actor->mListed = false;
+        mActiveActors[actor->mListIndex] = nullptr;
+        mCompactActors = true;
+    }
+
+    void Scene::compactActiveActors() {
+        if (!mCompactActors) return;
+
+        size_t count = 0;
+        for (Actor* actor : mActiveActors) {
+            if (actor == nullptr) continue;
+
+            actor->mListIndex = count;
+            mActiveActors[count++] = actor;
+        }
+
+        mActiveActors.resize(count);
+        mCompactActors = false;
+    }
+
+    bool Scene::makeLODCamera(LODCamera& camera) const {
+        if (!mLOD.enabled || mActiveCamera == nullptr) return false;
+
+        bool screenSize = mLOD.metric == LODSettings::Metric::ScreenSize;
+
+        camera.position = mActiveCamera->getPosition();
+        camera.screenSize = screenSize;
+        camera.orthographic = screenSize && mActiveCamera->getProjection() == components::Camera::Projection::Orthographic;
+
+        // everything gets compared squared so there's no square root per actor
+        for (uint32_t i = 0; i < LODCount - 1; i++) {
+            float threshold = screenSize ? mLOD.screenSizes[i] : mLOD.distances[i];
+            camera.thresholds[i] = threshold * threshold;
+        }
+
+        if (!screenSize) {
+            camera.sizeScale = 0.0f;
+        } else if (camera.orthographic) {
+            camera.sizeScale = 1.0f / std::max(mActiveCamera->getFovY(), 1e-6f); // fovY is the view's height in world units there
+        } else {
+            camera.sizeScale = 0.5f / std::max(std::tan(mActiveCamera->getFovY() * 0.5f * (3.14159265f / 180.0f)), 1e-6f);
+        }
+
+        return true;
+    }
+
+    uint8_t Scene::computeLOD(const Actor* actor, const LODCamera& camera) const {
+        static const ComponentTypeId transformId = GetComponentTypeId<components::Transform>();
+
+        auto* transform = static_cast<const components::Transform*>(actor->getComponent(transformId));
+        if (transform == nullptr) return 0;
+
+        math::Vec3 offset = transform->getPosition() - camera.position;
+        float distanceSquared = offset.lengthSquared();
+
+        uint8_t lod = 0;
+
+        if (!camera.screenSize) {
+            while (lod < LODCount - 1 && distanceSquared >= camera.thresholds[lod]) lod++;
+        } else {
+            // the box's diagonal stands in for its height, it doesn't change as the actor turns
+            math::Vec3 size = transform->getSize();
+            float extentSquared = size.lengthSquared() * camera.sizeScale * camera.sizeScale;
+            float depthSquared = camera.orthographic ? 1.0f : distanceSquared;
+
+            while (lod < LODCount - 1 && extentSquared < camera.thresholds[lod] * depthSquared) lod++;
         }
+
+        return lod;
+    }
+
+    void Scene::flushDestroyQueue() {
+        // onDestroy, and the components' onDestroy in ~Actor, can queue even more actors. Those land in the emptied queue and get
+        // their own go
+        while (!mDestroyQueue.empty()) {
+            mDestroying.swap(mDestroyQueue);
+
+            for (size_t i = 0; i < mDestroying.size(); i++) {
+                mDestroying[i]->onDestroy();
+            }
+
+            for (size_t i = 0; i < mDestroying.size(); i++) {
+                eraseActor(mDestroying[i]);
+            }
+
+            mDestroying.clear();
+        }
+    }
+
+    void Scene::eraseActor(Actor* actor) {
+        size_t index = actor->mIndex;
+
+        Actor* last = mActors.back();
+        mActors[index] = last;
+        last->mIndex = index;
+        mActors.pop_back();
+
+        if (mActiveCamera != nullptr && mActiveCamera->getOwner() == actor) mActiveCamera = nullptr;
+
+        for (RenderView& view : mViews) {
+            if (view.camera != nullptr && view.camera->getOwner() == actor) view.camera = nullptr;
+        }
+
+        unlistActor(actor);
+        dequeueStart(actor);
+
+        for (Component* component : actor->mComponents) {
+            if (component != nullptr) dequeueStart(component);
+        }
+
+        for (Query* query : mQueries) {
+            if (query->matches(actor->mSignature)) query->remove(actor);
+        }
+
+        if (mSpatialIndex != nullptr) {
+            if (auto* transform = actor->getComponent<components::Transform>()) mSpatialIndex->remove(transform);
+        }
+
+        mFreeIds.push_back(actor->mId);
+
+        memory::Pool* pool = actor->mPool;
+        void* memory = dynamic_cast<void*>(actor);
+
+        actor->~Actor();
+        pool->free(memory);
     }
 }
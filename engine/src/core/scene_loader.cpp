@@ -0,0 +1,231 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/scene_loader.h"
+#include "scorpion/core/scorpion.h"
+
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+namespace scorpion {
+    // the builder gets the first 90%, dependencies and main thread tasks share the rest
+    static constexpr float BuildShare = 0.9f;
+
+    SceneLoad::SceneLoad(uint32_t id, Builder builder, bool activate)
+        : mId(id)
+        , mBuilder(std::move(builder))
+        , mActivate(activate) {}
+
+    SceneLoad::Status SceneLoad::getStatus() const {
+        return mStatus.load(std::memory_order_acquire);
+    }
+
+    bool SceneLoad::isDone() const {
+        Status status = getStatus();
+        return status == Status::Done || status == Status::Failed;
+    }
+
+    float SceneLoad::getProgress() const {
+        return mProgress.load(std::memory_order_relaxed);
+    }
+
+    void SceneLoad::setProgress(float progress) {
+        if (getStatus() != Status::Building) return;
+        mProgress.store(std::clamp(progress, 0.0f, 1.0f) * BuildShare, std::memory_order_relaxed);
+    }
+
+    void SceneLoad::waitFor(SharedPtr<render::ShaderRequest> request) {
+        if (request == nullptr) return;
+
+        std::lock_guard lock(mMutex);
+        mShaders.push_back(std::move(request));
+        mDependencies++;
+    }
+
+    void SceneLoad::waitFor(assets::AssetHandle handle) {
+        if (!handle.isValid()) return;
+
+        std::lock_guard lock(mMutex);
+        mAssets.push_back(std::move(handle));
+        mDependencies++;
+    }
+
+    void SceneLoad::onMainThread(Task task) {
+        std::lock_guard lock(mMutex);
+        mTasks.push_back(std::move(task));
+    }
+
+    void SceneLoad::build() {
+        SCORPION_PROFILE_SCOPE("SceneLoad::build");
+
+        // the scene has its own pools, so filling it up here never touches anything the running game allocates from
+        mScene = MakeUnique<Scene>();
+
+        bool built = mBuilder(mScene.get(), *this);
+        mBuilder = nullptr;
+
+        mProgress.store(BuildShare, std::memory_order_relaxed);
+        mStatus.store(built ? Status::Finishing : Status::Failed, std::memory_order_release);
+    }
+
+    bool SceneLoad::pump(double budgetSeconds) {
+        Status status = getStatus();
+        if (status == Status::Building) return false;
+        if (status != Status::Finishing) return true;
+
+        SCORPION_PROFILE_SCOPE("SceneLoad::pump");
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::unique_lock lock(mMutex);
+
+        // a task can queue more tasks, so it's moved out and run without the lock
+        while (mNextTask < mTasks.size()) {
+            Task task = std::move(mTasks[mNextTask++]);
+
+            lock.unlock();
+            task(mScene.get());
+            lock.lock();
+
+            if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= budgetSeconds) break;
+        }
+
+        // a failed shader is done as far as loading goes, it's the user's problem once the scene runs
+        size_t ready = 0;
+        for (const SharedPtr<render::ShaderRequest>& request : mShaders) {
+            if (request->isDone()) ready++;
+        }
+
+        for (const assets::AssetHandle& handle : mAssets) {
+            if (handle.isReady()) ready++;
+        }
+
+        size_t total = mDependencies + mTasks.size();
+        float finished = total > 0 ? static_cast<float>(ready + mNextTask) / static_cast<float>(total) : 1.0f;
+        mProgress.store(BuildShare + (1.0f - BuildShare) * finished, std::memory_order_relaxed);
+
+        if (mNextTask < mTasks.size() || ready < mDependencies) return false;
+
+        mShaders.clear();
+        mAssets.clear();
+        mTasks.clear();
+
+        mStatus.store(Status::Done, std::memory_order_release);
+        return true;
+    }
+
+    class SceneLoader {
+    public:
+        ~SceneLoader() {
+            {
+                std::lock_guard lock(mMutex);
+                mStop = true;
+            }
+            mCondition.notify_all();
+
+            if (mThread.joinable()) mThread.join();
+        }
+
+        void submit(const SharedPtr<SceneLoad>& load) {
+            {
+                std::lock_guard lock(mMutex);
+
+                mQueue.push_back(load);
+                mLoads.push_back(load);
+
+                if (!mThread.joinable()) mThread = std::thread([this] { loaderLoop(); });
+            }
+
+            mCondition.notify_one();
+        }
+
+        void pump(double budgetSeconds) {
+            auto start = std::chrono::steady_clock::now();
+
+            // handed over strictly in the order they were queued, so two loads for the same id always end up with the later one
+            while (true) {
+                SharedPtr<SceneLoad> load;
+                {
+                    std::lock_guard lock(mMutex);
+                    if (mLoads.empty()) return;
+
+                    load = mLoads.front();
+                }
+
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                if (!load->pump(std::max(budgetSeconds - elapsed, 0.0))) return;
+
+                {
+                    std::lock_guard lock(mMutex);
+                    mLoads.erase(mLoads.begin());
+                }
+
+                if (load->getStatus() == SceneLoad::Status::Done) {
+                    AddScene(load->mId, std::move(load->mScene));
+                    if (load->mActivate) SetActiveScene(load->mId);
+                } else {
+                    // dropped here rather than on the loader thread in case the builder got as far as making gpu resources
+                    load->mScene = nullptr;
+                }
+            }
+        }
+
+        size_t getPending() {
+            std::lock_guard lock(mMutex);
+            return mLoads.size();
+        }
+
+    private:
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+
+        Vector<SharedPtr<SceneLoad>> mQueue; // not built yet
+        Vector<SharedPtr<SceneLoad>> mLoads; // not handed over yet, including the ones in mQueue
+
+        std::thread mThread;
+        bool mStop = false;
+
+        void loaderLoop() {
+#ifdef SCORPION_PROFILER
+            profiler::SetThreadName("Scene Loader");
+#endif
+
+            std::unique_lock lock(mMutex);
+
+            while (true) {
+                mCondition.wait(lock, [this] { return mStop || !mQueue.empty(); });
+                if (mStop) break;
+
+                SharedPtr<SceneLoad> load = mQueue.front();
+                mQueue.erase(mQueue.begin());
+
+                lock.unlock();
+                load->build();
+                lock.lock();
+            }
+        }
+    };
+
+    static SceneLoader& GetSceneLoader() {
+        static SceneLoader loader;
+        return loader;
+    }
+
+    SharedPtr<SceneLoad> LoadSceneAsync(uint32_t id, SceneLoad::Builder builder, bool activate) {
+        SharedPtr<SceneLoad> load = MakeShared<SceneLoad>(id, std::move(builder), activate);
+        GetSceneLoader().submit(load);
+
+        return load;
+    }
+
+    void PumpSceneLoads(double budgetSeconds) {
+        GetSceneLoader().pump(budgetSeconds);
+    }
+
+    size_t GetPendingSceneLoads() {
+        return GetSceneLoader().getPending();
+    }
+}
@@ -2,19 +2,44 @@
 
 #include "scorpion/core/scorpion.h"
 
+#include "scorpion/foundation/jobs/job_system.h"
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include "scorpion/hal/input.h"
+#include "scorpion/hal/renderer.h"
+#include "scorpion/hal/shader_cache.h"
+
 #include "scorpion/util/timer.h"
 
-#include <raylib.h>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
 
 namespace scorpion {
+    // outside EngineCore so signal handlers only ever touch a lock-free atomic
+    static std::atomic<bool> stopRequested = false;
+
+    // Background scenes don't get their own wakeups, they tick on whatever update or render woke the loop and catch up in fixed steps.
+    // One that fell further behind than this drops the backlog instead of trying to catch up and falling even further behind
+    static constexpr int MaxCatchUpTicks = 4;
+
     struct EngineCore {
+        using Clock = std::chrono::high_resolution_clock;
+
         Timer<> updateTimer;
         Timer<> renderTimer;
 
         HashMap<uint32_t, UniquePtr<Scene>> scenes;
         Scene* activeScene = nullptr;
 
-        Vector<std::function<void(UpdateHookHandle&)>> updateHooks;
+        HookScheduler hooks;
+
+        // background ticks run while the active scene ticks and renders, and get joined before the loop goes back to sleep
+        Vector<Scene*> dueScenes;
+        jobs::AsyncFor backgroundTicks;
+
+        uint64_t tickBudget = 0;
+        uint64_t ticks = 0;
 
         void setTargetFPS(int fps) {
             renderTimer.reset(1.0 / fps);
@@ -25,24 +50,38 @@ namespace scorpion {
         }
 
         Scene* createScene(uint32_t id) {
-            UniquePtr<Scene> scene = MakeUnique<Scene>();
+            return addScene(id, MakeUnique<Scene>());
+        }
+
+        Scene* addScene(uint32_t id, UniquePtr<Scene> scene) {
+            joinBackground(); // might be replacing a scene that's ticking right now
+
             Scene* ptr = scene.get();
 
-            scenes[id] = std::move(scene);
+            UniquePtr<Scene>& slot = scenes[id];
+            if (slot != nullptr && slot.get() == activeScene) activeScene = ptr;
+
+            slot = std::move(scene);
 
             return ptr;
         }
 
         void setActiveScene(uint32_t id) {
+            joinBackground();
             activeScene = scenes.at(id).get();
         }
 
-        void addUpdateHook(std::function<void(UpdateHookHandle&)> hook) {
-            updateHooks.push_back(std::move(hook));
+        void addHook(HookPhase phase, UpdateHook hook, int priority, bool threadSafe) {
+            hooks.add(phase, std::move(hook), priority, threadSafe);
         }
 
         bool shouldRun() {
-            return !WindowShouldClose();
+            joinBackground();
+
+            if (stopRequested.load(std::memory_order_relaxed)) return false;
+            if (tickBudget != 0 && ticks >= tickBudget) return false;
+
+            return !render::WindowShouldClose();
         }
 
         void tickTimers() {
@@ -51,45 +90,161 @@ namespace scorpion {
         }
 
         void waitForUpdateOrRender() {
+            SCORPION_PROFILE_SCOPE("EngineCore::waitForUpdateOrRender");
+
+            joinBackground();
+
             if (updateTimer.getTarget() == 0.0 && renderTimer.getTarget() == 0.0) return;
 
             auto now = updateTimer.getCurrentTime();
             auto nextUpdate = updateTimer.getTarget() > 0.0 ? updateTimer.nextDue() : now;
             auto nextRender = renderTimer.getTarget() > 0.0 ? renderTimer.nextDue() : now;
 
-            if (nextUpdate < nextRender) {
-                updateTimer.wait();
+            auto start = std::chrono::steady_clock::now();
+
+            // waking up to poll input in between means events get stamped within a slice of when they happened, not a whole frame later
+            int pollRate = input::GetPollRate();
+
+            double requested;
+            if (pollRate <= 0 || render::IsHeadless()) {
+                requested = nextUpdate < nextRender ? updateTimer.wait() : renderTimer.wait();
+            } else if (nextUpdate < nextRender) {
+                requested = updateTimer.wait(1.0 / pollRate, input::Poll);
             } else {
-                renderTimer.wait();
+                requested = renderTimer.wait(1.0 / pollRate, input::Poll);
             }
+
+            double slept = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            stats::AddTime(stats::Stat::TimerWait, slept);
+            if (requested > 0.0) stats::AddTime(stats::Stat::TimerOvershoot, slept - requested);
         }
 
         void update() {
+            SCORPION_PROFILE_SCOPE("EngineCore::update");
+
+            joinBackground();
+
             auto tick = [this](double dt) {
-                for (auto it = updateHooks.begin(); it != updateHooks.end();) {
-                    UpdateHookHandle handle;
-                    (*it)(handle);
-
-                    if (handle.mUnregistered) {
-                        it = updateHooks.erase(it);
-                    } else {
-                        ++it;
-                    }
-                }
+                auto start = std::chrono::steady_clock::now();
+
+                // between ticks is the only place a scene can be swapped without anything seeing it half updated
+                PumpSceneLoads(0.002);
+
+                // after the swap, so the background ticks never see a scene go away under them
+                startBackground();
+
+                input::BeginTick();
+
+                hooks.run(HookPhase::PreUpdate);
 
                 if (activeScene != nullptr) activeScene->update(dt);
+
+                hooks.run(HookPhase::PostUpdate);
+
+                stats::AddTime(stats::Stat::UpdateTime, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                stats::Add(stats::Stat::TicksPerFrame);
+                ticks++;
             };
 
             if (updateTimer.getTarget() == 0.0) {
                 tick(updateTimer.getDelta());
             } else if (updateTimer.getCurrentTime() >= updateTimer.nextDue()) {
                 tick(updateTimer.getTarget());
+            } else {
+                startBackground(); // background scenes run at their own rates, not only when the active one ticks
             }
         }
 
+        double getTickInterval(const Scene* scene) const {
+            return scene->mTickRate > 0 ? 1.0 / scene->mTickRate : updateTimer.getTarget();
+        }
+
+        bool isBackground(const Scene* scene) const {
+            return scene->mBackground && scene != activeScene;
+        }
+
+        void startBackground() {
+            auto now = Clock::now();
+
+            dueScenes.clear();
+            for (const auto& [id, scene] : scenes) {
+                if (isBackground(scene.get()) && now >= scene->mNextTick) dueScenes.push_back(scene.get());
+            }
+
+            if (dueScenes.empty()) return;
+
+            // longest first, the workers grab scenes in order so the big ones start right away and the small ones fill in the gaps at the end
+            std::sort(dueScenes.begin(), dueScenes.end(), [](const Scene* a, const Scene* b) {
+                return a->mLastTickCost > b->mLastTickCost;
+            });
+
+            backgroundTicks.start(dueScenes.size(), 1, [this, now](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    tickBackground(dueScenes[i], now);
+                }
+            });
+        }
+
+        // Whatever the workers didn't get to yet runs here, on the main thread. Without workers that's all of it, but it still stays out of
+        // the active scene's frame since this only happens once the loop is done with it
+        void joinBackground() {
+            if (!backgroundTicks.isRunning()) return;
+
+            SCORPION_PROFILE_SCOPE("EngineCore::joinBackground");
+            backgroundTicks.wait();
+        }
+
+        // runs on a job worker alongside the active scene's tick and render, so nothing in here may touch anything but the scene itself
+        void tickBackground(Scene* scene, Clock::time_point now) {
+            SCORPION_PROFILE_SCOPE("EngineCore::tickBackground");
+
+            auto start = Clock::now();
+            double interval = getTickInterval(scene);
+
+            scene->mBackgroundTick = true;
+
+            if (interval <= 0.0) {
+                double dt = scene->mLastTick != Clock::time_point() ? std::chrono::duration<double>(now - scene->mLastTick).count() : 0.0;
+                scene->update(dt);
+                stats::Add(stats::Stat::BackgroundTicks);
+            } else {
+                auto step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval));
+                if (scene->mNextTick == Clock::time_point()) scene->mNextTick = now;
+
+                for (int i = 0; i < MaxCatchUpTicks && now >= scene->mNextTick; i++) {
+                    scene->update(interval);
+                    scene->mNextTick += step;
+                    stats::Add(stats::Stat::BackgroundTicks);
+                }
+
+                if (now >= scene->mNextTick) scene->mNextTick = now + step;
+            }
+
+            scene->mBackgroundTick = false;
+
+            scene->mLastTick = now;
+            scene->mLastTickCost = std::chrono::duration<double>(Clock::now() - start).count();
+
+            stats::AddTime(stats::Stat::BackgroundTime, scene->mLastTickCost);
+        }
+
         void render() {
+            SCORPION_PROFILE_SCOPE("EngineCore::render");
+
             auto tick = [this] {
+                auto start = std::chrono::steady_clock::now();
+
+                // 2ms of compiling per frame keeps hitches down while shaders stream in
+                render::PumpShaderCompiles(0.002);
+
+                hooks.run(HookPhase::PreRender);
+
                 if (activeScene != nullptr) activeScene->render();
+
+                hooks.run(HookPhase::PostRender);
+
+                stats::AddTime(stats::Stat::RenderTime, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                stats::EndFrame();
             };
 
             // each, i know this can be turned into a or, but we tryna match with update()
@@ -103,11 +258,11 @@ namespace scorpion {
 
     static EngineCore core;
 
-    void UpdateHookHandle::unregister() {
-        mUnregistered = true;
-    }
-
     void Run() {
+#ifdef SCORPION_PROFILER
+        profiler::SetThreadName("Main");
+#endif
+
         while (ShouldRun()) {
             TickTimers();
             WaitForUpdateOrRender();
@@ -128,6 +283,10 @@ namespace scorpion {
         return core.createScene(id);
     }
 
+    Scene* AddScene(uint32_t id, UniquePtr<Scene> scene) {
+        return core.addScene(id, std::move(scene));
+    }
+
     Scene* GetActiveScene() {
         return core.activeScene;
     }
@@ -144,8 +303,30 @@ namespace scorpion {
         actor->getScene()->removeActor(actor);
     }
 
-    void AddUpdateHook(std::function<void(UpdateHookHandle&)> hook) {
-        core.addUpdateHook(std::move(hook));
+    void AddUpdateHook(UpdateHook hook) {
+        core.addHook(HookPhase::PreUpdate, std::move(hook), 0, false);
+    }
+
+    void AddHook(HookPhase phase, UpdateHook hook, int priority, bool threadSafe) {
+        core.addHook(phase, std::move(hook), priority, threadSafe);
+    }
+
+    void SetTickBudget(uint64_t ticks) {
+        core.tickBudget = ticks;
+        core.ticks = 0;
+    }
+
+    void RequestStop() {
+        stopRequested.store(true, std::memory_order_relaxed);
+    }
+
+    static void StopSignalHandler(int) {
+        RequestStop();
+    }
+
+    void InstallStopSignalHandlers() {
+        std::signal(SIGINT, StopSignalHandler);
+        std::signal(SIGTERM, StopSignalHandler);
     }
 
     bool ShouldRun() {
@@ -0,0 +1,433 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/scene.h"
+#include "scorpion/core/serialization.h"
+
+#include "scorpion/engine_std/camera.h"
+#include "scorpion/engine_std/cube_renderer.h"
+#include "scorpion/engine_std/physics_body.h"
+#include "scorpion/engine_std/transform.h"
+
+#include "scorpion/foundation/io/file.h"
+#include "scorpion/foundation/io/mapped_file.h"
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include <mutex>
+
+namespace scorpion {
+    // Snapshot layout, everything little endian:
+    //   SnapshotHeader | ActorRecord[actorCount] | uint32 free id[freeIdCount] | sections
+    // and every section is
+    //   SectionHeader | name | uint32 actor index[count] | uint8 active[count] | state[count]
+    // with every part padded to 8 bytes. States are stored back to back per type so saving and loading them is a straight copy
+
+    static constexpr uint32_t SnapshotMagic = 0x4E534353; // "SCSN"
+    static constexpr uint32_t SnapshotVersion = 2;
+    static constexpr uint32_t NoActor = 0xFFFFFFFF;
+
+    struct SnapshotHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t actorCount;
+        uint32_t sectionCount;
+        uint32_t nextId;
+        uint32_t cameraActor; // index of the actor with the active camera or NoActor
+        uint32_t freeIdCount; // actorCount + freeIdCount is always nextId
+        uint32_t reserved;
+        uint64_t size;
+    };
+
+    struct ActorRecord {
+        uint32_t id;
+        uint32_t active;
+    };
+
+    struct SectionHeader {
+        uint32_t nameSize; // including the nul
+        uint32_t stateSize;
+        uint32_t count;
+        uint32_t reserved;
+    };
+
+    static std::mutex serializerMutex;
+    static ComponentSerializer serializers[MaxComponentTypes];
+
+    // the engine's own components are always there, done lazily so nobody has to remember to call anything
+    static void RegisterStdSerializers() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            RegisterComponentSerializer<components::Transform>("Transform");
+            RegisterComponentSerializer<components::PhysicsBody>("PhysicsBody");
+            RegisterComponentSerializer<components::Camera>("Camera");
+            RegisterComponentSerializer<components::CubeRenderer>("CubeRenderer");
+        });
+    }
+
+    // one lock for the whole table instead of one per lookup
+    static void CopySerializers(const ComponentSerializer** out) {
+        RegisterStdSerializers();
+
+        std::lock_guard lock(serializerMutex);
+        for (ComponentTypeId id = 0; id < MaxComponentTypes; id++) {
+            out[id] = serializers[id].name != nullptr ? &serializers[id] : nullptr;
+        }
+    }
+
+    void RegisterComponentSerializer(ComponentTypeId id, const ComponentSerializer& serializer) {
+        if (id >= MaxComponentTypes) return;
+
+        std::lock_guard lock(serializerMutex);
+        serializers[id] = serializer;
+    }
+
+    const ComponentSerializer* GetComponentSerializer(ComponentTypeId id) {
+        RegisterStdSerializers();
+
+        std::lock_guard lock(serializerMutex);
+        return id < MaxComponentTypes && serializers[id].name != nullptr ? &serializers[id] : nullptr;
+    }
+
+    const ComponentSerializer* FindComponentSerializer(const char* name, ComponentTypeId* id) {
+        RegisterStdSerializers();
+
+        std::lock_guard lock(serializerMutex);
+        for (ComponentTypeId i = 0; i < MaxComponentTypes; i++) {
+            if (serializers[i].name != nullptr && strcmp(serializers[i].name, name) == 0) {
+                if (id != nullptr) *id = i;
+                return &serializers[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool SceneSnapshot::assign(const uint8_t* data, size_t size) {
+        SnapshotHeader header;
+        if (size < sizeof(header)) return false;
+
+        memcpy(&header, data, sizeof(header));
+        if (header.magic != SnapshotMagic || header.version != SnapshotVersion || header.size != size) return false;
+
+        mData.assign(data, data + size);
+        return true;
+    }
+
+    void Scene::snapshot(SceneSnapshot& snapshot) const {
+        SCORPION_PROFILE_SCOPE("Scene::snapshot");
+
+        const ComponentSerializer* types[MaxComponentTypes];
+        CopySerializers(types);
+
+        Vector<Vector<Component*>>& gather = snapshot.mGather;
+        if (gather.size() < MaxComponentTypes) gather.resize(MaxComponentTypes);
+        for (Vector<Component*>& components : gather) components.clear();
+
+        for (Actor* actor : mActors) {
+            for (ComponentTypeId id = 0; id < actor->mComponents.size(); id++) {
+                Component* component = actor->mComponents[id];
+                if (component != nullptr && types[id] != nullptr) gather[id].push_back(component);
+            }
+        }
+
+        size_t size = io::Pad(sizeof(SnapshotHeader)) + io::Pad(mActors.size() * sizeof(ActorRecord)) + io::Pad(mFreeIds.size() * sizeof(uint32_t));
+        uint32_t sectionCount = 0;
+
+        for (ComponentTypeId id = 0; id < MaxComponentTypes; id++) {
+            size_t count = gather[id].size();
+            if (count == 0) continue;
+
+            size += io::Pad(sizeof(SectionHeader)) + io::Pad(strlen(types[id]->name) + 1) + io::Pad(count * sizeof(uint32_t)) + io::Pad(count) + io::Pad(count * types[id]->stateSize);
+            sectionCount++;
+        }
+
+        // only grows, so snapshotting into the same buffer every frame never touches the allocator
+        Vector<uint8_t>& data = snapshot.mData;
+        data.resize(size);
+
+        uint8_t* out = data.data();
+        size_t offset = 0;
+
+        // hands out the next part of the buffer with its padding already zeroed. Together with states that zero their own padding,
+        // identical scenes give identical bytes
+        auto reserve = [&](size_t bytes) {
+            uint8_t* at = out + offset;
+            memset(at + bytes, 0, io::Pad(bytes) - bytes);
+            offset += io::Pad(bytes);
+            return at;
+        };
+
+        auto put = [&](const void* source, size_t bytes) {
+            memcpy(reserve(bytes), source, bytes);
+        };
+
+        SnapshotHeader header = {};
+        header.magic = SnapshotMagic;
+        header.version = SnapshotVersion;
+        header.actorCount = static_cast<uint32_t>(mActors.size());
+        header.sectionCount = sectionCount;
+        header.nextId = mNextId;
+        header.cameraActor = mActiveCamera != nullptr ? static_cast<uint32_t>(mActiveCamera->getOwner()->mIndex) : NoActor;
+        header.freeIdCount = static_cast<uint32_t>(mFreeIds.size());
+        header.size = size;
+        put(&header, sizeof(header));
+
+        uint8_t* actors = reserve(mActors.size() * sizeof(ActorRecord));
+        for (size_t i = 0; i < mActors.size(); i++) {
+            ActorRecord record = { mActors[i]->mId, mActors[i]->mActive ? 1u : 0u };
+            memcpy(actors + i * sizeof(ActorRecord), &record, sizeof(record));
+        }
+
+        // in free list order, so actors added after a restore get the same ids they got the first time around
+        put(mFreeIds.data(), mFreeIds.size() * sizeof(uint32_t));
+
+        for (ComponentTypeId id = 0; id < MaxComponentTypes; id++) {
+            const Vector<Component*>& components = gather[id];
+            size_t count = components.size();
+            if (count == 0) continue;
+
+            const ComponentSerializer* serializer = types[id];
+
+            SectionHeader section = {};
+            section.nameSize = static_cast<uint32_t>(strlen(serializer->name) + 1);
+            section.stateSize = serializer->stateSize;
+            section.count = static_cast<uint32_t>(count);
+            put(&section, sizeof(section));
+            put(serializer->name, section.nameSize);
+
+            uint8_t* indices = reserve(count * sizeof(uint32_t));
+            for (size_t i = 0; i < count; i++) {
+                auto index = static_cast<uint32_t>(components[i]->getOwner()->mIndex);
+                memcpy(indices + i * sizeof(uint32_t), &index, sizeof(index));
+            }
+
+            uint8_t* active = reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                active[i] = components[i]->isActive() ? 1 : 0;
+            }
+
+            serializer->save(components.data(), count, reserve(count * serializer->stateSize));
+        }
+    }
+
+    bool Scene::restore(const SceneSnapshot& snapshot) {
+        return restore(snapshot.getData(), snapshot.getSize());
+    }
+
+    bool Scene::restore(const uint8_t* data, size_t size) {
+        SCORPION_PROFILE_SCOPE("Scene::restore");
+
+        if (mIterating || data == nullptr) return false;
+
+        struct Section {
+            const ComponentSerializer* serializer; // null for types this build doesn't know, those are skipped
+            ComponentTypeId id;
+            uint32_t count;
+            const uint8_t* actors;
+            const uint8_t* active;
+            const uint8_t* states;
+        };
+
+        SnapshotHeader header;
+        if (size < sizeof(header)) return false;
+
+        memcpy(&header, data, sizeof(header));
+        if (header.magic != SnapshotMagic || header.version != SnapshotVersion || header.size != size) return false;
+        if (header.actorCount > (size - io::Pad(sizeof(header))) / sizeof(ActorRecord)) return false;
+        if (header.cameraActor != NoActor && header.cameraActor >= header.actorCount) return false;
+
+        // every id below nextId is either an actor's or free, and both are in the file. That keeps nextId, and everything sized by it below,
+        // bounded by the file's size
+        if (static_cast<uint64_t>(header.actorCount) + header.freeIdCount != header.nextId) return false;
+
+        const uint8_t* actors = data + io::Pad(sizeof(header));
+        size_t offset = io::Pad(sizeof(header)) + io::Pad(header.actorCount * sizeof(ActorRecord));
+
+        // everything gets checked before the scene is touched, a bad file can't leave it half restored
+        auto take = [&](size_t bytes) -> const uint8_t* {
+            if (offset > size || io::Pad(bytes) > size - offset) return nullptr;
+
+            const uint8_t* at = data + offset;
+            offset += io::Pad(bytes);
+            return at;
+        };
+
+        const uint8_t* freeIds = take(static_cast<size_t>(header.freeIdCount) * sizeof(uint32_t));
+        if (freeIds == nullptr) return false;
+
+        Vector<uint8_t> usedIds(header.nextId, 0);
+
+        for (uint32_t i = 0; i < header.actorCount; i++) {
+            ActorRecord record;
+            memcpy(&record, actors + i * sizeof(ActorRecord), sizeof(record));
+            if (record.id >= header.nextId || usedIds[record.id]) return false;
+
+            usedIds[record.id] = 1;
+        }
+
+        // with the counts adding up, no duplicates means every id shows up exactly once
+        for (uint32_t i = 0; i < header.freeIdCount; i++) {
+            uint32_t id;
+            memcpy(&id, freeIds + i * sizeof(uint32_t), sizeof(id));
+            if (id >= header.nextId || usedIds[id]) return false;
+
+            usedIds[id] = 1;
+        }
+
+        Vector<Section> sections;
+        sections.reserve(header.sectionCount);
+
+        size_t knownComponents = 0;
+
+        for (uint32_t i = 0; i < header.sectionCount; i++) {
+            SectionHeader sectionHeader;
+            const uint8_t* at = take(sizeof(sectionHeader));
+            if (at == nullptr) return false;
+            memcpy(&sectionHeader, at, sizeof(sectionHeader));
+
+            auto name = reinterpret_cast<const char*>(take(sectionHeader.nameSize));
+            if (name == nullptr || sectionHeader.nameSize == 0 || name[sectionHeader.nameSize - 1] != '\0') return false;
+
+            Section section;
+            section.count = sectionHeader.count;
+            section.actors = take(static_cast<size_t>(section.count) * sizeof(uint32_t));
+            section.active = take(section.count);
+            section.states = take(static_cast<size_t>(section.count) * sectionHeader.stateSize);
+            if (section.actors == nullptr || section.active == nullptr || section.states == nullptr) return false;
+
+            for (uint32_t j = 0; j < section.count; j++) {
+                uint32_t index;
+                memcpy(&index, section.actors + j * sizeof(uint32_t), sizeof(index));
+                if (index >= header.actorCount) return false;
+            }
+
+            // a component whose state changed size since the snapshot was made can't be loaded, it's left out rather than misread
+            section.serializer = FindComponentSerializer(name, &section.id);
+            if (section.serializer != nullptr && section.serializer->stateSize != sectionHeader.stateSize) section.serializer = nullptr;
+
+            if (section.serializer != nullptr) knownComponents += section.count;
+            sections.push_back(section);
+        }
+
+        auto actorIndex = [](const Section& section, uint32_t i) {
+            uint32_t index;
+            memcpy(&index, section.actors + i * sizeof(uint32_t), sizeof(index));
+            return index;
+        };
+
+        // rollback usually restores the exact same actors it snapshotted, in that case nothing needs to be rebuilt
+        bool inPlace = mActors.size() == header.actorCount;
+
+        for (uint32_t i = 0; inPlace && i < header.actorCount; i++) {
+            ActorRecord record;
+            memcpy(&record, actors + i * sizeof(ActorRecord), sizeof(record));
+            inPlace = mActors[i]->mId == record.id;
+        }
+
+        for (size_t s = 0; inPlace && s < sections.size(); s++) {
+            const Section& section = sections[s];
+            if (section.serializer == nullptr) continue;
+
+            for (uint32_t i = 0; inPlace && i < section.count; i++) {
+                inPlace = mActors[actorIndex(section, i)]->getComponent(section.id) != nullptr;
+            }
+        }
+
+        if (inPlace) {
+            // the actors could have picked up extra serializable components since, those would have to go
+            const ComponentSerializer* types[MaxComponentTypes];
+            CopySerializers(types);
+
+            size_t components = 0;
+            for (Actor* actor : mActors) {
+                for (ComponentTypeId id = 0; id < actor->mComponents.size(); id++) {
+                    if (actor->mComponents[id] != nullptr && types[id] != nullptr) components++;
+                }
+            }
+
+            inPlace = components == knownComponents;
+        }
+
+        if (inPlace) {
+            for (uint32_t i = 0; i < header.actorCount; i++) {
+                ActorRecord record;
+                memcpy(&record, actors + i * sizeof(ActorRecord), sizeof(record));
+                mActors[i]->setActive(record.active != 0);
+            }
+
+            for (const Section& section : sections) {
+                if (section.serializer == nullptr) continue;
+
+                mRestoreScratch.clear();
+                for (uint32_t i = 0; i < section.count; i++) {
+                    Component* component = mActors[actorIndex(section, i)]->getComponent(section.id);
+                    component->setActive(section.active[i] != 0);
+                    mRestoreScratch.push_back(component);
+                }
+
+                section.serializer->load(mRestoreScratch.data(), section.count, section.states);
+            }
+        } else {
+            clear();
+            reserveActors(header.actorCount);
+
+            // ids come back exactly as they were so anything that stored one still finds the same actor. They're fed through the free list
+            // since queries are keyed by id, patching them after the fact would leave stale entries behind
+            mFreeIds.clear();
+            for (uint32_t i = header.actorCount; i-- > 0;) {
+                ActorRecord record;
+                memcpy(&record, actors + i * sizeof(ActorRecord), sizeof(record));
+                mFreeIds.push_back(record.id);
+            }
+
+            for (uint32_t i = 0; i < header.actorCount; i++) {
+                ActorRecord record;
+                memcpy(&record, actors + i * sizeof(ActorRecord), sizeof(record));
+
+                Actor* actor = addActor<Actor>();
+                actor->setActive(record.active != 0);
+            }
+
+            for (const Section& section : sections) {
+                if (section.serializer == nullptr) continue;
+
+                for (uint32_t i = 0; i < section.count; i++) {
+                    Component* component = section.serializer->create(mActors[actorIndex(section, i)], section.states + i * section.serializer->stateSize);
+                    component->setActive(section.active[i] != 0);
+                }
+            }
+        }
+
+        mNextId = header.nextId;
+        mFreeIds.resize(header.freeIdCount);
+        memcpy(mFreeIds.data(), freeIds, header.freeIdCount * sizeof(uint32_t));
+
+        mActiveCamera = header.cameraActor != NoActor ? mActors[header.cameraActor]->getComponent<components::Camera>() : nullptr;
+
+        return true;
+    }
+
+    bool SaveScene(const Scene* scene, const char* path) {
+        if (scene == nullptr) return false;
+
+        SceneSnapshot snapshot;
+        scene->snapshot(snapshot);
+
+        return io::WriteFile(path, snapshot.getData(), snapshot.getSize());
+    }
+
+    bool LoadScene(Scene* scene, const char* path) {
+        if (scene == nullptr) return false;
+
+        io::MappedFile file;
+        if (!file.open(path)) return false;
+
+        return scene->restore(file.data(), file.size());
+    }
+
+    bool LoadScene(Scene* scene, const assets::AssetHandle& handle) {
+        if (scene == nullptr || handle.getType() != assets::AssetType::Scene) return false;
+
+        handle.wait();
+        return scene->restore(handle.getData(), handle.getSize());
+    }
+}
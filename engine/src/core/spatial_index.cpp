@@ -0,0 +1,767 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/spatial_index.h"
+#include "scorpion/core/actor.h"
+
+#include "scorpion/engine_std/transform.h"
+
+#include "scorpion/foundation/jobs/job_system.h"
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace scorpion {
+    // how far leaf boxes are fattened on each side
+    static constexpr float Margin = 0.1f;
+
+    // refresh rebuilds the whole tree once more than 1 / this of the leaves have to be reinserted
+    static constexpr size_t RebuildFraction = 4;
+
+    // the tree is kept balanced so its height stays around 1.44 * log2(leaves), this is plenty
+    static constexpr size_t MaxStackDepth = 256;
+
+    static AABB Union(const AABB& a, const AABB& b) {
+        return {
+            math::Vec3(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)),
+            math::Vec3(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)),
+        };
+    }
+
+    // half the surface area, good enough as a cost since only comparisons matter
+    static float Area(const AABB& box) {
+        math::Vec3 d = box.max - box.min;
+        return d.x * d.y + d.y * d.z + d.z * d.x;
+    }
+
+    static AABB Fatten(const AABB& box) {
+        math::Vec3 margin(Margin, Margin, Margin);
+        return { box.min - margin, box.max + margin };
+    }
+
+    static float DistanceSquared(const AABB& box, math::Vec3 point) {
+        float dx = std::max(std::max(box.min.x - point.x, 0.0f), point.x - box.max.x);
+        float dy = std::max(std::max(box.min.y - point.y, 0.0f), point.y - box.max.y);
+        float dz = std::max(std::max(box.min.z - point.z, 0.0f), point.z - box.max.z);
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // A transform's box, everything queries need from it. The axes come out of the same rotation matrix Transform::getMatrix uses, so
+    // queries line up with what's drawn
+    struct Box {
+        math::Vec3 center;
+        math::Vec3 half;
+        math::Vec3 axes[3]; // local x, y and z in world space
+
+        explicit Box(const components::Transform* transform)
+            : center(transform->getPosition()) {
+            math::Vec3 size = transform->getSize();
+            half = math::Vec3(std::abs(size.x), std::abs(size.y), std::abs(size.z)) * 0.5f;
+
+            math::Matrix4 rotation = math::Matrix4::rotation(transform->getRotation());
+            for (int i = 0; i < 3; i++) {
+                axes[i] = math::Vec3(rotation.m[i * 4], rotation.m[i * 4 + 1], rotation.m[i * 4 + 2]);
+            }
+        }
+
+        math::Vec3 toLocal(math::Vec3 v) const {
+            return math::Vec3(axes[0].dot(v), axes[1].dot(v), axes[2].dot(v));
+        }
+
+        AABB bounds() const {
+            // the extent along each world axis is the half size projected onto it
+            math::Vec3 extent(
+                std::abs(axes[0].x) * half.x + std::abs(axes[1].x) * half.y + std::abs(axes[2].x) * half.z,
+                std::abs(axes[0].y) * half.x + std::abs(axes[1].y) * half.y + std::abs(axes[2].y) * half.z,
+                std::abs(axes[0].z) * half.x + std::abs(axes[1].z) * half.y + std::abs(axes[2].z) * half.z
+            );
+
+            return { center - extent, center + extent };
+        }
+
+        float distanceSquared(math::Vec3 point) const {
+            math::Vec3 local = toLocal(point - center);
+
+            float dx = std::max(std::abs(local.x) - half.x, 0.0f);
+            float dy = std::max(std::abs(local.y) - half.y, 0.0f);
+            float dz = std::max(std::abs(local.z) - half.z, 0.0f);
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        // slab test in the box's own space
+        bool intersect(const Ray& ray, float maxDistance, float& distance, math::Vec3& normal) const {
+            math::Vec3 origin = toLocal(ray.origin - center);
+            math::Vec3 direction = toLocal(ray.direction);
+
+            const float o[3] = { origin.x, origin.y, origin.z };
+            const float d[3] = { direction.x, direction.y, direction.z };
+            const float h[3] = { half.x, half.y, half.z };
+
+            float tMin = 0.0f;
+            float tMax = maxDistance;
+            int axis = -1;
+            float sign = 0.0f;
+
+            for (int i = 0; i < 3; i++) {
+                if (std::abs(d[i]) < 1e-12f) {
+                    if (o[i] < -h[i] || o[i] > h[i]) return false;
+                    continue;
+                }
+
+                float inverse = 1.0f / d[i];
+                float t1 = (-h[i] - o[i]) * inverse;
+                float t2 = (h[i] - o[i]) * inverse;
+                float s = -1.0f;
+
+                if (t1 > t2) {
+                    std::swap(t1, t2);
+                    s = 1.0f;
+                }
+
+                if (t1 > tMin) {
+                    tMin = t1;
+                    axis = i;
+                    sign = s;
+                }
+
+                tMax = std::min(tMax, t2);
+                if (tMin > tMax) return false;
+            }
+
+            distance = tMin;
+
+            if (axis < 0) {
+                // started inside
+                normal = -ray.direction;
+            } else {
+                normal = axes[axis] * sign;
+            }
+
+            return true;
+        }
+    };
+
+    struct RayTraversal {
+        math::Vec3 origin;
+        math::Vec3 inverse;
+
+        explicit RayTraversal(const Ray& ray)
+            : origin(ray.origin)
+            , inverse(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z) {}
+
+        // entry distance, or a negative number if the box is missed or further than maxDistance
+        float enter(const AABB& box, float maxDistance) const {
+            float tx1 = (box.min.x - origin.x) * inverse.x, tx2 = (box.max.x - origin.x) * inverse.x;
+            float ty1 = (box.min.y - origin.y) * inverse.y, ty2 = (box.max.y - origin.y) * inverse.y;
+            float tz1 = (box.min.z - origin.z) * inverse.z, tz2 = (box.max.z - origin.z) * inverse.z;
+
+            float tMin = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), 0.0f));
+            float tMax = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), maxDistance));
+
+            return tMin <= tMax ? tMin : -1.0f;
+        }
+    };
+
+    static bool Visible(const components::Transform* transform, const Actor* ignore) {
+        Actor* owner = transform->getOwner();
+        return owner != ignore && owner->isActive();
+    }
+
+    void SpatialIndex::refresh() {
+        SCORPION_PROFILE_SCOPE("SpatialIndex::refresh");
+
+        mMoved.clear();
+        std::mutex mutex;
+
+        // finding what moved is the bulk of it and doesn't touch the tree, so that part is spread out
+        jobs::ParallelFor(mProxies.size(), 1024, [this, &mutex](size_t begin, size_t end) {
+            uint32_t escaped[256];
+            size_t count = 0;
+
+            for (size_t i = begin; i < end; i++) {
+                Node& node = mNodes[mProxies[i]];
+
+                components::Transform* transform = node.transform;
+                if (!transform->mMoved) continue;
+
+                transform->mMoved = false;
+                if (node.box.contains(Box(transform).bounds())) continue;
+
+                escaped[count++] = mProxies[i];
+
+                if (count == std::size(escaped)) {
+                    std::lock_guard lock(mutex);
+                    mMoved.insert(mMoved.end(), escaped, escaped + count);
+                    count = 0;
+                }
+            }
+
+            if (count > 0) {
+                std::lock_guard lock(mutex);
+                mMoved.insert(mMoved.end(), escaped, escaped + count);
+            }
+        });
+
+        // past this many reinserts it's cheaper to start over, and the tree comes out better too
+        if (mMoved.size() > mProxies.size() / RebuildFraction) {
+            rebuild();
+            return;
+        }
+
+        // whichever order the workers finished in, keep the tree the same from run to run
+        std::sort(mMoved.begin(), mMoved.end());
+
+        for (uint32_t leaf : mMoved) {
+            removeLeaf(leaf);
+            mNodes[leaf].box = Fatten(Box(mNodes[leaf].transform).bounds());
+            insertLeaf(leaf);
+        }
+    }
+
+    bool SpatialIndex::raycast(const Ray& ray, RayHit& hit) const {
+        hit = RayHit();
+        if (mRoot == NullNode) return false;
+
+        RayTraversal traversal(ray);
+        float closest = ray.maxDistance;
+
+        uint32_t stack[MaxStackDepth];
+        size_t top = 0;
+
+        if (traversal.enter(mNodes[mRoot].box, closest) >= 0.0f) stack[top++] = mRoot;
+
+        while (top > 0) {
+            const Node& node = mNodes[stack[--top]];
+
+            if (node.isLeaf()) {
+                if (!Visible(node.transform, ray.ignore)) continue;
+
+                float distance;
+                math::Vec3 normal;
+                if (Box(node.transform).intersect(ray, closest, distance, normal)) {
+                    closest = distance;
+
+                    hit.actor = node.transform->getOwner();
+                    hit.distance = distance;
+                    hit.normal = normal;
+                }
+
+                continue;
+            }
+
+            // nearer child goes on top so the closest hit is found early and prunes the rest
+            float t1 = traversal.enter(mNodes[node.child1].box, closest);
+            float t2 = traversal.enter(mNodes[node.child2].box, closest);
+
+            if (t1 >= 0.0f && t2 >= 0.0f) {
+                if (t1 < t2) {
+                    stack[top++] = node.child2;
+                    stack[top++] = node.child1;
+                } else {
+                    stack[top++] = node.child1;
+                    stack[top++] = node.child2;
+                }
+            } else if (t1 >= 0.0f) {
+                stack[top++] = node.child1;
+            } else if (t2 >= 0.0f) {
+                stack[top++] = node.child2;
+            }
+        }
+
+        if (hit.actor == nullptr) return false;
+
+        hit.point = ray.origin + ray.direction * hit.distance;
+        return true;
+    }
+
+    bool SpatialIndex::raycastAny(const Ray& ray) const {
+        if (mRoot == NullNode) return false;
+
+        RayTraversal traversal(ray);
+
+        uint32_t stack[MaxStackDepth];
+        size_t top = 0;
+        stack[top++] = mRoot;
+
+        while (top > 0) {
+            const Node& node = mNodes[stack[--top]];
+            if (traversal.enter(node.box, ray.maxDistance) < 0.0f) continue;
+
+            if (node.isLeaf()) {
+                float distance;
+                math::Vec3 normal;
+                if (Visible(node.transform, ray.ignore) && Box(node.transform).intersect(ray, ray.maxDistance, distance, normal)) return true;
+
+                continue;
+            }
+
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+
+        return false;
+    }
+
+    void SpatialIndex::raycast(const Ray* rays, size_t count, RayHit* hits) const {
+        SCORPION_PROFILE_SCOPE("SpatialIndex::raycastBatch");
+
+        jobs::ParallelFor(count, 64, [this, rays, hits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                raycast(rays[i], hits[i]);
+            }
+        });
+    }
+
+    void SpatialIndex::raycastAny(const Ray* rays, size_t count, bool* results) const {
+        SCORPION_PROFILE_SCOPE("SpatialIndex::raycastAnyBatch");
+
+        jobs::ParallelFor(count, 64, [this, rays, results](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                results[i] = raycastAny(rays[i]);
+            }
+        });
+    }
+
+    size_t SpatialIndex::overlapBox(const AABB& box, Vector<Actor*>& out) const {
+        if (mRoot == NullNode) return 0;
+
+        size_t found = out.size();
+
+        uint32_t stack[MaxStackDepth];
+        size_t top = 0;
+        stack[top++] = mRoot;
+
+        while (top > 0) {
+            const Node& node = mNodes[stack[--top]];
+            if (!node.box.overlaps(box)) continue;
+
+            if (node.isLeaf()) {
+                if (Visible(node.transform, nullptr) && Box(node.transform).bounds().overlaps(box)) out.push_back(node.transform->getOwner());
+                continue;
+            }
+
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+
+        return out.size() - found;
+    }
+
+    size_t SpatialIndex::overlapSphere(math::Vec3 center, float radius, Vector<Actor*>& out) const {
+        if (mRoot == NullNode) return 0;
+
+        size_t found = out.size();
+        float radiusSquared = radius * radius;
+
+        uint32_t stack[MaxStackDepth];
+        size_t top = 0;
+        stack[top++] = mRoot;
+
+        while (top > 0) {
+            const Node& node = mNodes[stack[--top]];
+            if (DistanceSquared(node.box, center) > radiusSquared) continue;
+
+            if (node.isLeaf()) {
+                if (Visible(node.transform, nullptr) && Box(node.transform).distanceSquared(center) <= radiusSquared) out.push_back(node.transform->getOwner());
+                continue;
+            }
+
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+
+        return out.size() - found;
+    }
+
+    size_t SpatialIndex::nearest(math::Vec3 point, size_t k, Vector<Actor*>& out, float maxDistance) const {
+        if (mRoot == NullNode || k == 0) return 0;
+
+        struct Entry {
+            float distanceSquared;
+            uint32_t node;
+        };
+
+        // nodes to visit, closest on top
+        auto further = [](const Entry& a, const Entry& b) { return a.distanceSquared > b.distanceSquared; };
+        // best k so far, furthest on top so it's the one that gets replaced
+        auto closer = [](const Entry& a, const Entry& b) { return a.distanceSquared < b.distanceSquared; };
+
+        Vector<Entry> open;
+        Vector<Entry> best;
+        best.reserve(k);
+
+        float limit = maxDistance < FLT_MAX ? maxDistance * maxDistance : FLT_MAX;
+
+        open.push_back({ DistanceSquared(mNodes[mRoot].box, point), mRoot });
+
+        while (!open.empty()) {
+            std::pop_heap(open.begin(), open.end(), further);
+            Entry entry = open.back();
+            open.pop_back();
+
+            // everything left is further away than the worst we'd keep
+            if (entry.distanceSquared > limit) break;
+
+            const Node& node = mNodes[entry.node];
+
+            if (node.isLeaf()) {
+                if (!Visible(node.transform, nullptr)) continue;
+
+                float distanceSquared = Box(node.transform).distanceSquared(point);
+                if (distanceSquared > limit) continue;
+
+                if (best.size() == k) {
+                    std::pop_heap(best.begin(), best.end(), closer);
+                    best.pop_back();
+                }
+
+                best.push_back({ distanceSquared, entry.node });
+                std::push_heap(best.begin(), best.end(), closer);
+
+                if (best.size() == k) limit = best.front().distanceSquared;
+                continue;
+            }
+
+            for (uint32_t child : { node.child1, node.child2 }) {
+                float distanceSquared = DistanceSquared(mNodes[child].box, point);
+                if (distanceSquared > limit) continue;
+
+                open.push_back({ distanceSquared, child });
+                std::push_heap(open.begin(), open.end(), further);
+            }
+        }
+
+        std::sort_heap(best.begin(), best.end(), closer);
+
+        for (const Entry& entry : best) {
+            out.push_back(mNodes[entry.node].transform->getOwner());
+        }
+
+        return best.size();
+    }
+
+    void SpatialIndex::add(components::Transform* transform) {
+        insertLeaf(createLeaf(transform));
+    }
+
+    void SpatialIndex::remove(components::Transform* transform) {
+        uint32_t leaf = transform->mSpatialNode;
+        transform->mSpatialNode = NullNode;
+
+        removeLeaf(leaf);
+
+        uint32_t proxy = mNodes[leaf].proxy;
+        uint32_t last = mProxies.back();
+        mProxies[proxy] = last;
+        mNodes[last].proxy = proxy;
+        mProxies.pop_back();
+
+        freeNode(leaf);
+    }
+
+    uint32_t SpatialIndex::createLeaf(components::Transform* transform) {
+        uint32_t leaf = allocateNode();
+
+        Node& node = mNodes[leaf];
+        node.box = Fatten(Box(transform).bounds());
+        node.height = 0;
+        node.transform = transform;
+        node.proxy = static_cast<uint32_t>(mProxies.size());
+
+        mProxies.push_back(leaf);
+
+        transform->mSpatialNode = leaf;
+        transform->mMoved = false;
+
+        return leaf;
+    }
+
+    void SpatialIndex::rebuild() {
+        SCORPION_PROFILE_SCOPE("SpatialIndex::rebuild");
+
+        // the old leaves with fresh boxes, the tree is laid out again depth first so queries walk memory mostly forwards
+        mScratch.clear();
+        mScratch.reserve(mProxies.size());
+
+        for (uint32_t leaf : mProxies) {
+            Node node = mNodes[leaf];
+            node.box = Fatten(Box(node.transform).bounds());
+            node.transform->mMoved = false;
+
+            mScratch.push_back(node);
+        }
+
+        mNodes.clear();
+        mNodes.reserve(mScratch.size() * 2);
+        mProxies.clear();
+        mFreeList = NullNode;
+        mRoot = NullNode;
+
+        if (mScratch.empty()) return;
+
+        // the splits only look at centers, keeping those next to each other makes the partitioning a lot cheaper than going through the nodes
+        mBuildItems.resize(mScratch.size());
+        for (uint32_t i = 0; i < mScratch.size(); i++) {
+            const AABB& box = mScratch[i].box;
+            mBuildItems[i] = { (box.min + box.max) * 0.5f, i };
+        }
+
+        mRoot = build(mBuildItems.data(), mBuildItems.size(), NullNode);
+    }
+
+    // Splits at the median along the longest axis of the centers. Not as good as a surface area split but both halves always differ by at
+    // most one leaf, so the tree is balanced the way insertLeaf and removeLeaf expect it to be
+    uint32_t SpatialIndex::build(BuildItem* items, size_t count, uint32_t parent) {
+        uint32_t index = static_cast<uint32_t>(mNodes.size());
+        mNodes.emplace_back();
+
+        if (count == 1) {
+            Node& node = mNodes[index];
+            node = mScratch[items[0].leaf];
+            node.parent = parent;
+
+            // proxies get renumbered in the same order, so refresh walks the nodes front to back too
+            node.proxy = static_cast<uint32_t>(mProxies.size());
+            mProxies.push_back(index);
+            node.transform->mSpatialNode = index;
+
+            return index;
+        }
+
+        math::Vec3 low = items[0].center;
+        math::Vec3 high = items[0].center;
+
+        for (size_t i = 1; i < count; i++) {
+            const math::Vec3& c = items[i].center;
+            low = math::Vec3(std::min(low.x, c.x), std::min(low.y, c.y), std::min(low.z, c.z));
+            high = math::Vec3(std::max(high.x, c.x), std::max(high.y, c.y), std::max(high.z, c.z));
+        }
+
+        math::Vec3 extent = high - low;
+        int axis = extent.x > extent.y && extent.x > extent.z ? 0 : extent.y > extent.z ? 1 : 2;
+
+        size_t half = count / 2;
+        std::nth_element(items, items + half, items + count, [axis](const BuildItem& a, const BuildItem& b) {
+            return axis == 0 ? a.center.x < b.center.x : axis == 1 ? a.center.y < b.center.y : a.center.z < b.center.z;
+        });
+
+        uint32_t child1 = build(items, half, index);
+        uint32_t child2 = build(items + half, count - half, index);
+
+        Node& node = mNodes[index];
+        node.parent = parent;
+        node.child1 = child1;
+        node.child2 = child2;
+        node.height = 1 + std::max(mNodes[child1].height, mNodes[child2].height);
+        node.box = Union(mNodes[child1].box, mNodes[child2].box);
+
+        return index;
+    }
+
+    uint32_t SpatialIndex::allocateNode() {
+        if (mFreeList == NullNode) {
+            mNodes.emplace_back();
+            return static_cast<uint32_t>(mNodes.size() - 1);
+        }
+
+        uint32_t node = mFreeList;
+        mFreeList = mNodes[node].parent;
+        mNodes[node] = Node();
+
+        return node;
+    }
+
+    void SpatialIndex::freeNode(uint32_t node) {
+        mNodes[node] = Node();
+        mNodes[node].parent = mFreeList; // doubles as the free list link
+        mNodes[node].height = -1;
+
+        mFreeList = node;
+    }
+
+    // Goes down the cheapest path by surface area, same idea as Box2D's dynamic tree
+    void SpatialIndex::insertLeaf(uint32_t leaf) {
+        if (mRoot == NullNode) {
+            mRoot = leaf;
+            mNodes[leaf].parent = NullNode;
+            return;
+        }
+
+        AABB leafBox = mNodes[leaf].box;
+
+        uint32_t index = mRoot;
+        while (!mNodes[index].isLeaf()) {
+            const Node& node = mNodes[index];
+
+            float area = Area(node.box);
+            float combinedArea = Area(Union(node.box, leafBox));
+
+            // making a new parent for this node and the leaf
+            float cost = 2.0f * combinedArea;
+
+            // every ancestor grows by this much no matter which way we go
+            float inheritance = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](uint32_t child) {
+                const Node& c = mNodes[child];
+                float grown = Area(Union(leafBox, c.box));
+                return c.isLeaf() ? grown + inheritance : grown - Area(c.box) + inheritance;
+            };
+
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) break;
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        uint32_t sibling = index;
+        uint32_t oldParent = mNodes[sibling].parent;
+        uint32_t newParent = allocateNode(); // can grow mNodes, no references held across this
+
+        mNodes[newParent].parent = oldParent;
+        mNodes[newParent].box = Union(leafBox, mNodes[sibling].box);
+        mNodes[newParent].height = mNodes[sibling].height + 1;
+        mNodes[newParent].child1 = sibling;
+        mNodes[newParent].child2 = leaf;
+
+        if (oldParent != NullNode) {
+            if (mNodes[oldParent].child1 == sibling) mNodes[oldParent].child1 = newParent;
+            else mNodes[oldParent].child2 = newParent;
+        } else {
+            mRoot = newParent;
+        }
+
+        mNodes[sibling].parent = newParent;
+        mNodes[leaf].parent = newParent;
+
+        for (index = mNodes[leaf].parent; index != NullNode; index = mNodes[index].parent) {
+            index = balance(index);
+
+            Node& node = mNodes[index];
+            node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+            node.box = Union(mNodes[node.child1].box, mNodes[node.child2].box);
+        }
+    }
+
+    void SpatialIndex::removeLeaf(uint32_t leaf) {
+        if (leaf == mRoot) {
+            mRoot = NullNode;
+            return;
+        }
+
+        uint32_t parent = mNodes[leaf].parent;
+        uint32_t grandParent = mNodes[parent].parent;
+        uint32_t sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+
+        freeNode(parent);
+
+        if (grandParent == NullNode) {
+            mRoot = sibling;
+            mNodes[sibling].parent = NullNode;
+            return;
+        }
+
+        if (mNodes[grandParent].child1 == parent) mNodes[grandParent].child1 = sibling;
+        else mNodes[grandParent].child2 = sibling;
+
+        mNodes[sibling].parent = grandParent;
+
+        for (uint32_t index = grandParent; index != NullNode; index = mNodes[index].parent) {
+            index = balance(index);
+
+            Node& node = mNodes[index];
+            node.height = 1 + std::max(mNodes[node.child1].height, mNodes[node.child2].height);
+            node.box = Union(mNodes[node.child1].box, mNodes[node.child2].box);
+        }
+    }
+
+    // Rotates the taller child up if the two differ by more than one in height, returns whichever node ends up where a was
+    uint32_t SpatialIndex::balance(uint32_t iA) {
+        Node& a = mNodes[iA];
+        if (a.isLeaf() || a.height < 2) return iA;
+
+        uint32_t iB = a.child1;
+        uint32_t iC = a.child2;
+        Node& b = mNodes[iB];
+        Node& c = mNodes[iC];
+
+        int32_t difference = c.height - b.height;
+
+        auto replaceChild = [this](uint32_t parent, uint32_t from, uint32_t to) {
+            if (parent == NullNode) mRoot = to;
+            else if (mNodes[parent].child1 == from) mNodes[parent].child1 = to;
+            else mNodes[parent].child2 = to;
+        };
+
+        // c goes up
+        if (difference > 1) {
+            uint32_t iF = c.child1;
+            uint32_t iG = c.child2;
+            Node& f = mNodes[iF];
+            Node& g = mNodes[iG];
+
+            c.child1 = iA;
+            c.parent = a.parent;
+            a.parent = iC;
+            replaceChild(c.parent, iA, iC);
+
+            if (f.height > g.height) {
+                c.child2 = iF;
+                a.child2 = iG;
+                g.parent = iA;
+                a.box = Union(b.box, g.box);
+                c.box = Union(a.box, f.box);
+                a.height = 1 + std::max(b.height, g.height);
+                c.height = 1 + std::max(a.height, f.height);
+            } else {
+                c.child2 = iG;
+                a.child2 = iF;
+                f.parent = iA;
+                a.box = Union(b.box, f.box);
+                c.box = Union(a.box, g.box);
+                a.height = 1 + std::max(b.height, f.height);
+                c.height = 1 + std::max(a.height, g.height);
+            }
+
+            return iC;
+        }
+
+        // b goes up
+        if (difference < -1) {
+            uint32_t iD = b.child1;
+            uint32_t iE = b.child2;
+            Node& d = mNodes[iD];
+            Node& e = mNodes[iE];
+
+            b.child1 = iA;
+            b.parent = a.parent;
+            a.parent = iB;
+            replaceChild(b.parent, iA, iB);
+
+            if (d.height > e.height) {
+                b.child2 = iD;
+                a.child1 = iE;
+                e.parent = iA;
+                a.box = Union(c.box, e.box);
+                b.box = Union(a.box, d.box);
+                a.height = 1 + std::max(c.height, e.height);
+                b.height = 1 + std::max(a.height, d.height);
+            } else {
+                b.child2 = iE;
+                a.child1 = iD;
+                d.parent = iA;
+                a.box = Union(c.box, d.box);
+                b.box = Union(a.box, e.box);
+                a.height = 1 + std::max(c.height, d.height);
+                b.height = 1 + std::max(a.height, e.height);
+            }
+
+            return iB;
+        }
+
+        return iA;
+    }
+}
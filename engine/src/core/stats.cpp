@@ -0,0 +1,167 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/stats.h"
+
+#include "scorpion/foundation/memory/allocator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+namespace scorpion::stats {
+    static const char* names[StatCount] = {
+        "UpdateTime",
+        "RenderTime",
+        "TicksPerFrame",
+        "ActorsUpdated",
+        "ComponentsUpdated",
+        "DrawCalls",
+        "ShaderBinds",
+        "UniformUploads",
+        "TrianglesSubmitted",
+        "Allocations",
+        "TimerWait",
+        "TimerOvershoot",
+        "BackgroundTime",
+        "BackgroundTicks",
+        "RenderablesCulled",
+        "SpritesDrawn",
+        "ComponentsThrottled",
+        "BackgroundActorsUpdated",
+        "BackgroundComponentsUpdated",
+    };
+
+    struct Window {
+        double samples[WindowSize] = {};
+        size_t count = 0;
+        size_t next = 0;
+
+        void push(double value) {
+            samples[next] = value;
+            next = (next + 1) % WindowSize;
+            if (count < WindowSize) count++;
+        }
+    };
+
+    struct StatsState {
+        std::atomic<uint64_t> current[StatCount] = {}; // times are kept in nanoseconds
+        size_t allocationBase = ScorpionHeapAllocationCount();
+
+        std::mutex mutex;
+        Window windows[StatCount];
+    };
+
+    static StatsState& GetState() {
+        static StatsState state;
+        return state;
+    }
+
+    void Add(Stat stat, uint64_t value) {
+        GetState().current[static_cast<size_t>(stat)].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void AddTime(Stat stat, double seconds) {
+        if (seconds < 0.0) seconds = 0.0;
+        Add(stat, static_cast<uint64_t>(seconds * 1e9));
+    }
+
+    void EndFrame() {
+        StatsState& state = GetState();
+
+        size_t allocations = ScorpionHeapAllocationCount();
+        state.current[static_cast<size_t>(Stat::Allocations)].store(allocations - state.allocationBase, std::memory_order_relaxed);
+        state.allocationBase = allocations;
+
+        std::lock_guard lock(state.mutex);
+
+        for (size_t i = 0; i < StatCount; i++) {
+            double value = static_cast<double>(state.current[i].exchange(0, std::memory_order_relaxed));
+            if (IsTime(static_cast<Stat>(i))) value /= 1e6;
+
+            state.windows[i].push(value);
+        }
+    }
+
+    Summary Get(Stat stat) {
+        StatsState& state = GetState();
+        std::lock_guard lock(state.mutex);
+
+        const Window& window = state.windows[static_cast<size_t>(stat)];
+        Summary summary;
+        if (window.count == 0) return summary;
+
+        double sorted[WindowSize];
+        double sum = 0.0;
+        for (size_t i = 0; i < window.count; i++) {
+            sorted[i] = window.samples[i];
+            sum += sorted[i];
+        }
+
+        size_t p99 = (window.count * 99) / 100;
+        if (p99 >= window.count) p99 = window.count - 1;
+        std::nth_element(sorted, sorted + p99, sorted + window.count);
+
+        summary.last = window.samples[(window.next + WindowSize - 1) % WindowSize];
+        summary.min = *std::min_element(window.samples, window.samples + window.count);
+        summary.avg = sum / static_cast<double>(window.count);
+        summary.p99 = sorted[p99];
+        summary.samples = window.count;
+
+        return summary;
+    }
+
+    const char* GetName(Stat stat) {
+        return names[static_cast<size_t>(stat)];
+    }
+
+    bool IsTime(Stat stat) {
+        return stat == Stat::UpdateTime || stat == Stat::RenderTime || stat == Stat::TimerWait || stat == Stat::TimerOvershoot || stat == Stat::BackgroundTime;
+    }
+
+    void Reset() {
+        StatsState& state = GetState();
+        std::lock_guard lock(state.mutex);
+
+        for (size_t i = 0; i < StatCount; i++) {
+            state.current[i].store(0, std::memory_order_relaxed);
+            state.windows[i] = Window();
+        }
+
+        state.allocationBase = ScorpionHeapAllocationCount();
+    }
+
+    bool DumpCSV(const char* path) {
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) return false;
+
+        fputs("stat,unit,last,min,avg,p99,samples\n", file);
+        for (size_t i = 0; i < StatCount; i++) {
+            Stat stat = static_cast<Stat>(i);
+            Summary summary = Get(stat);
+
+            fprintf(file, "%s,%s,%.6f,%.6f,%.6f,%.6f,%zu\n", GetName(stat), IsTime(stat) ? "ms" : "count",
+                    summary.last, summary.min, summary.avg, summary.p99, summary.samples);
+        }
+
+        return fclose(file) == 0;
+    }
+
+    bool DumpJSON(const char* path) {
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) return false;
+
+        fputs("{\n", file);
+        for (size_t i = 0; i < StatCount; i++) {
+            Stat stat = static_cast<Stat>(i);
+            Summary summary = Get(stat);
+
+            fprintf(file, "  \"%s\": {\"unit\": \"%s\", \"last\": %.6f, \"min\": %.6f, \"avg\": %.6f, \"p99\": %.6f, \"samples\": %zu}%s\n",
+                    GetName(stat), IsTime(stat) ? "ms" : "count", summary.last, summary.min, summary.avg, summary.p99, summary.samples,
+                    i + 1 < StatCount ? "," : "");
+        }
+        fputs("}\n", file);
+
+        return fclose(file) == 0;
+    }
+}
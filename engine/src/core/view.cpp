@@ -0,0 +1,28 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/view.h"
+
+namespace scorpion {
+    void Query::add(Actor* actor) {
+        uint32_t id = actor->getId();
+        if (id >= mSparse.size()) mSparse.resize(id + 1, 0);
+        if (mSparse[id] != 0) return;
+
+        mActors.push_back(actor);
+        mSparse[id] = static_cast<uint32_t>(mActors.size());
+    }
+
+    void Query::remove(Actor* actor) {
+        uint32_t id = actor->getId();
+        if (id >= mSparse.size() || mSparse[id] == 0) return;
+
+        size_t index = mSparse[id] - 1;
+
+        Actor* last = mActors.back();
+        mActors[index] = last;
+        mSparse[last->getId()] = static_cast<uint32_t>(index + 1);
+
+        mActors.pop_back();
+        mSparse[id] = 0;
+    }
+}
@@ -6,14 +6,19 @@
 #include "scorpion/engine_std/transform.h"
 
 namespace scorpion::components {
-    Camera::Camera(Actor* owner, math::Vec3 position, math::Vec3 target, math::Vec3 up, float fovY, Projection projection)
+    Camera::Camera(Actor* owner, math::Vec3 position, math::Vec3 target, math::Vec3 up, float fovY, Projection projection, float nearPlane, float farPlane)
         : Component(owner)
         , mTransform(nullptr)
         , mPosition(position)
         , mTarget(target)
         , mUp(up)
         , mFovY(fovY)
-        , mProjection(projection) {}
+        , mProjection(projection)
+        , mNearPlane(nearPlane)
+        , mFarPlane(farPlane) {}
+
+    Camera::Camera(Actor* owner, const State& state)
+        : Camera(owner, state.position, state.target, state.up, state.fovY, state.projection, state.nearPlane, state.farPlane) {}
 
     void Camera::onStart() {
         mTransform = getOwner()->getComponent<Transform>();
@@ -22,7 +27,7 @@ namespace scorpion::components {
     void Camera::onUpdate(double dt) {
         if (mTransform == nullptr) return;
 
-        mPosition = mTransform->getPosition();
+        setPosition(mTransform->getPosition());
     }
 
     math::Vec3 Camera::getPosition() const {
@@ -56,23 +61,129 @@ namespace scorpion::components {
         return mProjection;
     }
 
+    float Camera::getNearPlane() const {
+        return mNearPlane;
+    }
+
+    float Camera::getFarPlane() const {
+        return mFarPlane;
+    }
+
+    // the transform pushes the position every tick, so only a real change should cost a rebuild
     void Camera::setPosition(math::Vec3 position) {
+        if (position.x == mPosition.x && position.y == mPosition.y && position.z == mPosition.z) return;
+
         mPosition = position;
+        mViewDirty = true;
     }
 
     void Camera::setTarget(math::Vec3 target) {
         mTarget = target;
+        mViewDirty = true;
     }
 
     void Camera::setUp(math::Vec3 up) {
         mUp = up;
+        mViewDirty = true;
     }
 
     void Camera::setFovY(float fovY) {
         mFovY = fovY;
+        mProjectionDirty = true;
     }
 
     void Camera::setProjection(Projection projection) {
         mProjection = projection;
+        mProjectionDirty = true;
+    }
+
+    void Camera::setClipPlanes(float nearPlane, float farPlane) {
+        mNearPlane = nearPlane;
+        mFarPlane = farPlane;
+        mProjectionDirty = true;
+    }
+
+    void Camera::setViewport(int width, int height) {
+        if (width <= 0 || height <= 0) return; // minimized
+
+        float aspect = static_cast<float>(width) / static_cast<float>(height);
+        if (aspect == mAspect) return;
+
+        mAspect = aspect;
+        mProjectionDirty = true;
+    }
+
+    const math::Matrix4& Camera::getView() const {
+        updateMatrices();
+        return mView;
+    }
+
+    const math::Matrix4& Camera::getProjectionMatrix() const {
+        updateMatrices();
+        return mProjectionMatrix;
+    }
+
+    const math::Matrix4& Camera::getViewProjection() const {
+        updateMatrices();
+        return mViewProjection;
+    }
+
+    const Frustum& Camera::getFrustum() const {
+        updateMatrices();
+        return mFrustum;
+    }
+
+    void Camera::updateMatrices() const {
+        if (!mViewDirty && !mProjectionDirty) return;
+
+        if (mViewDirty) {
+            mView = math::Matrix4::lookAt(mPosition, mTarget, mUp);
+        }
+
+        if (mProjectionDirty) {
+            switch (mProjection) {
+                case Projection::Perspective:
+                    mProjectionMatrix = math::Matrix4::perspective(math::Deg2Rad(mFovY), mAspect, mNearPlane, mFarPlane);
+                    break;
+                case Projection::Orthographic: {
+                    float top = mFovY * 0.5f;
+                    float right = top * mAspect;
+
+                    mProjectionMatrix = math::Matrix4::orthographic(-right, right, -top, top, mNearPlane, mFarPlane);
+                    break;
+                }
+            }
+        }
+
+        mViewProjection = mProjectionMatrix * mView;
+        mFrustum = Frustum::fromMatrix(mViewProjection);
+
+        mViewDirty = false;
+        mProjectionDirty = false;
+    }
+
+    Camera::State Camera::saveState() const {
+        State state{};
+        state.position = mPosition;
+        state.target = mTarget;
+        state.up = mUp;
+        state.fovY = mFovY;
+        state.projection = mProjection;
+        state.nearPlane = mNearPlane;
+        state.farPlane = mFarPlane;
+        return state;
+    }
+
+    void Camera::loadState(const State& state) {
+        mPosition = state.position;
+        mTarget = state.target;
+        mUp = state.up;
+        mFovY = state.fovY;
+        mProjection = state.projection;
+        mNearPlane = state.nearPlane;
+        mFarPlane = state.farPlane;
+
+        mViewDirty = true;
+        mProjectionDirty = true;
     }
 }
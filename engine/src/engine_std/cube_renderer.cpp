@@ -12,6 +12,9 @@ namespace scorpion::components {
         : RenderableComponent(actor, Layer::World3D)
         , mColor(color) {}
 
+    CubeRenderer::CubeRenderer(Actor* actor, const State& state)
+        : CubeRenderer(actor, state.color) {}
+
     void CubeRenderer::onStart() {
         mTransform = getOwner()->getComponent<Transform>();
     }
@@ -22,19 +25,35 @@ namespace scorpion::components {
         render::DrawCube(mTransform->getPosition(), mTransform->getSize(), mTransform->getRotation(), mColor);
     }
 
+    bool CubeRenderer::getBounds(AABB& bounds) const {
+        if (mTransform == nullptr) return false;
+
+        static const AABB unitCube = { math::Vec3(-0.5f, -0.5f, -0.5f), math::Vec3(0.5f, 0.5f, 0.5f) };
+        bounds = unitCube.transformed(mTransform->getMatrix());
+        return true;
+    }
+
     math::Color CubeRenderer::getColor() const {
         return mColor;
     }
 
+    CubeRenderer::State CubeRenderer::saveState() const {
+        State state{};
+        state.color = mColor;
+        return state;
+    }
+
+    void CubeRenderer::loadState(const State& state) {
+        mColor = state.color;
+    }
+
+    // view and projection already went up when the shader was bound, only the per object part is left
     void CubeRenderer::beginShader0() {
-        Camera* camera = GetActiveScene()->getActiveCamera();
         Transform* transform = getOwner()->getComponent<Transform>();
         if (transform == nullptr) return;
 
         math::Matrix4 model = transform->getMatrix();
-        math::Matrix4 view = math::Matrix4::lookAt(camera->getPosition(), camera->getTarget(), camera->getUp());
-        math::Matrix4 projection = math::Matrix4::perspective(camera->getFovY(), static_cast<float>(render::GetWindowWidth()) / static_cast<float>(render::GetWindowHeight()), 0.1f, 100.0f);
-        math::Matrix4 mvp = projection * view * model;
+        math::Matrix4 mvp = render::GetCameraConstants().viewProjection * model;
 
         shader()->setUniformMatrix4("mvp", mvp);
         shader()->setUniformMatrix4("model", model);
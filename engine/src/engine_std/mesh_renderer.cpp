@@ -0,0 +1,72 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/actor.h"
+
+#include "scorpion/engine_std/mesh_renderer.h"
+
+#include <algorithm>
+
+namespace scorpion::components {
+    MeshRenderer::MeshRenderer(Actor* actor, SharedPtr<render::Mesh> mesh, math::Color color)
+        : RenderableComponent(actor, Layer::World3D)
+        , mMesh(std::move(mesh))
+        , mColor(color) {
+        setBatched(true);
+    }
+
+    void MeshRenderer::onStart() {
+        mTransform = getOwner()->getComponent<Transform>();
+
+        // without an instanceTransform attribute the backend draws every instance on its own
+        if (shader() == nullptr) setShader(render::GetInstancedShader());
+    }
+
+    void MeshRenderer::onRender() {
+        if (mTransform == nullptr || mMesh == nullptr) return;
+
+        render::Mesh* mesh = mMesh.get();
+        for (uint32_t lod = std::min(getOwner()->getLOD(), LODCount - 1); lod > 0; lod--) {
+            if (mLODMeshes[lod - 1] != nullptr) {
+                mesh = mLODMeshes[lod - 1].get();
+                break;
+            }
+        }
+
+        render::DrawMesh(mesh, shader(), mTransform->getMatrix(), mColor);
+    }
+
+    bool MeshRenderer::getBounds(AABB& bounds) const {
+        if (mTransform == nullptr || mMesh == nullptr) return false;
+
+        bounds = mMesh->getBounds().transformed(mTransform->getMatrix());
+        return true;
+    }
+
+    const SharedPtr<render::Mesh>& MeshRenderer::getMesh() const {
+        return mMesh;
+    }
+
+    void MeshRenderer::setMesh(SharedPtr<render::Mesh> mesh) {
+        mMesh = std::move(mesh);
+    }
+
+    const SharedPtr<render::Mesh>& MeshRenderer::getLODMesh(uint32_t lod) const {
+        lod = std::min(lod, LODCount - 1);
+        return lod == 0 ? mMesh : mLODMeshes[lod - 1];
+    }
+
+    void MeshRenderer::setLODMesh(uint32_t lod, SharedPtr<render::Mesh> mesh) {
+        lod = std::min(lod, LODCount - 1);
+
+        if (lod == 0) mMesh = std::move(mesh);
+        else mLODMeshes[lod - 1] = std::move(mesh);
+    }
+
+    math::Color MeshRenderer::getColor() const {
+        return mColor;
+    }
+
+    void MeshRenderer::setColor(math::Color color) {
+        mColor = color;
+    }
+}
@@ -0,0 +1,396 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/actor.h"
+
+#include "scorpion/engine_std/particle_emitter.h"
+
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCORPION_PARTICLES_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace scorpion::components {
+    // seeds only depend on the order emitters get created in, so runs repeat
+    static std::atomic<uint64_t> emitterCount = 0;
+
+    ParticleEmitter::ParticleEmitter(Actor* actor, const Settings& settings, SharedPtr<render::Mesh> mesh)
+        : RenderableComponent(actor, Layer::World3D)
+        , mMesh(std::move(mesh))
+        , mRandom(0x9E3779B97F4A7C15ull * (emitterCount.fetch_add(1, std::memory_order_relaxed) + 1)) {
+        setBatched(true);
+        setSettings(settings);
+        clear();
+    }
+
+    void ParticleEmitter::onStart() {
+        mTransform = getOwner()->getComponent<Transform>();
+
+        if (mMesh == nullptr) mMesh = render::GetCubeMesh();
+        if (shader() == nullptr) setShader(render::GetInstancedShader());
+    }
+
+    void ParticleEmitter::onUpdate(double dt) {
+        SCORPION_PROFILE_SCOPE("ParticleEmitter::onUpdate");
+
+        auto step = static_cast<float>(dt);
+
+        simulate(step);
+        compact();
+
+        if (mEmitting && mSettings.rate > 0.0f) {
+            mSpawnAccumulator += mSettings.rate * step;
+
+            auto count = static_cast<uint32_t>(mSpawnAccumulator);
+            mSpawnAccumulator -= static_cast<float>(count);
+
+            spawn(count);
+        }
+    }
+
+    void ParticleEmitter::onRender() {
+        if (mCount == 0 || mMesh == nullptr) return;
+
+        render::DrawMeshInstances(mMesh.get(), shader(), mInstances.data(), mCount);
+    }
+
+    bool ParticleEmitter::getBounds(AABB& bounds) const {
+        if (mCount == 0 || mMesh == nullptr) return false;
+
+        // grown by the mesh at the biggest size a particle can have
+        const AABB& mesh = mMesh->getBounds();
+        float maxSize = std::max(std::abs(mSettings.startSize), std::abs(mSettings.endSize));
+
+        bounds.min = mBounds.min + mesh.min * maxSize;
+        bounds.max = mBounds.max + mesh.max * maxSize;
+        return true;
+    }
+
+    void ParticleEmitter::burst(uint32_t count) {
+        spawn(count);
+    }
+
+    void ParticleEmitter::clear() {
+        mCount = 0;
+        mSpawnAccumulator = 0.0f;
+        mBounds.min = math::Vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+        mBounds.max = math::Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    }
+
+    bool ParticleEmitter::isEmitting() const {
+        return mEmitting;
+    }
+
+    void ParticleEmitter::setEmitting(bool emitting) {
+        mEmitting = emitting;
+    }
+
+    const ParticleEmitter::Settings& ParticleEmitter::getSettings() const {
+        return mSettings;
+    }
+
+    void ParticleEmitter::setSettings(const Settings& settings) {
+        mSettings = settings;
+
+        reserve(settings.maxParticles);
+        mCount = std::min(mCount, settings.maxParticles);
+    }
+
+    uint32_t ParticleEmitter::getParticleCount() const {
+        return mCount;
+    }
+
+    void ParticleEmitter::reserve(uint32_t capacity) {
+        if (capacity <= mCapacity) return;
+
+        for (Vector<float>* field : { &mPositionX, &mPositionY, &mPositionZ, &mVelocityX, &mVelocityY, &mVelocityZ, &mAge, &mInverseLifetime }) {
+            field->resize(capacity, 0.0f);
+        }
+
+        // simulate and spawn only ever write the scale, translation and color, everything else stays what it's set to here
+        render::MeshInstance instance;
+        instance.transform.m[15] = 1.0f;
+        instance.color = math::Color::white;
+
+        mInstances.resize(capacity, instance);
+        mCapacity = capacity;
+    }
+
+    void ParticleEmitter::spawn(uint32_t count) {
+        count = std::min(count, mSettings.maxParticles - std::min(mCount, mSettings.maxParticles));
+        if (count == 0) return;
+
+        math::Vec3 origin = mTransform != nullptr ? mTransform->getPosition() : math::Vec3::zero;
+        math::Quat rotation = mTransform != nullptr ? mTransform->getRotation() : math::Quat::identity;
+
+        // cone around direction, tangent and bitangent span the base
+        math::Vec3 direction = (rotation * mSettings.direction).normalized();
+        math::Vec3 helper = std::abs(direction.y) < 0.99f ? math::Vec3(0, 1, 0) : math::Vec3(1, 0, 0);
+        math::Vec3 tangent = direction.cross(helper).normalized();
+        math::Vec3 bitangent = direction.cross(tangent);
+
+        float minCos = std::cos(std::clamp(mSettings.spread, 0.0f, 3.14159265f));
+
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t index = mCount++;
+
+            math::Vec3 offset(nextFloat(-1.0f, 1.0f) * mSettings.extents.x, nextFloat(-1.0f, 1.0f) * mSettings.extents.y, nextFloat(-1.0f, 1.0f) * mSettings.extents.z);
+            math::Vec3 position = origin + rotation * offset;
+
+            // uniform over the cap of the sphere, not bunched up in the middle
+            float cosTheta = nextFloat(minCos, 1.0f);
+            float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+            float phi = nextFloat(0.0f, 6.2831853f);
+
+            math::Vec3 velocity = (tangent * (std::cos(phi) * sinTheta) + bitangent * (std::sin(phi) * sinTheta) + direction * cosTheta)
+                * nextFloat(mSettings.minSpeed, mSettings.maxSpeed);
+
+            mPositionX[index] = position.x;
+            mPositionY[index] = position.y;
+            mPositionZ[index] = position.z;
+            mVelocityX[index] = velocity.x;
+            mVelocityY[index] = velocity.y;
+            mVelocityZ[index] = velocity.z;
+            mAge[index] = 0.0f;
+            mInverseLifetime[index] = 1.0f / std::max(nextFloat(mSettings.minLifetime, mSettings.maxLifetime), 1e-4f);
+
+            writeInstance(index, 0.0f);
+        }
+    }
+
+    void ParticleEmitter::simulate(float dt) {
+        mDead.clear();
+        mBounds.min = math::Vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+        mBounds.max = math::Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+        if (mCount == 0) return;
+
+        float drag = std::exp(-mSettings.drag * dt);
+        float gravityX = mSettings.gravity.x * dt;
+        float gravityY = mSettings.gravity.y * dt;
+        float gravityZ = mSettings.gravity.z * dt;
+
+        float* px = mPositionX.data();
+        float* py = mPositionY.data();
+        float* pz = mPositionZ.data();
+        float* vx = mVelocityX.data();
+        float* vy = mVelocityY.data();
+        float* vz = mVelocityZ.data();
+        float* age = mAge.data();
+        const float* inverseLifetime = mInverseLifetime.data();
+
+        uint32_t i = 0;
+
+#ifdef SCORPION_PARTICLES_SSE
+        static_assert(sizeof(math::Color) == 4);
+
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 step = _mm_set1_ps(dt);
+        const __m128 damping = _mm_set1_ps(drag);
+        const __m128 gx = _mm_set1_ps(gravityX);
+        const __m128 gy = _mm_set1_ps(gravityY);
+        const __m128 gz = _mm_set1_ps(gravityZ);
+
+        const __m128 startSize = _mm_set1_ps(mSettings.startSize);
+        const __m128 sizeDelta = _mm_set1_ps(mSettings.endSize - mSettings.startSize);
+
+        const math::Color& start = mSettings.startColor;
+        const math::Color& end = mSettings.endColor;
+
+        const __m128 startColor[4] = { _mm_set1_ps(start.r), _mm_set1_ps(start.g), _mm_set1_ps(start.b), _mm_set1_ps(start.a) };
+        const __m128 colorDelta[4] = {
+            _mm_set1_ps(static_cast<float>(end.r) - static_cast<float>(start.r)),
+            _mm_set1_ps(static_cast<float>(end.g) - static_cast<float>(start.g)),
+            _mm_set1_ps(static_cast<float>(end.b) - static_cast<float>(start.b)),
+            _mm_set1_ps(static_cast<float>(end.a) - static_cast<float>(start.a)),
+        };
+
+        __m128 minX = _mm_set1_ps(FLT_MAX), minY = minX, minZ = minX;
+        __m128 maxX = _mm_set1_ps(-FLT_MAX), maxY = maxX, maxZ = maxX;
+
+        render::MeshInstance* instances = mInstances.data();
+        bool streaming = (reinterpret_cast<uintptr_t>(instances) & 15) == 0;
+
+        // every instance is written whole from here, only the scale, translation and color change between blocks
+        alignas(16) render::MeshInstance block[4];
+        constexpr size_t VectorsPerBlock = sizeof(render::MeshInstance) * 4 / sizeof(__m128);
+        static_assert(sizeof(block) % sizeof(__m128) == 0);
+
+        for (render::MeshInstance& instance : block) {
+            instance.transform.m[15] = 1.0f;
+        }
+
+        for (; i + 4 <= mCount; i += 4) {
+            __m128 velocityX = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), damping), gx);
+            __m128 velocityY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), damping), gy);
+            __m128 velocityZ = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vz + i), damping), gz);
+
+            _mm_storeu_ps(vx + i, velocityX);
+            _mm_storeu_ps(vy + i, velocityY);
+            _mm_storeu_ps(vz + i, velocityZ);
+
+            __m128 x = _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(velocityX, step));
+            __m128 y = _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(velocityY, step));
+            __m128 z = _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(velocityZ, step));
+
+            _mm_storeu_ps(px + i, x);
+            _mm_storeu_ps(py + i, y);
+            _mm_storeu_ps(pz + i, z);
+
+            __m128 a = _mm_add_ps(_mm_loadu_ps(age + i), step);
+            _mm_storeu_ps(age + i, a);
+
+            __m128 t = _mm_mul_ps(a, _mm_loadu_ps(inverseLifetime + i));
+
+            if (int dead = _mm_movemask_ps(_mm_cmpge_ps(t, one)); dead != 0) {
+                for (uint32_t lane = 0; lane < 4; lane++) {
+                    if (dead & (1 << lane)) mDead.push_back(i + lane);
+                }
+            }
+
+            t = _mm_min_ps(t, one);
+
+            minX = _mm_min_ps(minX, x);
+            minY = _mm_min_ps(minY, y);
+            minZ = _mm_min_ps(minZ, z);
+            maxX = _mm_max_ps(maxX, x);
+            maxY = _mm_max_ps(maxY, y);
+            maxZ = _mm_max_ps(maxZ, z);
+
+            // one rgba8 per lane, same byte order as math::Color
+            __m128i color = _mm_cvtps_epi32(_mm_add_ps(startColor[0], _mm_mul_ps(colorDelta[0], t)));
+            color = _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(_mm_add_ps(startColor[1], _mm_mul_ps(colorDelta[1], t))), 8));
+            color = _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(_mm_add_ps(startColor[2], _mm_mul_ps(colorDelta[2], t))), 16));
+            color = _mm_or_si128(color, _mm_slli_epi32(_mm_cvtps_epi32(_mm_add_ps(startColor[3], _mm_mul_ps(colorDelta[3], t))), 24));
+
+            alignas(16) float sizes[4];
+            alignas(16) uint32_t colors[4];
+            _mm_store_ps(sizes, _mm_add_ps(startSize, _mm_mul_ps(sizeDelta, t)));
+            _mm_store_si128(reinterpret_cast<__m128i*>(colors), color);
+
+            // rows become (x, y, z, 1) per particle, which is exactly the translation column
+            __m128 w = one;
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+            const __m128 translations[4] = { x, y, z, w };
+
+            for (uint32_t lane = 0; lane < 4; lane++) {
+                block[lane].transform.m[0] = sizes[lane];
+                block[lane].transform.m[5] = sizes[lane];
+                block[lane].transform.m[10] = sizes[lane];
+                _mm_storeu_ps(block[lane].transform.m + 12, translations[lane]);
+                memcpy(&block[lane].color, &colors[lane], sizeof(uint32_t));
+            }
+
+            // 4 instances are 17 whole vectors. Written out in one go nothing has to be read in first, that's most of the cost with lots of them
+            const float* source = block[0].transform.m;
+            float* destination = instances[i].transform.m;
+
+            if (streaming) {
+                for (size_t k = 0; k < VectorsPerBlock; k++) _mm_stream_ps(destination + k * 4, _mm_load_ps(source + k * 4));
+            } else {
+                memcpy(destination, source, sizeof(block));
+            }
+        }
+
+        _mm_sfence();
+
+        alignas(16) float lanes[6][4];
+        _mm_store_ps(lanes[0], minX);
+        _mm_store_ps(lanes[1], minY);
+        _mm_store_ps(lanes[2], minZ);
+        _mm_store_ps(lanes[3], maxX);
+        _mm_store_ps(lanes[4], maxY);
+        _mm_store_ps(lanes[5], maxZ);
+
+        mBounds.min = math::Vec3(std::min({ lanes[0][0], lanes[0][1], lanes[0][2], lanes[0][3] }),
+                                 std::min({ lanes[1][0], lanes[1][1], lanes[1][2], lanes[1][3] }),
+                                 std::min({ lanes[2][0], lanes[2][1], lanes[2][2], lanes[2][3] }));
+        mBounds.max = math::Vec3(std::max({ lanes[3][0], lanes[3][1], lanes[3][2], lanes[3][3] }),
+                                 std::max({ lanes[4][0], lanes[4][1], lanes[4][2], lanes[4][3] }),
+                                 std::max({ lanes[5][0], lanes[5][1], lanes[5][2], lanes[5][3] }));
+#endif
+
+        // whatever didn't fill a whole block, or everything without SSE
+        for (; i < mCount; i++) {
+            vx[i] = vx[i] * drag + gravityX;
+            vy[i] = vy[i] * drag + gravityY;
+            vz[i] = vz[i] * drag + gravityZ;
+
+            px[i] += vx[i] * dt;
+            py[i] += vy[i] * dt;
+            pz[i] += vz[i] * dt;
+
+            age[i] += dt;
+
+            float t = age[i] * inverseLifetime[i];
+            if (t >= 1.0f) mDead.push_back(i);
+
+            writeInstance(i, std::min(t, 1.0f));
+        }
+    }
+
+    void ParticleEmitter::compact() {
+        // Going through the dead back to front means whatever gets moved down from the end is always alive already
+        for (size_t k = mDead.size(); k-- > 0;) {
+            uint32_t i = mDead[k];
+            uint32_t last = --mCount;
+            if (i == last) continue;
+
+            mPositionX[i] = mPositionX[last];
+            mPositionY[i] = mPositionY[last];
+            mPositionZ[i] = mPositionZ[last];
+            mVelocityX[i] = mVelocityX[last];
+            mVelocityY[i] = mVelocityY[last];
+            mVelocityZ[i] = mVelocityZ[last];
+            mAge[i] = mAge[last];
+            mInverseLifetime[i] = mInverseLifetime[last];
+            mInstances[i] = mInstances[last];
+        }
+
+        mDead.clear();
+    }
+
+    void ParticleEmitter::writeInstance(uint32_t index, float t) {
+        const math::Color& start = mSettings.startColor;
+        const math::Color& end = mSettings.endColor;
+
+        float size = mSettings.startSize + (mSettings.endSize - mSettings.startSize) * t;
+        float x = mPositionX[index];
+        float y = mPositionY[index];
+        float z = mPositionZ[index];
+
+        float* m = mInstances[index].transform.m;
+        m[0] = size;
+        m[5] = size;
+        m[10] = size;
+        m[12] = x;
+        m[13] = y;
+        m[14] = z;
+
+        auto lerp = [t](uint8_t a, uint8_t b) {
+            return static_cast<uint8_t>(static_cast<float>(a) + (static_cast<float>(b) - static_cast<float>(a)) * t + 0.5f);
+        };
+
+        mInstances[index].color = { lerp(start.r, end.r), lerp(start.g, end.g), lerp(start.b, end.b), lerp(start.a, end.a) };
+
+        mBounds.min = math::Vec3(std::min(mBounds.min.x, x), std::min(mBounds.min.y, y), std::min(mBounds.min.z, z));
+        mBounds.max = math::Vec3(std::max(mBounds.max.x, x), std::max(mBounds.max.y, y), std::max(mBounds.max.z, z));
+    }
+
+    float ParticleEmitter::nextFloat(float min, float max) {
+        uint64_t x = mRandom;
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        mRandom = x;
+
+        return min + (max - min) * static_cast<float>(x >> 40) / static_cast<float>(1ull << 24);
+    }
+}
@@ -14,6 +14,11 @@ namespace scorpion::components {
         , mGravity(gravity)
         , mKinematic(kinematic) {}
 
+    PhysicsBody::PhysicsBody(Actor* owner, const State& state)
+        : PhysicsBody(owner, state.mass, state.gravity, state.kinematic) {
+        loadState(state);
+    }
+
     void PhysicsBody::onStart() {
         mTransform = getOwner()->getComponent<Transform>();
     }
@@ -50,4 +55,29 @@ namespace scorpion::components {
     void PhysicsBody::applyTorque(const math::Vec3& torque) {
         mTorqueAccumulator += torque;
     }
+
+    PhysicsBody::State PhysicsBody::saveState() const {
+        // value initialized so the padding after the bools is zero too, snapshots get compared byte for byte
+        State state{};
+        state.mass = mMass;
+        state.gravity = mGravity;
+        state.kinematic = mKinematic;
+        state.linearVelocity = mLinearVelocity;
+        state.angularVelocity = mAngularVelocity;
+        state.inertiaTensor = mInertiaTensor;
+        state.forceAccumulator = mForceAccumulator;
+        state.torqueAccumulator = mTorqueAccumulator;
+        return state;
+    }
+
+    void PhysicsBody::loadState(const State& state) {
+        mMass = state.mass;
+        mGravity = state.gravity;
+        mKinematic = state.kinematic;
+        mLinearVelocity = state.linearVelocity;
+        mAngularVelocity = state.angularVelocity;
+        mInertiaTensor = state.inertiaTensor;
+        mForceAccumulator = state.forceAccumulator;
+        mTorqueAccumulator = state.torqueAccumulator;
+    }
 }
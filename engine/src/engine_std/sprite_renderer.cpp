@@ -0,0 +1,65 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/actor.h"
+
+#include "scorpion/engine_std/sprite_renderer.h"
+
+#include <cmath>
+
+namespace scorpion::components {
+    SpriteRenderer::SpriteRenderer(Actor* actor, const render::TextureRegion& region, math::Color color, Layer layer, int order)
+        : RenderableComponent(actor, layer)
+        , mRegion(region)
+        , mColor(color)
+        , mOrder(order) {
+        setBatched(true);
+    }
+
+    void SpriteRenderer::onStart() {
+        mTransform = getOwner()->getComponent<Transform>();
+    }
+
+    void SpriteRenderer::onRender() {
+        if (mTransform == nullptr) return;
+
+        math::Vec3 position = mTransform->getPosition();
+        math::Vec3 size = mTransform->getSize();
+        math::Quat q = mTransform->getRotation();
+
+        float rotation = std::atan2(2.0f * (q.w * q.z + q.x * q.y), 1.0f - 2.0f * (q.y * q.y + q.z * q.z));
+
+        render::DrawSprite(mRegion, math::Vec2(position.x, position.y), math::Vec2(size.x, size.y), mColor, rotation, math::Vec2(size.x * 0.5f, size.y * 0.5f), mOrder, mBlend);
+    }
+
+    const render::TextureRegion& SpriteRenderer::getRegion() const {
+        return mRegion;
+    }
+
+    void SpriteRenderer::setRegion(const render::TextureRegion& region) {
+        mRegion = region;
+    }
+
+    math::Color SpriteRenderer::getColor() const {
+        return mColor;
+    }
+
+    void SpriteRenderer::setColor(math::Color color) {
+        mColor = color;
+    }
+
+    int SpriteRenderer::getOrder() const {
+        return mOrder;
+    }
+
+    void SpriteRenderer::setOrder(int order) {
+        mOrder = order;
+    }
+
+    render::BlendMode SpriteRenderer::getBlend() const {
+        return mBlend;
+    }
+
+    void SpriteRenderer::setBlend(render::BlendMode blend) {
+        mBlend = blend;
+    }
+}
@@ -9,11 +9,25 @@ namespace scorpion::components {
         , mSize(size)
         , mRotation(rotation) {}
 
+    Transform::Transform(Actor* owner, const State& state)
+        : Transform(owner, state.position, state.size, state.rotation) {}
+
     math::Matrix4 Transform::getMatrix() const {
-        math::Matrix4 t = math::Matrix4::translation(mPosition);
-        math::Matrix4 r = math::Matrix4::rotation(mRotation);
-        math::Matrix4 s = math::Matrix4::scale(mSize);
-        return t * r * s;
+        // same as translation * rotation * scale without the two full multiplies, this runs for every drawn mesh every frame
+        math::Matrix4 matrix = math::Matrix4::rotation(mRotation);
+
+        const float scale[3] = { mSize.x, mSize.y, mSize.z };
+        for (int column = 0; column < 3; column++) {
+            for (int row = 0; row < 3; row++) {
+                matrix.m[column * 4 + row] *= scale[column];
+            }
+        }
+
+        matrix.m[12] = mPosition.x;
+        matrix.m[13] = mPosition.y;
+        matrix.m[14] = mPosition.z;
+
+        return matrix;
     }
 
     math::Vec3 Transform::getPosition() const {
@@ -30,13 +44,31 @@ namespace scorpion::components {
 
     void Transform::setPosition(math::Vec3 position) {
         mPosition = position;
+        mMoved = true;
     }
 
     void Transform::setSize(math::Vec3 size) {
         mSize = size;
+        mMoved = true;
     }
 
     void Transform::setRotation(math::Quat rotation) {
         mRotation = rotation;
+        mMoved = true;
+    }
+
+    Transform::State Transform::saveState() const {
+        State state{};
+        state.position = mPosition;
+        state.size = mSize;
+        state.rotation = mRotation;
+        return state;
+    }
+
+    void Transform::loadState(const State& state) {
+        mPosition = state.position;
+        mSize = state.size;
+        mRotation = state.rotation;
+        mMoved = true;
     }
 }
@@ -0,0 +1,29 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/foundation/io/file.h"
+
+#include "scorpion/util/std_types.h"
+
+#include <cstdio>
+#include <filesystem>
+
+namespace scorpion::io {
+    bool WriteFile(const char* path, const void* data, size_t size) {
+        String temporary = String(path) + ".tmp";
+
+        FILE* file = fopen(temporary.c_str(), "wb");
+        if (file == nullptr) return false;
+
+        bool written = fwrite(data, 1, size, file) == size;
+        if (fclose(file) != 0) written = false;
+
+        std::error_code error;
+        if (written) {
+            std::filesystem::rename(temporary.c_str(), path, error);
+        } else {
+            std::filesystem::remove(temporary.c_str(), error);
+        }
+
+        return written && !error;
+    }
+}
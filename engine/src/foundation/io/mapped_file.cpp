@@ -0,0 +1,176 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/foundation/io/mapped_file.h"
+
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace scorpion::io {
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+
+            mData = std::exchange(other.mData, nullptr);
+            mSize = std::exchange(other.mSize, 0);
+#ifdef _WIN32
+            mFile = std::exchange(other.mFile, nullptr);
+            mMapping = std::exchange(other.mMapping, nullptr);
+#endif
+        }
+
+        return *this;
+    }
+
+    bool MappedFile::open(const char* path) {
+        close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        mFile = file;
+        mMapping = mapping;
+        mData = static_cast<const uint8_t*>(data);
+        mSize = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // the mapping keeps the file alive on its own
+        ::close(fd);
+
+        if (data == MAP_FAILED) return false;
+
+        mData = static_cast<const uint8_t*>(data);
+        mSize = static_cast<size_t>(info.st_size);
+#endif
+
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (mData == nullptr) return;
+
+#ifdef _WIN32
+        UnmapViewOfFile(mData);
+        CloseHandle(mMapping);
+        CloseHandle(mFile);
+
+        mMapping = nullptr;
+        mFile = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+
+        mData = nullptr;
+        mSize = 0;
+    }
+
+    bool MappedFile::isOpen() const {
+        return mData != nullptr;
+    }
+
+    const uint8_t* MappedFile::data() const {
+        return mData;
+    }
+
+    size_t MappedFile::size() const {
+        return mSize;
+    }
+
+    void MappedFile::prefetch(size_t offset, size_t size) const {
+        if (offset >= mSize) return;
+        if (size > mSize - offset) size = mSize - offset;
+
+        size_t pageSize = GetPageSize();
+        size_t begin = offset & ~(pageSize - 1);
+        size_t end = offset + size;
+
+#ifndef _WIN32
+        // lets the kernel start readahead for the whole range before we fault through it page by page
+        madvise(const_cast<uint8_t*>(mData) + begin, end - begin, MADV_WILLNEED);
+#endif
+
+        volatile uint8_t sink = 0;
+        for (size_t page = begin; page < end; page += pageSize) {
+            sink = sink + mData[page];
+        }
+    }
+
+    void MappedFile::evict(size_t offset, size_t size) const {
+        if (offset >= mSize) return;
+        if (size > mSize - offset) size = mSize - offset;
+
+        // only whole pages, anything shared with a neighbour stays
+        size_t pageSize = GetPageSize();
+        size_t begin = (offset + pageSize - 1) & ~(pageSize - 1);
+        size_t end = offset + size == mSize ? mSize : (offset + size) & ~(pageSize - 1); // nothing comes after the file's tail page
+        if (begin >= end) return;
+
+#ifdef _WIN32
+        // unlocking pages that were never locked just trims them from the working set
+        VirtualUnlock(const_cast<uint8_t*>(mData) + begin, end - begin);
+#else
+        madvise(const_cast<uint8_t*>(mData) + begin, end - begin, MADV_DONTNEED);
+#endif
+    }
+
+    size_t MappedFile::GetPageSize() {
+        static size_t pageSize = [] {
+#ifdef _WIN32
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return static_cast<size_t>(info.dwPageSize);
+#else
+            return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        }();
+
+        return pageSize;
+    }
+}
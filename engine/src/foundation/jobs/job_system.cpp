@@ -0,0 +1,207 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/foundation/jobs/job_system.h"
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include "scorpion/util/std_types.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace scorpion::jobs {
+    struct Batch {
+        const std::function<void(size_t, size_t)>* fn;
+        size_t count;
+        size_t grainSize;
+
+        std::atomic<size_t> next = 0;
+        std::atomic<size_t> completed = 0;
+        std::atomic<size_t> users = 0;
+
+        // returns false once there's nothing left to grab
+        bool runOne() {
+            size_t begin = next.fetch_add(grainSize, std::memory_order_relaxed);
+            if (begin >= count) return false;
+
+            size_t end = std::min(begin + grainSize, count);
+
+            SCORPION_PROFILE_SCOPE("jobs::ParallelFor");
+            (*fn)(begin, end);
+
+            completed.fetch_add(end - begin, std::memory_order_acq_rel);
+            return true;
+        }
+    };
+
+    static thread_local bool isWorker = false;
+    static std::atomic<void (*)()> waitCallback = nullptr;
+
+    struct JobSystem {
+        std::mutex mutex;
+        std::condition_variable wake;
+        Vector<Batch*> batches;
+        Vector<std::thread> workers;
+        bool stopping = false;
+
+        JobSystem() {
+            unsigned int hardware = std::thread::hardware_concurrency();
+            size_t count = hardware > 1 ? hardware - 1 : 0;
+
+            workers.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                workers.emplace_back([this] { work(); });
+            }
+        }
+
+        ~JobSystem() {
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        void work() {
+            isWorker = true;
+
+#ifdef SCORPION_PROFILER
+            profiler::SetThreadName("Job Worker");
+#endif
+
+            while (true) {
+                Batch* batch;
+
+                {
+                    std::unique_lock lock(mutex);
+                    wake.wait(lock, [this] { return stopping || !batches.empty(); });
+                    if (stopping) return;
+
+                    batch = batches.front();
+                    batch->users.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                while (batch->runOne()) {}
+
+                {
+                    std::lock_guard lock(mutex);
+                    retire(batch);
+                    batch->users.fetch_sub(1, std::memory_order_release);
+                }
+            }
+        }
+
+        // must hold the mutex
+        void retire(Batch* batch) {
+            auto it = std::find(batches.begin(), batches.end(), batch);
+            if (it != batches.end()) batches.erase(it);
+        }
+
+        void run(Batch& batch) {
+            submit(batch);
+            finish(batch);
+        }
+
+        void submit(Batch& batch) {
+            {
+                std::lock_guard lock(mutex);
+                batches.push_back(&batch);
+            }
+            wake.notify_all();
+        }
+
+        // the caller helps with whatever is left, then waits for the rest
+        void finish(Batch& batch) {
+            while (batch.runOne()) {}
+
+            {
+                std::lock_guard lock(mutex);
+                retire(&batch);
+            }
+
+            // nobody can pick the batch up anymore, wait for the ranges still in flight and for everyone to let go of it
+            while (batch.completed.load(std::memory_order_acquire) < batch.count || batch.users.load(std::memory_order_acquire) > 0) {
+                if (void (*callback)() = waitCallback.load(std::memory_order_acquire)) callback();
+                else std::this_thread::yield();
+            }
+        }
+    };
+
+    static JobSystem& GetJobSystem() {
+        static JobSystem system;
+        return system;
+    }
+
+    size_t GetWorkerCount() {
+        return GetJobSystem().workers.size();
+    }
+
+    bool IsWorkerThread() {
+        return isWorker;
+    }
+
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& fn) {
+        if (count == 0) return;
+        if (grainSize == 0) grainSize = 1;
+
+        if (isWorker || count <= grainSize || GetWorkerCount() == 0) {
+            fn(0, count);
+            return;
+        }
+
+        Batch batch;
+        batch.fn = &fn;
+        batch.count = count;
+        batch.grainSize = grainSize;
+
+        GetJobSystem().run(batch);
+    }
+
+    void SetWaitCallback(void (*callback)()) {
+        waitCallback.store(callback, std::memory_order_release);
+    }
+
+    AsyncFor::AsyncFor()
+        : mBatch(MakeUnique<Batch>()) {}
+
+    AsyncFor::~AsyncFor() {
+        wait();
+    }
+
+    void AsyncFor::start(size_t count, size_t grainSize, std::function<void(size_t begin, size_t end)> fn) {
+        wait();
+
+        if (count == 0) return;
+
+        mFn = std::move(fn);
+        mBatch->fn = &mFn;
+        mBatch->count = count;
+        mBatch->grainSize = grainSize > 0 ? grainSize : 1;
+        mBatch->next.store(0, std::memory_order_relaxed);
+        mBatch->completed.store(0, std::memory_order_relaxed);
+        mRunning = true;
+
+        // same rules as ParallelFor, except that running inline waits for wait
+        mSubmitted = !isWorker && GetWorkerCount() > 0;
+        if (mSubmitted) GetJobSystem().submit(*mBatch);
+    }
+
+    void AsyncFor::wait() {
+        if (!mRunning) return;
+
+        if (mSubmitted) {
+            GetJobSystem().finish(*mBatch);
+        } else {
+            while (mBatch->runOne()) {}
+        }
+
+        mRunning = false;
+        mFn = nullptr;
+    }
+}
@@ -5,6 +5,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static volatile size_t heapAllocationCount = 0;
+
 typedef struct ArenaChunk {
     size_t size;
     size_t used;
@@ -22,7 +28,7 @@ ScorpionArena* ScorpionCreateArena(size_t minimumChunkSize, size_t firstChunkSiz
     if (firstChunkSize < minimumChunkSize) firstChunkSize = minimumChunkSize;
 
     size_t offset = (sizeof(ScorpionArena) + 15) & ~((size_t)15);
-    size_t totalSize = offset + firstChunkSize;
+    size_t totalSize = offset + sizeof(ArenaChunk) + firstChunkSize;
 
     char* memory = ScorpionHeapAlloc(totalSize);
 
@@ -34,6 +40,7 @@ ScorpionArena* ScorpionCreateArena(size_t minimumChunkSize, size_t firstChunkSiz
     firstChunk->next = NULL;
 
     arena->head = firstChunk;
+    arena->current = firstChunk;
     arena->minimumChunkSize = minimumChunkSize;
 
     return arena;
@@ -43,12 +50,15 @@ void ScorpionDestroyArena(ScorpionArena* arena) {
     size_t offset = (sizeof(ScorpionArena) + 15) & ~((size_t)15);
     char* arenaChunk = (char*) arena + offset;
 
-    for (ArenaChunk* current = arena->head; current != NULL; current = current->next) {
+    ArenaChunk* current = arena->head;
+    while (current != NULL) {
         ArenaChunk* next = current->next;
 
         if ((char*) current != arenaChunk) {
-            ScorpionHeapFree(arenaChunk);
+            ScorpionHeapFree(current);
         }
+
+        current = next;
     }
 
     ScorpionHeapFree(arena);
@@ -64,6 +74,11 @@ void ScorpionArenaReset(ScorpionArena* arena) {
 void* ScorpionArenaAlloc(ScorpionArena* arena, size_t size) {
     size = (size + 7) & ~7;
 
+    // after a reset the old chunks are still chained, so reuse the next one if it fits
+    while (arena->current->used + size > arena->current->size && arena->current->next != NULL) {
+        arena->current = arena->current->next;
+    }
+
     if (arena->current->used + size > arena->current->size) {
         size_t newChunkSize = arena->minimumChunkSize;
         if (newChunkSize < size) newChunkSize += size;
@@ -72,7 +87,7 @@ void* ScorpionArenaAlloc(ScorpionArena* arena, size_t size) {
 
         newChunk->size = newChunkSize;
         newChunk->used = 0;
-        newChunk->next = NULL;
+        newChunk->next = arena->current->next;
 
         arena->current->next = newChunk;
         arena->current = newChunk;
@@ -83,7 +98,108 @@ void* ScorpionArenaAlloc(ScorpionArena* arena, size_t size) {
     return ptr;
 }
 
+typedef struct PoolBlock {
+    struct PoolBlock* next;
+} PoolBlock;
+
+typedef struct PoolChunk {
+    struct PoolChunk* next;
+    size_t count;
+} PoolChunk;
+
+struct ScorpionPool {
+    PoolChunk* chunks;
+    PoolBlock* freeList;
+    size_t blockSize;
+    size_t blocksPerChunk;
+    size_t freeCount;
+};
+
+static void PoolAddChunk(ScorpionPool* pool, size_t count) {
+    size_t offset = (sizeof(PoolChunk) + 15) & ~((size_t)15);
+    char* memory = ScorpionHeapAlloc(offset + pool->blockSize * count);
+
+    PoolChunk* chunk = (PoolChunk*)memory;
+    chunk->next = pool->chunks;
+    chunk->count = count;
+    pool->chunks = chunk;
+
+    // thread the blocks back to front so allocations walk the chunk in address order
+    char* data = memory + offset;
+    for (size_t i = count; i > 0; i--) {
+        PoolBlock* block = (PoolBlock*)(data + (i - 1) * pool->blockSize);
+        block->next = pool->freeList;
+        pool->freeList = block;
+    }
+
+    pool->freeCount += count;
+}
+
+ScorpionPool* ScorpionCreatePool(size_t blockSize, size_t blocksPerChunk) {
+    if (blockSize < sizeof(PoolBlock)) blockSize = sizeof(PoolBlock);
+    blockSize = (blockSize + 15) & ~((size_t)15);
+
+    if (blocksPerChunk == 0) blocksPerChunk = 1;
+
+    ScorpionPool* pool = ScorpionHeapAlloc(sizeof(ScorpionPool));
+    pool->chunks = NULL;
+    pool->freeList = NULL;
+    pool->blockSize = blockSize;
+    pool->blocksPerChunk = blocksPerChunk;
+    pool->freeCount = 0;
+
+    return pool;
+}
+
+void ScorpionDestroyPool(ScorpionPool* pool) {
+    PoolChunk* current = pool->chunks;
+    while (current != NULL) {
+        PoolChunk* next = current->next;
+        ScorpionHeapFree(current);
+        current = next;
+    }
+
+    ScorpionHeapFree(pool);
+}
+
+void ScorpionPoolReserve(ScorpionPool* pool, size_t count) {
+    if (pool->freeCount >= count) return;
+
+    PoolAddChunk(pool, count - pool->freeCount);
+}
+
+void* ScorpionPoolAlloc(ScorpionPool* pool) {
+    if (pool->freeList == NULL) {
+        PoolAddChunk(pool, pool->blocksPerChunk);
+    }
+
+    PoolBlock* block = pool->freeList;
+    pool->freeList = block->next;
+    pool->freeCount--;
+
+    return block;
+}
+
+void ScorpionPoolFree(ScorpionPool* pool, void* ptr) {
+    if (ptr == NULL) return;
+
+    PoolBlock* block = ptr;
+    block->next = pool->freeList;
+    pool->freeList = block;
+    pool->freeCount++;
+}
+
+size_t ScorpionPoolBlockSize(const ScorpionPool* pool) {
+    return pool->blockSize;
+}
+
 void* ScorpionHeapAlloc(size_t size) {
+#ifdef _MSC_VER
+    _InterlockedIncrement64((volatile __int64*)&heapAllocationCount);
+#else
+    __atomic_fetch_add(&heapAllocationCount, 1, __ATOMIC_RELAXED);
+#endif
+
     void* ptr = malloc(size);
     if (ptr == NULL) {
         //TODO: NICE ERROR SYSTEM RAHHH
@@ -100,3 +216,11 @@ void* ScorpionHeapRealloc(void* ptr, size_t size) {
 void ScorpionHeapFree(void* ptr) {
     free(ptr);
 }
+
+size_t ScorpionHeapAllocationCount(void) {
+#ifdef _MSC_VER
+    return (size_t)_InterlockedOr64((volatile __int64*)&heapAllocationCount, 0);
+#else
+    return __atomic_load_n(&heapAllocationCount, __ATOMIC_RELAXED);
+#endif
+}
@@ -0,0 +1,159 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include "scorpion/util/std_types.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace scorpion::profiler {
+    struct Zone {
+        const char* name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    // Oldest zones get overwritten once the ring is full
+    struct ThreadBuffer {
+        static constexpr size_t Capacity = 1 << 16;
+
+        uint32_t threadId;
+        std::atomic<const char*> name = nullptr;
+        std::atomic<uint64_t> written = 0;
+        Zone zones[Capacity];
+    };
+
+    struct ProfilerState {
+        std::atomic<bool> enabled = true;
+
+        std::mutex mutex;
+        Vector<UniquePtr<ThreadBuffer>> buffers;
+
+        uint64_t baseTicks = Now();
+        std::chrono::steady_clock::time_point baseTime = std::chrono::steady_clock::now();
+    };
+
+    static ProfilerState& GetState() {
+        static ProfilerState state;
+        return state;
+    }
+
+    // pins the timestamp base to startup so zones that began before the first Record don't end up negative
+    [[maybe_unused]] static ProfilerState& initialState = GetState();
+
+    static thread_local ThreadBuffer* threadBuffer = nullptr;
+
+    static ThreadBuffer* GetThreadBuffer() {
+        if (threadBuffer == nullptr) {
+            ProfilerState& state = GetState();
+            std::lock_guard lock(state.mutex);
+
+            UniquePtr<ThreadBuffer> buffer = MakeUnique<ThreadBuffer>();
+            buffer->threadId = static_cast<uint32_t>(state.buffers.size());
+
+            threadBuffer = buffer.get();
+            state.buffers.push_back(std::move(buffer));
+        }
+
+        return threadBuffer;
+    }
+
+    static double TicksPerMicrosecond() {
+#ifdef SCORPION_PROFILER_TSC
+        ProfilerState& state = GetState();
+
+        auto elapsed = std::chrono::steady_clock::now() - state.baseTime;
+        if (elapsed < std::chrono::milliseconds(10)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10) - elapsed);
+            elapsed = std::chrono::steady_clock::now() - state.baseTime;
+        }
+
+        double us = std::chrono::duration<double, std::micro>(elapsed).count();
+        return static_cast<double>(Now() - state.baseTicks) / us;
+#else
+        return 1000.0;
+#endif
+    }
+
+    static void WriteEscaped(FILE* file, const char* text) {
+        for (const char* c = text; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') fputc('\\', file);
+            fputc(*c, file);
+        }
+    }
+
+    bool IsEnabled() {
+        return GetState().enabled.load(std::memory_order_relaxed);
+    }
+
+    void SetEnabled(bool enabled) {
+        GetState().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void Record(const char* name, uint64_t start, uint64_t end) {
+        if (!IsEnabled()) return;
+
+        ThreadBuffer* buffer = GetThreadBuffer();
+        uint64_t index = buffer->written.load(std::memory_order_relaxed);
+
+        buffer->zones[index & (ThreadBuffer::Capacity - 1)] = { name, start, end };
+        buffer->written.store(index + 1, std::memory_order_release);
+    }
+
+    void SetThreadName(const char* name) {
+        GetThreadBuffer()->name.store(name, std::memory_order_release);
+    }
+
+    void Clear() {
+        ProfilerState& state = GetState();
+        std::lock_guard lock(state.mutex);
+
+        for (auto& buffer : state.buffers) {
+            buffer->written.store(0, std::memory_order_release);
+        }
+    }
+
+    bool ExportChromeTrace(const char* path) {
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) return false;
+
+        ProfilerState& state = GetState();
+        double ticksPerUs = TicksPerMicrosecond();
+
+        std::lock_guard lock(state.mutex);
+
+        fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+        bool first = true;
+
+        for (auto& buffer : state.buffers) {
+            if (const char* name = buffer->name.load(std::memory_order_acquire)) {
+                fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",\n", buffer->threadId);
+                WriteEscaped(file, name);
+                fputs("\"}}", file);
+                first = false;
+            }
+
+            uint64_t written = buffer->written.load(std::memory_order_acquire);
+            uint64_t begin = written > ThreadBuffer::Capacity ? written - ThreadBuffer::Capacity : 0;
+
+            for (uint64_t i = begin; i < written; i++) {
+                const Zone& zone = buffer->zones[i & (ThreadBuffer::Capacity - 1)];
+
+                double ts = static_cast<double>(static_cast<int64_t>(zone.start - state.baseTicks)) / ticksPerUs;
+                double dur = static_cast<double>(zone.end - zone.start) / ticksPerUs;
+
+                fprintf(file, "%s{\"name\":\"", first ? "" : ",\n");
+                WriteEscaped(file, zone.name);
+                fprintf(file, "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->threadId, ts, dur);
+                first = false;
+            }
+        }
+
+        fputs("\n]}\n", file);
+
+        return fclose(file) == 0;
+    }
+}
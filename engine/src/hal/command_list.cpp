@@ -0,0 +1,99 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include "scorpion/hal/command_list.h"
+
+#include <cstring>
+
+namespace scorpion::render {
+    static thread_local CommandList* currentList = nullptr;
+
+    void CommandList::begin(const CameraConstants& camera) {
+        mCamera = camera;
+        mPrevious = currentList;
+        currentList = this;
+    }
+
+    void CommandList::end() {
+        if (currentList == this) currentList = mPrevious;
+        mPrevious = nullptr;
+    }
+
+    void CommandList::submit() {
+        SCORPION_PROFILE_SCOPE("CommandList::submit");
+
+        for (const Entry& entry : mEntries) {
+            switch (entry.op) {
+                case Op::BindShader:
+                    entry.shader->begin();
+                    break;
+                case Op::UnbindShader:
+                    entry.shader->end();
+                    break;
+                case Op::SetUniform: {
+                    const uint8_t* value = mData.data() + entry.data;
+                    String name(reinterpret_cast<const char*>(value + GetUniformSize(entry.uniformType)), entry.nameLength);
+
+                    entry.shader->setUniform(name, entry.uniformType, value);
+                    break;
+                }
+                case Op::DrawCube:
+                    DrawCube(entry.position, entry.size, entry.rotation, entry.color);
+                    break;
+            }
+        }
+
+        // into the queue the 3D pass flushes, so instances of a mesh from every list still end up in one draw
+        QueueMeshes(mMeshes);
+        QueueSprites(mSprites);
+    }
+
+    void CommandList::clear() {
+        mEntries.clear();
+        mData.clear();
+        mMeshes.clear();
+        mSprites.clear();
+    }
+
+    CommandList* CommandList::getCurrent() {
+        return currentList;
+    }
+
+    void CommandList::bindShader(Shader* shader) {
+        Entry& entry = mEntries.emplace_back();
+        entry.op = Op::BindShader;
+        entry.shader = shader;
+    }
+
+    void CommandList::unbindShader(Shader* shader) {
+        Entry& entry = mEntries.emplace_back();
+        entry.op = Op::UnbindShader;
+        entry.shader = shader;
+    }
+
+    void CommandList::setUniform(Shader* shader, const String& name, UniformType type, const void* value) {
+        size_t valueSize = GetUniformSize(type);
+        size_t offset = (mData.size() + 3) & ~static_cast<size_t>(3); // values get read as floats and ints
+
+        mData.resize(offset + valueSize + name.size());
+        memcpy(mData.data() + offset, value, valueSize);
+        memcpy(mData.data() + offset + valueSize, name.data(), name.size());
+
+        Entry& entry = mEntries.emplace_back();
+        entry.op = Op::SetUniform;
+        entry.uniformType = type;
+        entry.data = static_cast<uint32_t>(offset);
+        entry.nameLength = static_cast<uint32_t>(name.size());
+        entry.shader = shader;
+    }
+
+    void CommandList::drawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color) {
+        Entry& entry = mEntries.emplace_back();
+        entry.op = Op::DrawCube;
+        entry.position = position;
+        entry.size = size;
+        entry.rotation = rotation;
+        entry.color = color;
+    }
+}
@@ -1,33 +1,522 @@
 // Copyright 2025 JesusTouchMe
 
+#include "scorpion/foundation/io/file.h"
+#include "scorpion/foundation/io/mapped_file.h"
+
 #include "scorpion/hal/input.h"
+#include "scorpion/hal/renderer.h"
 
 #include <raylib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
 namespace scorpion::input {
+    // Recording layout, everything little endian:
+    //   RecordingHeader | uint32 tick end[tickCount] | padding to 8 | EventRecord[eventCount]
+
+    static constexpr uint32_t RecordingMagic = 0x4E494353; // "SCIN"
+    static constexpr uint32_t RecordingVersion = 2;
+
+    struct RecordingHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t tickCount;
+        uint32_t reserved;
+        uint64_t eventCount;
+        uint64_t size;
+
+        // Recording::StartState
+        uint32_t startButtons;
+        float startPosition[2];
+        uint32_t reserved2;
+        uint64_t startKeys[KeyCount / 64];
+    };
+
+    // Event has padding in it, this doesn't
+    struct EventRecord {
+        uint32_t type;
+        uint32_t code;
+        double time;
+        float position[2];
+        float delta[2];
+    };
+
+    // whatever a tick sees, and what the window looked like at the last poll
+    struct InputState {
+        std::bitset<MouseButtonCount> buttons;
+        std::bitset<KeyCount> keys;
+        math::Vec2 position;
+    };
+
+    struct InputCore {
+        // power of two. At 1000 polls a second with a mouse moving that's a few seconds of nobody ticking
+        static constexpr size_t QueueCapacity = 4096;
+
+        std::mutex queueMutex;
+        Event queue[QueueCapacity];
+        uint64_t head = 0; // next one BeginTick takes
+        uint64_t tail = 0; // next free slot
+        std::atomic<uint64_t> dropped = 0;
+
+        InputState sampled;
+        bool sampledOnce = false;
+
+        std::atomic<int> pollRate = 1000;
+
+        Vector<Event> events; // the current tick's
+        InputState state;
+        std::bitset<MouseButtonCount> buttonsPressed;
+        std::bitset<MouseButtonCount> buttonsReleased;
+        std::bitset<KeyCount> keysPressed;
+        std::bitset<KeyCount> keysReleased;
+        math::Vec2 mouseDelta;
+        float wheel = 0.0f;
+
+        Recording* recording = nullptr;
+        double recordingStart = 0.0;
+        Vector<Event> recordingScratch;
+
+        const Recording* replay = nullptr;
+        uint32_t replayTick = 0;
+        double replayStart = 0.0;
+        bool resync = false; // the next tick picks up the window's state where it is, after a replay moved the tick's state elsewhere
+
+        // only with the lock held
+        void push(const Event& event) {
+            if (tail - head >= QueueCapacity) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            queue[tail++ & (QueueCapacity - 1)] = event;
+        }
+
+        void apply(const Event& event) {
+            state.position = event.position;
+
+            switch (event.type) {
+                case EventType::MouseButtonDown:
+                    if (event.code >= MouseButtonCount) break;
+                    state.buttons.set(event.code);
+                    buttonsPressed.set(event.code);
+                    break;
+                case EventType::MouseButtonUp:
+                    if (event.code >= MouseButtonCount) break;
+                    state.buttons.reset(event.code);
+                    buttonsReleased.set(event.code);
+                    break;
+                case EventType::MouseMove:
+                    mouseDelta = mouseDelta + event.delta;
+                    break;
+                case EventType::MouseWheel:
+                    wheel += event.delta.y;
+                    break;
+                case EventType::KeyDown:
+                    if (event.code >= KeyCount) break;
+                    state.keys.set(event.code);
+                    keysPressed.set(event.code);
+                    break;
+                case EventType::KeyUp:
+                    if (event.code >= KeyCount) break;
+                    state.keys.reset(event.code);
+                    keysReleased.set(event.code);
+                    break;
+            }
+        }
+    };
+
+    static InputCore core;
+
+    void Recording::clear() {
+        mStart = {};
+        mEvents.clear();
+        mTickEnds.clear();
+    }
+
+    void Recording::addTick(const Event* events, size_t count) {
+        mEvents.insert(mEvents.end(), events, events + count);
+        mTickEnds.push_back(static_cast<uint32_t>(mEvents.size()));
+    }
+
+    const Event* Recording::getTick(uint32_t tick, size_t& count) const {
+        if (tick >= mTickEnds.size()) {
+            count = 0;
+            return nullptr;
+        }
+
+        uint32_t begin = tick > 0 ? mTickEnds[tick - 1] : 0;
+        count = mTickEnds[tick] - begin;
+
+        return mEvents.data() + begin;
+    }
+
+    bool Recording::assign(const uint8_t* data, size_t size) {
+        if (data == nullptr || size < sizeof(RecordingHeader)) return false;
+
+        RecordingHeader header;
+        memcpy(&header, data, sizeof(header));
+
+        if (header.magic != RecordingMagic || header.version != RecordingVersion || header.size != size) return false;
+
+        size_t eventsOffset = io::Pad(sizeof(RecordingHeader) + header.tickCount * sizeof(uint32_t));
+        if (header.eventCount > (size - std::min(size, eventsOffset)) / sizeof(EventRecord)) return false;
+        if (eventsOffset + header.eventCount * sizeof(EventRecord) != size) return false;
+
+        Vector<uint32_t> tickEnds(header.tickCount);
+        memcpy(tickEnds.data(), data + sizeof(RecordingHeader), header.tickCount * sizeof(uint32_t));
+
+        // every tick has to end where the next one starts or later, and the last one at the end
+        uint32_t previous = 0;
+        for (uint32_t end : tickEnds) {
+            if (end < previous || end > header.eventCount) return false;
+            previous = end;
+        }
+
+        if (previous != header.eventCount) return false;
+
+        Vector<Event> events(header.eventCount);
+        for (size_t i = 0; i < events.size(); i++) {
+            EventRecord record;
+            memcpy(&record, data + eventsOffset + i * sizeof(EventRecord), sizeof(record));
+
+            events[i].type = static_cast<EventType>(record.type);
+            events[i].code = record.code;
+            events[i].time = record.time;
+            events[i].position = math::Vec2(record.position[0], record.position[1]);
+            events[i].delta = math::Vec2(record.delta[0], record.delta[1]);
+        }
+
+        mStart.buttons = header.startButtons;
+        mStart.position = math::Vec2(header.startPosition[0], header.startPosition[1]);
+        memcpy(mStart.keys, header.startKeys, sizeof(mStart.keys));
+
+        mEvents = std::move(events);
+        mTickEnds = std::move(tickEnds);
+
+        return true;
+    }
+
+    void Recording::serialize(Vector<uint8_t>& data) const {
+        size_t eventsOffset = io::Pad(sizeof(RecordingHeader) + mTickEnds.size() * sizeof(uint32_t));
+        size_t size = eventsOffset + mEvents.size() * sizeof(EventRecord);
+
+        data.assign(size, 0);
+
+        RecordingHeader header = {};
+        header.magic = RecordingMagic;
+        header.version = RecordingVersion;
+        header.tickCount = static_cast<uint32_t>(mTickEnds.size());
+        header.eventCount = mEvents.size();
+        header.size = size;
+        header.startButtons = mStart.buttons;
+        header.startPosition[0] = mStart.position.x;
+        header.startPosition[1] = mStart.position.y;
+        memcpy(header.startKeys, mStart.keys, sizeof(header.startKeys));
+
+        memcpy(data.data(), &header, sizeof(header));
+        memcpy(data.data() + sizeof(header), mTickEnds.data(), mTickEnds.size() * sizeof(uint32_t));
+
+        for (size_t i = 0; i < mEvents.size(); i++) {
+            const Event& event = mEvents[i];
+
+            EventRecord record = {};
+            record.type = static_cast<uint32_t>(event.type);
+            record.code = event.code;
+            record.time = event.time;
+            record.position[0] = event.position.x;
+            record.position[1] = event.position.y;
+            record.delta[0] = event.delta.x;
+            record.delta[1] = event.delta.y;
+
+            memcpy(data.data() + eventsOffset + i * sizeof(EventRecord), &record, sizeof(record));
+        }
+    }
+
+    bool Recording::save(const char* path) const {
+        Vector<uint8_t> data;
+        serialize(data);
+
+        return io::WriteFile(path, data.data(), data.size());
+    }
+
+    bool Recording::load(const char* path) {
+        io::MappedFile file;
+        if (!file.open(path)) return false;
+
+        return assign(file.data(), file.size());
+    }
+
+    double GetTime() {
+        static const auto start = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void Poll() {
+        if (render::IsHeadless() || !::IsWindowReady()) return;
+
+        ::PollInputEvents();
+        SampleWindow();
+    }
+
+    void SampleWindow() {
+        if (render::IsHeadless() || !::IsWindowReady()) return;
+
+        Vector2 mouse = ::GetMousePosition();
+        float wheel = ::GetMouseWheelMove();
+
+        InputState current;
+        current.position = math::Vec2(mouse.x, mouse.y);
+
+        for (uint32_t button = 0; button < MouseButtonCount; button++) {
+            if (::IsMouseButtonDown(static_cast<int>(button))) current.buttons.set(button);
+        }
+
+        for (uint32_t key = 0; key < KeyCount; key++) {
+            if (::IsKeyDown(static_cast<int>(key))) current.keys.set(key);
+        }
+
+        InputState& sampled = core.sampled;
+
+        // the first look only sets the baseline, otherwise startup would see the mouse jump from the corner and every held key go down
+        if (!core.sampledOnce) {
+            sampled = current;
+            core.sampledOnce = true;
+            return;
+        }
+
+        Event event;
+        event.time = GetTime();
+        event.position = current.position;
+
+        std::lock_guard lock(core.queueMutex);
+
+        if (current.position.x != sampled.position.x || current.position.y != sampled.position.y) {
+            event.type = EventType::MouseMove;
+            event.delta = current.position - sampled.position;
+            core.push(event);
+        }
+
+        event.delta = math::Vec2::zero;
+
+        if (current.buttons != sampled.buttons) {
+            for (uint32_t button = 0; button < MouseButtonCount; button++) {
+                if (current.buttons.test(button) == sampled.buttons.test(button)) continue;
+
+                event.type = current.buttons.test(button) ? EventType::MouseButtonDown : EventType::MouseButtonUp;
+                event.code = button;
+                core.push(event);
+            }
+        }
+
+        if (current.keys != sampled.keys) {
+            for (uint32_t key = 0; key < KeyCount; key++) {
+                if (current.keys.test(key) == sampled.keys.test(key)) continue;
+
+                event.type = current.keys.test(key) ? EventType::KeyDown : EventType::KeyUp;
+                event.code = key;
+                core.push(event);
+            }
+        }
+
+        // the wheel is a per pump amount, not a state, so there's nothing to diff against
+        if (wheel != 0.0f) {
+            event.type = EventType::MouseWheel;
+            event.code = 0;
+            event.delta = math::Vec2(0.0f, wheel);
+            core.push(event);
+        }
+
+        sampled = current;
+    }
+
+    int GetPollRate() {
+        return core.pollRate.load(std::memory_order_relaxed);
+    }
+
+    void SetPollRate(int hz) {
+        core.pollRate.store(std::max(hz, 0), std::memory_order_relaxed);
+    }
+
+    void PushEvent(const Event& event) {
+        std::lock_guard lock(core.queueMutex);
+        core.push(event);
+    }
+
+    void BeginTick() {
+        Poll();
+
+        core.events.clear();
+
+        {
+            std::lock_guard lock(core.queueMutex);
+
+            // while replaying the window's events are thrown away, they'd fight with the recorded ones
+            if (core.replay == nullptr) {
+                for (; core.head != core.tail; core.head++) {
+                    core.events.push_back(core.queue[core.head & (InputCore::QueueCapacity - 1)]);
+                }
+            } else {
+                core.head = core.tail;
+            }
+        }
+
+        if (core.resync) {
+            core.state = core.sampled;
+            core.resync = false;
+        }
+
+        if (core.replay != nullptr) {
+            size_t count;
+            const Event* events = core.replay->getTick(core.replayTick++, count);
+
+            for (size_t i = 0; i < count; i++) {
+                Event& event = core.events.emplace_back(events[i]);
+                event.time += core.replayStart;
+            }
+
+            if (core.replayTick >= core.replay->getTickCount()) StopReplay();
+        }
+
+        core.buttonsPressed.reset();
+        core.buttonsReleased.reset();
+        core.keysPressed.reset();
+        core.keysReleased.reset();
+        core.mouseDelta = math::Vec2::zero;
+        core.wheel = 0.0f;
+
+        for (const Event& event : core.events) {
+            core.apply(event);
+        }
+
+        if (core.recording != nullptr) {
+            core.recordingScratch.assign(core.events.begin(), core.events.end());
+            for (Event& event : core.recordingScratch) {
+                event.time -= core.recordingStart;
+            }
+
+            core.recording->addTick(core.recordingScratch.data(), core.recordingScratch.size());
+        }
+    }
+
+    const Vector<Event>& GetEvents() {
+        return core.events;
+    }
+
+    uint64_t GetDroppedEvents() {
+        return core.dropped.load(std::memory_order_relaxed);
+    }
+
+    void StartRecording(Recording* recording) {
+        core.recording = recording;
+        core.recordingStart = GetTime();
+
+        if (recording == nullptr) return;
+
+        recording->clear();
+
+        // whatever the next tick starts from, after a replay that's the window again
+        const InputState& state = core.resync ? core.sampled : core.state;
+
+        Recording::StartState start;
+        start.buttons = static_cast<uint32_t>(state.buttons.to_ulong());
+        start.position = state.position;
+
+        for (uint32_t key = 0; key < KeyCount; key++) {
+            if (state.keys.test(key)) start.keys[key / 64] |= 1ull << (key % 64);
+        }
+
+        recording->setStartState(start);
+    }
+
+    void StopRecording() {
+        core.recording = nullptr;
+    }
+
+    bool IsRecording() {
+        return core.recording != nullptr;
+    }
+
+    void StartReplay(const Recording* recording) {
+        if (core.replay != nullptr) StopReplay();
+        if (recording == nullptr || recording->isEmpty()) return;
+
+        core.replay = recording;
+        core.replayTick = 0;
+        core.replayStart = GetTime();
+
+        // held keys and buttons and the mouse position have to match the recording's from the first tick on, not the window's
+        const Recording::StartState& start = recording->getStartState();
+
+        core.state.buttons = std::bitset<MouseButtonCount>(start.buttons);
+        core.state.position = start.position;
+        core.state.keys.reset();
+
+        for (uint32_t key = 0; key < KeyCount; key++) {
+            if ((start.keys[key / 64] >> (key % 64)) & 1) core.state.keys.set(key);
+        }
+
+        core.buttonsPressed.reset();
+        core.buttonsReleased.reset();
+        core.keysPressed.reset();
+        core.keysReleased.reset();
+        core.mouseDelta = math::Vec2::zero;
+        core.wheel = 0.0f;
+
+        core.resync = false; // stopping an earlier replay asked for one
+    }
+
+    void StopReplay() {
+        if (core.replay == nullptr) return;
+
+        core.replay = nullptr;
+        core.resync = true;
+    }
+
+    bool IsReplaying() {
+        return core.replay != nullptr;
+    }
+
     bool IsMouseButtonPressed(MouseButton button) {
-        return ::IsMouseButtonPressed(static_cast<int>(button));
+        auto index = static_cast<uint32_t>(button);
+        return index < MouseButtonCount && core.buttonsPressed.test(index);
     }
 
     bool IsMouseButtonDown(MouseButton button) {
-        return ::IsMouseButtonDown(static_cast<int>(button));
+        auto index = static_cast<uint32_t>(button);
+        return index < MouseButtonCount && core.state.buttons.test(index);
     }
 
     bool IsMouseButtonReleased(MouseButton button) {
-        return ::IsMouseButtonReleased(static_cast<int>(button));
+        auto index = static_cast<uint32_t>(button);
+        return index < MouseButtonCount && core.buttonsReleased.test(index);
     }
 
     math::Vec2 GetMousePosition() {
-        Vector2 rlVec = ::GetMousePosition();
-        return {rlVec.x, rlVec.y};
+        return core.state.position;
     }
 
     math::Vec2 GetMousePositionDelta() {
-        Vector2 rlVec = ::GetMouseDelta();
-        return {rlVec.x, rlVec.y};
+        return core.mouseDelta;
     }
 
     float GetMouseWheel() {
-        return ::GetMouseWheelMove();
+        return core.wheel;
+    }
+
+    bool IsKeyPressed(int key) {
+        return key >= 0 && key < static_cast<int>(KeyCount) && core.keysPressed.test(key);
+    }
+
+    bool IsKeyDown(int key) {
+        return key >= 0 && key < static_cast<int>(KeyCount) && core.state.keys.test(key);
+    }
+
+    bool IsKeyReleased(int key) {
+        return key >= 0 && key < static_cast<int>(KeyCount) && core.keysReleased.test(key);
     }
 }
@@ -0,0 +1,312 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/stats.h"
+
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include "scorpion/hal/command_list.h"
+#include "scorpion/hal/mesh.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace scorpion::render {
+    void Mesh::Range::add(uint32_t first, uint32_t count) {
+        begin = std::min(begin, first);
+        end = std::max(end, first + count);
+    }
+
+    static void GrowBounds(AABB& bounds, const Vertex* vertices, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            const math::Vec3& position = vertices[i].position;
+
+            bounds.min = math::Vec3(std::min(bounds.min.x, position.x), std::min(bounds.min.y, position.y), std::min(bounds.min.z, position.z));
+            bounds.max = math::Vec3(std::max(bounds.max.x, position.x), std::max(bounds.max.y, position.y), std::max(bounds.max.z, position.z));
+        }
+    }
+
+    Mesh::Mesh(const Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount, Usage usage)
+        : mUsage(usage)
+        , mVertexCount(vertexCount)
+        , mIndexCount(indices != nullptr ? indexCount : 0)
+        , mBounds{ math::Vec3(FLT_MAX, FLT_MAX, FLT_MAX), math::Vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX) } {
+        mHandle = GetBackend()->createMesh(vertices, vertexCount, indices, mIndexCount, usage == Usage::Dynamic);
+
+        GrowBounds(mBounds, vertices, vertexCount);
+        if (vertexCount == 0) mBounds = {};
+
+        if (usage == Usage::Dynamic) {
+            mVertices.assign(vertices, vertices + vertexCount);
+            if (indices != nullptr) mIndices.assign(indices, indices + indexCount);
+        }
+    }
+
+    Mesh::~Mesh() {
+        GetBackend()->destroyMesh(mHandle);
+    }
+
+    Mesh::Usage Mesh::getUsage() const {
+        return mUsage;
+    }
+
+    uint32_t Mesh::getVertexCount() const {
+        return mVertexCount;
+    }
+
+    uint32_t Mesh::getIndexCount() const {
+        return mIndexCount;
+    }
+
+    const AABB& Mesh::getBounds() const {
+        return mBounds;
+    }
+
+    const Vertex* Mesh::getVertices() const {
+        return mUsage == Usage::Dynamic ? mVertices.data() : nullptr;
+    }
+
+    const uint16_t* Mesh::getIndices() const {
+        return mUsage == Usage::Dynamic ? mIndices.data() : nullptr;
+    }
+
+    void Mesh::setVertices(uint32_t first, const Vertex* vertices, uint32_t count) {
+        if (mUsage != Usage::Dynamic || count == 0 || first + count > mVertexCount) return;
+
+        std::copy(vertices, vertices + count, mVertices.begin() + first);
+        mDirtyVertices.add(first, count);
+
+        GrowBounds(mBounds, vertices, count);
+    }
+
+    void Mesh::setIndices(uint32_t first, const uint16_t* indices, uint32_t count) {
+        if (mUsage != Usage::Dynamic || count == 0 || first + count > mIndexCount) return;
+
+        std::copy(indices, indices + count, mIndices.begin() + first);
+        mDirtyIndices.add(first, count);
+    }
+
+    void Mesh::upload() {
+        // one upload covering every edit since the last frame, even if a few untouched vertices in between go along
+        if (!mDirtyVertices.empty()) {
+            GetBackend()->updateMeshVertices(mHandle, mDirtyVertices.begin, mVertices.data() + mDirtyVertices.begin, mDirtyVertices.end - mDirtyVertices.begin);
+            mDirtyVertices = {};
+        }
+
+        if (!mDirtyIndices.empty()) {
+            GetBackend()->updateMeshIndices(mHandle, mDirtyIndices.begin, mIndices.data() + mDirtyIndices.begin, mDirtyIndices.end - mDirtyIndices.begin);
+            mDirtyIndices = {};
+        }
+    }
+
+    void* Mesh::getHandle() const {
+        return mHandle;
+    }
+
+    SharedPtr<Mesh> CreateMesh(const Vector<Vertex>& vertices, const Vector<uint16_t>& indices, Mesh::Usage usage) {
+        return MakeShared<Mesh>(vertices.data(), static_cast<uint32_t>(vertices.size()), indices.empty() ? nullptr : indices.data(), static_cast<uint32_t>(indices.size()), usage);
+    }
+
+    // held from init to close, a weak ref let the last user free the buffers on whatever thread that happened to be on.
+    // Leaked on purpose, without a CloseWindow static destruction would free them after the window is gone
+    struct SharedMeshes {
+        SharedPtr<Mesh> cube;
+        SharedPtr<Shader> instanced;
+    };
+
+    static SharedMeshes* sharedMeshes = new SharedMeshes();
+
+    static SharedPtr<Mesh> MakeCubeMesh() {
+        struct Face {
+            math::Vec3 normal;
+            math::Vec3 u;
+            math::Vec3 v;
+        };
+
+        // u x v == normal, so every face winds counter clockwise seen from outside
+        static const Face faces[6] = {
+            { { 0, 0, 1 }, { 1, 0, 0 }, { 0, 1, 0 } },
+            { { 0, 0, -1 }, { -1, 0, 0 }, { 0, 1, 0 } },
+            { { 1, 0, 0 }, { 0, 0, -1 }, { 0, 1, 0 } },
+            { { -1, 0, 0 }, { 0, 0, 1 }, { 0, 1, 0 } },
+            { { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, -1 } },
+            { { 0, -1, 0 }, { 1, 0, 0 }, { 0, 0, 1 } },
+        };
+
+        static const math::Vec2 corners[4] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+
+        Vector<Vertex> vertices;
+        Vector<uint16_t> indices;
+
+        for (const Face& face : faces) {
+            auto base = static_cast<uint16_t>(vertices.size());
+
+            for (const math::Vec2& corner : corners) {
+                math::Vec3 position = face.normal * 0.5f + face.u * (corner.x - 0.5f) + face.v * (corner.y - 0.5f);
+                vertices.push_back({ position, corner, face.normal, math::Color::white });
+            }
+
+            for (uint16_t index : { 0, 1, 2, 0, 2, 3 }) {
+                indices.push_back(base + index);
+            }
+        }
+
+        return CreateMesh(vertices, indices);
+    }
+
+    static const char* instancedVertexShader = R"(
+#version 330
+in vec3 vertexPosition;
+in vec3 vertexNormal;
+in mat4 instanceTransform;
+in vec4 instanceColor;
+uniform mat4 mvp;
+out vec4 fragColor;
+void main() {
+    vec3 normal = normalize(mat3(instanceTransform) * vertexNormal);
+    float light = 0.6 + 0.4 * max(dot(normal, normalize(vec3(0.4, 1.0, 0.3))), 0.0);
+    fragColor = vec4(instanceColor.rgb * light, instanceColor.a);
+    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);
+}
+)";
+
+    static const char* instancedFragmentShader = R"(
+#version 330
+in vec4 fragColor;
+out vec4 finalColor;
+void main() {
+    finalColor = fragColor;
+}
+)";
+
+    SharedPtr<Mesh> GetCubeMesh() {
+        return sharedMeshes->cube;
+    }
+
+    SharedPtr<Shader> GetInstancedShader() {
+        return sharedMeshes->instanced;
+    }
+
+    void CreateSharedMeshes() {
+        if (sharedMeshes->cube == nullptr) sharedMeshes->cube = MakeCubeMesh();
+        if (sharedMeshes->instanced == nullptr) sharedMeshes->instanced = CompileShader(instancedVertexShader, instancedFragmentShader);
+    }
+
+    void ReleaseSharedMeshes() {
+        sharedMeshes->cube = nullptr;
+        sharedMeshes->instanced = nullptr;
+    }
+
+    MeshQueue::Batch& MeshQueue::find(Mesh* mesh, Shader* shader) {
+        // consecutive draws mostly hit the same batch, everything else is a short linear search
+        if (mLastBatch < mBatchCount && mBatches[mLastBatch].mesh == mesh && mBatches[mLastBatch].shader == shader) return mBatches[mLastBatch];
+
+        mLastBatch = 0;
+        while (mLastBatch < mBatchCount && (mBatches[mLastBatch].mesh != mesh || mBatches[mLastBatch].shader != shader)) mLastBatch++;
+
+        if (mLastBatch == mBatchCount) {
+            if (mBatchCount == mBatches.size()) mBatches.emplace_back();
+
+            Batch& batch = mBatches[mBatchCount++];
+            batch.mesh = mesh;
+            batch.shader = shader;
+            batch.instances.clear();
+        }
+
+        return mBatches[mLastBatch];
+    }
+
+    void MeshQueue::add(Mesh* mesh, Shader* shader, const math::Matrix4& transform, math::Color color) {
+        if (mesh == nullptr) return;
+
+        find(mesh, shader).instances.push_back({ transform, color });
+    }
+
+    void MeshQueue::add(Mesh* mesh, Shader* shader, const MeshInstance* instances, uint32_t count) {
+        if (mesh == nullptr || count == 0) return;
+
+        Vector<MeshInstance>& batch = find(mesh, shader).instances;
+        batch.insert(batch.end(), instances, instances + count);
+    }
+
+    void MeshQueue::appendTo(MeshQueue& other) {
+        for (size_t i = 0; i < mBatchCount; i++) {
+            Batch& batch = mBatches[i];
+
+            Vector<MeshInstance>& instances = other.find(batch.mesh, batch.shader).instances;
+            instances.insert(instances.end(), batch.instances.begin(), batch.instances.end());
+
+            batch.instances.clear();
+        }
+
+        mBatchCount = 0;
+        mLastBatch = 0;
+    }
+
+    void MeshQueue::flush() {
+        if (mBatchCount == 0) return;
+
+        SCORPION_PROFILE_SCOPE("render::FlushMeshes");
+
+        Backend* backend = GetBackend();
+
+        for (size_t i = 0; i < mBatchCount; i++) {
+            Batch& batch = mBatches[i];
+            auto count = static_cast<uint32_t>(batch.instances.size());
+
+            batch.mesh->upload();
+
+            uint32_t elements = batch.mesh->getIndexCount() > 0 ? batch.mesh->getIndexCount() : batch.mesh->getVertexCount();
+
+            stats::Add(stats::Stat::DrawCalls);
+            stats::Add(stats::Stat::TrianglesSubmitted, static_cast<uint64_t>(elements / 3) * count);
+
+            if (batch.shader != nullptr) batch.shader->begin();
+            backend->drawMesh(batch.mesh->getHandle(), batch.instances.data(), count);
+            if (batch.shader != nullptr) batch.shader->end();
+
+            batch.mesh = nullptr;
+            batch.shader = nullptr;
+            batch.instances.clear();
+        }
+
+        mBatchCount = 0;
+        mLastBatch = 0;
+    }
+
+    void MeshQueue::clear() {
+        for (size_t i = 0; i < mBatchCount; i++) {
+            mBatches[i].instances.clear();
+        }
+
+        mBatchCount = 0;
+        mLastBatch = 0;
+    }
+
+    static MeshQueue meshQueue;
+
+    void DrawMesh(Mesh* mesh, Shader* shader, const math::Matrix4& transform, math::Color color) {
+        if (CommandList* list = CommandList::getCurrent()) {
+            list->getMeshes().add(mesh, shader, transform, color);
+            return;
+        }
+
+        meshQueue.add(mesh, shader, transform, color);
+    }
+
+    void DrawMeshInstances(Mesh* mesh, Shader* shader, const MeshInstance* instances, uint32_t count) {
+        if (CommandList* list = CommandList::getCurrent()) {
+            list->getMeshes().add(mesh, shader, instances, count);
+            return;
+        }
+
+        meshQueue.add(mesh, shader, instances, count);
+    }
+
+    void FlushMeshes() {
+        meshQueue.flush();
+    }
+
+    void QueueMeshes(MeshQueue& queue) {
+        queue.appendTo(meshQueue);
+    }
+}
@@ -0,0 +1,592 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/hal/null_backend.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace scorpion::render {
+    NullBackend::NullBackend(int width, int height)
+        : mWidth(width)
+        , mHeight(height) {}
+
+    const char* NullBackend::getName() const {
+        return "Null";
+    }
+
+    bool NullBackend::isHeadless() const {
+        return true;
+    }
+
+    void NullBackend::initWindow(int width, int height, const char* title) {
+        mWidth = width;
+        mHeight = height;
+        mCloseRequested = false;
+    }
+
+    void NullBackend::closeWindow() {
+        for (ShaderEntry& shader : mShaders) {
+            shader.alive = false;
+        }
+
+        for (MeshEntry& mesh : mMeshes) {
+            mesh.alive = false;
+        }
+
+        for (RenderTargetEntry& target : mRenderTargets) {
+            target.alive = false;
+        }
+
+        for (TextureEntry& texture : mTextures) {
+            texture.alive = false;
+            texture.pixels = {};
+        }
+    }
+
+    bool NullBackend::windowShouldClose() {
+        return mCloseRequested;
+    }
+
+    int NullBackend::getWindowWidth() {
+        return mWidth;
+    }
+
+    int NullBackend::getWindowHeight() {
+        return mHeight;
+    }
+
+    bool NullBackend::isCursorVisible() {
+        return mCursorVisible;
+    }
+
+    void NullBackend::setCursorVisible(bool visible) {
+        mCursorVisible = visible;
+    }
+
+    void* NullBackend::compileShader(const char* vShaderCode, const char* fShaderCode) {
+        ShaderEntry& entry = mShaders.emplace_back();
+        entry.vertexSource = vShaderCode;
+        entry.fragmentSource = fShaderCode;
+
+        mCounters.shadersCompiled++;
+
+        uint32_t id = static_cast<uint32_t>(mShaders.size() - 1);
+        if (mRecording) recordShader(id);
+
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(id + 1));
+    }
+
+    // the "binary" is just both sources back to back, enough to round trip through the disk cache
+    static constexpr uint32_t NullBinaryFormat = 0x4C4C554E; // "NULL"
+
+    bool NullBackend::getShaderBinary(void* shader, Vector<uint8_t>& binary, uint32_t& format) {
+        ShaderEntry* entry = getShader(shader, nullptr);
+        if (entry == nullptr) return false;
+
+        binary.clear();
+        binary.insert(binary.end(), entry->vertexSource.begin(), entry->vertexSource.end());
+        binary.push_back(0);
+        binary.insert(binary.end(), entry->fragmentSource.begin(), entry->fragmentSource.end());
+        format = NullBinaryFormat;
+
+        return true;
+    }
+
+    void* NullBackend::loadShaderBinary(const uint8_t* binary, size_t size, uint32_t format) {
+        if (format != NullBinaryFormat) return nullptr;
+
+        const char* begin = reinterpret_cast<const char*>(binary);
+        const char* separator = static_cast<const char*>(memchr(begin, 0, size));
+        if (separator == nullptr) return nullptr;
+
+        ShaderEntry& entry = mShaders.emplace_back();
+        entry.vertexSource.assign(begin, separator);
+        entry.fragmentSource.assign(separator + 1, begin + size);
+
+        mCounters.shaderBinariesLoaded++;
+
+        uint32_t id = static_cast<uint32_t>(mShaders.size() - 1);
+        if (mRecording) recordShader(id);
+
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(id + 1));
+    }
+
+    void NullBackend::destroyShader(void* shader) {
+        uint32_t id;
+        ShaderEntry* entry = getShader(shader, &id);
+        if (entry == nullptr) return;
+
+        // nothing to destroy on replay if the stream never compiled it
+        if (mRecording && entry->recorded) {
+            record(CommandType::DestroyShader)->shader = id;
+        }
+
+        entry->alive = false;
+        entry->uniforms = {};
+        entry->attribs = {};
+        entry->uniformStrings = {};
+    }
+
+    void NullBackend::bindShader(void* shader) {
+        uint32_t id;
+        if (getShader(shader, &id) == nullptr) return;
+
+        mCounters.shaderBinds++;
+
+        if (mRecording) {
+            recordShader(id);
+            record(CommandType::BindShader)->shader = id;
+        }
+    }
+
+    void NullBackend::unbindShader() {
+        record(CommandType::UnbindShader);
+    }
+
+    int NullBackend::getUniformLocation(void* shader, const char* name) {
+        ShaderEntry* entry = getShader(shader, nullptr);
+        if (entry == nullptr) return -1;
+
+        for (size_t i = 0; i < entry->uniforms.size(); i++) {
+            if (entry->uniforms[i] == name) return static_cast<int>(i);
+        }
+
+        // any name is a valid uniform here so callers behave exactly like they would with a real shader
+        entry->uniforms.emplace_back(name);
+        entry->uniformStrings.push_back(UINT32_MAX);
+        return static_cast<int>(entry->uniforms.size() - 1);
+    }
+
+    int NullBackend::getAttribLocation(void* shader, const char* name) {
+        ShaderEntry* entry = getShader(shader, nullptr);
+        if (entry == nullptr) return -1;
+
+        for (size_t i = 0; i < entry->attribs.size(); i++) {
+            if (entry->attribs[i] == name) return static_cast<int>(i);
+        }
+
+        entry->attribs.emplace_back(name);
+        return static_cast<int>(entry->attribs.size() - 1);
+    }
+
+    void NullBackend::setUniform(void* shader, int location, UniformType type, const void* value) {
+        uint32_t id;
+        ShaderEntry* entry = getShader(shader, &id);
+        if (entry == nullptr || location < 0 || static_cast<size_t>(location) >= entry->uniforms.size()) return;
+
+        mCounters.uniformUploads++;
+
+        if (!mRecording) return;
+
+        recordShader(id);
+
+        uint32_t& name = entry->uniformStrings[location];
+        if (name == UINT32_MAX) name = mCommands.addString(entry->uniforms[location].c_str());
+
+        Command* command = record(CommandType::SetUniform);
+        command->shader = id;
+        command->name = name;
+        command->uniformType = type;
+        memcpy(command->uniform, value, GetUniformSize(type));
+    }
+
+    void* NullBackend::createMesh(const Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount, bool dynamic) {
+        MeshEntry& entry = mMeshes.emplace_back();
+        entry.vertices.assign(vertices, vertices + vertexCount);
+        if (indices != nullptr) entry.indices.assign(indices, indices + indexCount);
+        entry.dynamic = dynamic;
+
+        mCounters.meshesCreated++;
+        mCounters.meshBytesUploaded += vertexCount * sizeof(Vertex) + entry.indices.size() * sizeof(uint16_t);
+
+        uint32_t id = static_cast<uint32_t>(mMeshes.size() - 1);
+        if (mRecording) recordMesh(id);
+
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(id + 1));
+    }
+
+    void NullBackend::updateMeshVertices(void* mesh, uint32_t first, const Vertex* vertices, uint32_t count) {
+        uint32_t id;
+        MeshEntry* entry = getMesh(mesh, &id);
+        if (entry == nullptr || first + count > entry->vertices.size()) return;
+
+        std::copy(vertices, vertices + count, entry->vertices.begin() + first);
+        mCounters.meshBytesUploaded += count * sizeof(Vertex);
+
+        // not recorded yet means the create command picks up the new data anyway
+        if (mRecording && entry->recorded) {
+            Command* command = record(CommandType::UpdateMeshVertices);
+            command->mesh = id;
+            command->first = first;
+            command->count = count;
+            command->data = mCommands.addData(vertices, count * sizeof(Vertex));
+        }
+    }
+
+    void NullBackend::updateMeshIndices(void* mesh, uint32_t first, const uint16_t* indices, uint32_t count) {
+        uint32_t id;
+        MeshEntry* entry = getMesh(mesh, &id);
+        if (entry == nullptr || first + count > entry->indices.size()) return;
+
+        std::copy(indices, indices + count, entry->indices.begin() + first);
+        mCounters.meshBytesUploaded += count * sizeof(uint16_t);
+
+        if (mRecording && entry->recorded) {
+            Command* command = record(CommandType::UpdateMeshIndices);
+            command->mesh = id;
+            command->first = first;
+            command->count = count;
+            command->data = mCommands.addData(indices, count * sizeof(uint16_t));
+        }
+    }
+
+    void NullBackend::destroyMesh(void* mesh) {
+        uint32_t id;
+        MeshEntry* entry = getMesh(mesh, &id);
+        if (entry == nullptr) return;
+
+        if (mRecording && entry->recorded) {
+            record(CommandType::DestroyMesh)->mesh = id;
+        }
+
+        entry->alive = false;
+        entry->vertices = {};
+        entry->indices = {};
+    }
+
+    void NullBackend::drawMesh(void* mesh, const MeshInstance* instances, uint32_t count) {
+        uint32_t id;
+        MeshEntry* entry = getMesh(mesh, &id);
+        if (entry == nullptr || count == 0) return;
+
+        size_t elements = entry->indices.empty() ? entry->vertices.size() : entry->indices.size();
+
+        mCounters.drawCalls++;
+        mCounters.triangles += elements / 3 * count;
+        mCounters.instances += count;
+
+        if (mRecording) {
+            recordMesh(id);
+
+            Command* command = record(CommandType::DrawMesh);
+            command->mesh = id;
+            command->count = count;
+            command->data = mCommands.addData(instances, count * sizeof(MeshInstance));
+        }
+    }
+
+    void* NullBackend::createRenderTarget(int width, int height) {
+        RenderTargetEntry& entry = mRenderTargets.emplace_back();
+        entry.width = width;
+        entry.height = height;
+
+        mCounters.renderTargetsCreated++;
+
+        uint32_t id = static_cast<uint32_t>(mRenderTargets.size() - 1);
+        if (mRecording) recordRenderTarget(id);
+
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(id + 1));
+    }
+
+    void NullBackend::destroyRenderTarget(void* target) {
+        uint32_t id;
+        RenderTargetEntry* entry = getRenderTarget(target, &id);
+        if (entry == nullptr) return;
+
+        if (mRecording && entry->recorded) {
+            record(CommandType::DestroyRenderTarget)->renderTarget = id;
+        }
+
+        entry->alive = false;
+    }
+
+    void NullBackend::beginView(void* target, int x, int y, int width, int height) {
+        uint32_t id = UINT32_MAX;
+        if (target != nullptr && getRenderTarget(target, &id) == nullptr) return;
+
+        mCounters.views++;
+
+        if (mRecording) {
+            if (id != UINT32_MAX) recordRenderTarget(id);
+
+            Command* command = record(CommandType::BeginView);
+            command->renderTarget = id;
+            command->rect[0] = x;
+            command->rect[1] = y;
+            command->rect[2] = width;
+            command->rect[3] = height;
+        }
+    }
+
+    void NullBackend::endView() {
+        record(CommandType::EndView);
+    }
+
+    void* NullBackend::createTexture(int width, int height, const uint8_t* pixels) {
+        TextureEntry& entry = mTextures.emplace_back();
+        entry.width = width;
+        entry.height = height;
+        if (pixels != nullptr) entry.pixels.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+
+        mCounters.texturesCreated++;
+        mCounters.textureBytesUploaded += entry.pixels.size();
+
+        uint32_t id = static_cast<uint32_t>(mTextures.size() - 1);
+        if (mRecording) recordTexture(id);
+
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(id + 1));
+    }
+
+    void NullBackend::updateTexture(void* texture, int x, int y, int width, int height, const uint8_t* pixels) {
+        uint32_t id;
+        TextureEntry* entry = getTexture(texture, &id);
+        if (entry == nullptr || x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > entry->width || y + height > entry->height) return;
+
+        if (entry->pixels.empty()) entry->pixels.resize(static_cast<size_t>(entry->width) * entry->height * 4);
+
+        for (int row = 0; row < height; row++) {
+            memcpy(entry->pixels.data() + (static_cast<size_t>(y + row) * entry->width + x) * 4, pixels + static_cast<size_t>(row) * width * 4, static_cast<size_t>(width) * 4);
+        }
+
+        mCounters.textureBytesUploaded += static_cast<uint64_t>(width) * height * 4;
+
+        if (mRecording && entry->recorded) {
+            Command* command = record(CommandType::UpdateTexture);
+            command->texture = id;
+            command->rect[0] = x;
+            command->rect[1] = y;
+            command->rect[2] = width;
+            command->rect[3] = height;
+            command->data = mCommands.addData(pixels, static_cast<size_t>(width) * height * 4);
+        }
+    }
+
+    void NullBackend::destroyTexture(void* texture) {
+        uint32_t id;
+        TextureEntry* entry = getTexture(texture, &id);
+        if (entry == nullptr) return;
+
+        if (mRecording && entry->recorded) {
+            record(CommandType::DestroyTexture)->texture = id;
+        }
+
+        entry->alive = false;
+        entry->pixels = {};
+    }
+
+    void NullBackend::drawSprites(void* texture, BlendMode blend, const SpriteVertex* vertices, uint32_t count) {
+        uint32_t id = UINT32_MAX;
+        if ((texture != nullptr && getTexture(texture, &id) == nullptr) || count == 0) return;
+
+        mCounters.drawCalls++;
+        mCounters.triangles += count * 2;
+        mCounters.sprites += count;
+
+        if (mRecording) {
+            if (id != UINT32_MAX) recordTexture(id);
+
+            Command* command = record(CommandType::DrawSprites);
+            command->texture = id;
+            command->blend = blend;
+            command->count = count;
+            command->data = mCommands.addData(vertices, count * 4 * sizeof(SpriteVertex));
+        }
+    }
+
+    void NullBackend::beginDrawing() {
+        record(CommandType::BeginDrawing);
+    }
+
+    void NullBackend::endDrawing() {
+        mCounters.frames++;
+        record(CommandType::EndDrawing);
+    }
+
+    void NullBackend::clear() {
+        mCounters.clears++;
+        record(CommandType::Clear);
+    }
+
+    void NullBackend::begin3D(const math::Matrix4& view, const math::Matrix4& projection) {
+        mCounters.passes3D++;
+
+        if (Command* command = record(CommandType::Begin3D)) {
+            math::Matrix4 matrices[2] = { view, projection };
+            command->data = mCommands.addData(matrices, sizeof(matrices));
+        }
+    }
+
+    void NullBackend::end3D() {
+        record(CommandType::End3D);
+    }
+
+    void NullBackend::drawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color) {
+        mCounters.drawCalls++;
+        mCounters.triangles += 12;
+
+        if (Command* command = record(CommandType::DrawCube)) {
+            command->position = position;
+            command->size = size;
+            command->rotation = rotation;
+            command->color = color;
+        }
+    }
+
+    void NullBackend::setWindowSize(int width, int height) {
+        mWidth = width;
+        mHeight = height;
+    }
+
+    void NullBackend::requestClose() {
+        mCloseRequested = true;
+    }
+
+    const NullBackend::Counters& NullBackend::getCounters() const {
+        return mCounters;
+    }
+
+    void NullBackend::resetCounters() {
+        mCounters = {};
+    }
+
+    void NullBackend::setRecording(bool recording) {
+        mRecording = recording;
+    }
+
+    bool NullBackend::isRecording() const {
+        return mRecording;
+    }
+
+    const CommandBuffer& NullBackend::getCommands() const {
+        return mCommands;
+    }
+
+    void NullBackend::clearCommands() {
+        mCommands.clear();
+
+        for (ShaderEntry& shader : mShaders) {
+            shader.recorded = false;
+            std::fill(shader.uniformStrings.begin(), shader.uniformStrings.end(), UINT32_MAX);
+        }
+
+        for (MeshEntry& mesh : mMeshes) {
+            mesh.recorded = false;
+        }
+
+        for (RenderTargetEntry& target : mRenderTargets) {
+            target.recorded = false;
+        }
+
+        for (TextureEntry& texture : mTextures) {
+            texture.recorded = false;
+        }
+    }
+
+    NullBackend::ShaderEntry* NullBackend::getShader(void* shader, uint32_t* id) {
+        uintptr_t handle = reinterpret_cast<uintptr_t>(shader);
+        if (handle == 0 || handle > mShaders.size()) return nullptr;
+
+        ShaderEntry& entry = mShaders[handle - 1];
+        if (!entry.alive) return nullptr;
+
+        if (id != nullptr) *id = static_cast<uint32_t>(handle - 1);
+        return &entry;
+    }
+
+    // shaders that existed before recording started get their compile command the first time the stream references them
+    void NullBackend::recordShader(uint32_t id) {
+        ShaderEntry& entry = mShaders[id];
+        if (entry.recorded) return;
+
+        entry.recorded = true;
+
+        uint32_t vertex = mCommands.addString(entry.vertexSource.c_str());
+        uint32_t fragment = mCommands.addString(entry.fragmentSource.c_str());
+
+        Command& command = mCommands.push(CommandType::CompileShader);
+        command.shader = id;
+        command.name = vertex;
+        command.source = fragment;
+    }
+
+    NullBackend::MeshEntry* NullBackend::getMesh(void* mesh, uint32_t* id) {
+        uintptr_t handle = reinterpret_cast<uintptr_t>(mesh);
+        if (handle == 0 || handle > mMeshes.size()) return nullptr;
+
+        MeshEntry& entry = mMeshes[handle - 1];
+        if (!entry.alive) return nullptr;
+
+        if (id != nullptr) *id = static_cast<uint32_t>(handle - 1);
+        return &entry;
+    }
+
+    // same deal as recordShader, the stream gets the mesh as it looks right now
+    void NullBackend::recordMesh(uint32_t id) {
+        MeshEntry& entry = mMeshes[id];
+        if (entry.recorded) return;
+
+        entry.recorded = true;
+
+        Command& command = mCommands.push(CommandType::CreateMesh);
+        command.mesh = id;
+        command.count = static_cast<uint32_t>(entry.vertices.size());
+        command.indexCount = static_cast<uint32_t>(entry.indices.size());
+        command.dynamic = entry.dynamic;
+        command.data = mCommands.addData(entry.vertices.data(), entry.vertices.size() * sizeof(Vertex));
+        command.indexData = mCommands.addData(entry.indices.data(), entry.indices.size() * sizeof(uint16_t));
+    }
+
+    NullBackend::RenderTargetEntry* NullBackend::getRenderTarget(void* target, uint32_t* id) {
+        uintptr_t handle = reinterpret_cast<uintptr_t>(target);
+        if (handle == 0 || handle > mRenderTargets.size()) return nullptr;
+
+        RenderTargetEntry& entry = mRenderTargets[handle - 1];
+        if (!entry.alive) return nullptr;
+
+        if (id != nullptr) *id = static_cast<uint32_t>(handle - 1);
+        return &entry;
+    }
+
+    void NullBackend::recordRenderTarget(uint32_t id) {
+        RenderTargetEntry& entry = mRenderTargets[id];
+        if (entry.recorded) return;
+
+        entry.recorded = true;
+
+        Command& command = mCommands.push(CommandType::CreateRenderTarget);
+        command.renderTarget = id;
+        command.rect[2] = entry.width;
+        command.rect[3] = entry.height;
+    }
+
+    NullBackend::TextureEntry* NullBackend::getTexture(void* texture, uint32_t* id) {
+        uintptr_t handle = reinterpret_cast<uintptr_t>(texture);
+        if (handle == 0 || handle > mTextures.size()) return nullptr;
+
+        TextureEntry& entry = mTextures[handle - 1];
+        if (!entry.alive) return nullptr;
+
+        if (id != nullptr) *id = static_cast<uint32_t>(handle - 1);
+        return &entry;
+    }
+
+    // the stream gets the texture as it looks right now, like meshes
+    void NullBackend::recordTexture(uint32_t id) {
+        TextureEntry& entry = mTextures[id];
+        if (entry.recorded) return;
+
+        entry.recorded = true;
+
+        Command& command = mCommands.push(CommandType::CreateTexture);
+        command.texture = id;
+        command.rect[2] = entry.width;
+        command.rect[3] = entry.height;
+        command.count = static_cast<uint32_t>(entry.pixels.size());
+        command.data = mCommands.addData(entry.pixels.data(), entry.pixels.size());
+    }
+
+    Command* NullBackend::record(CommandType type) {
+        if (!mRecording) return nullptr;
+        return &mCommands.push(type);
+    }
+}
@@ -0,0 +1,862 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/hal/input.h"
+#include "scorpion/hal/render_backend.h"
+
+#include <config.h>
+#include <raylib.h>
+#include <rlgl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace scorpion::render {
+#if defined(PLATFORM_DESKTOP) || defined(PLATFORM_DESKTOP_GLFW)
+    // rlgl doesn't wrap program binaries, so the entry points come straight from glfw (built into raylib on desktop)
+    #define SCORPION_PROGRAM_BINARIES 1
+
+    #ifdef _WIN32
+        #define SCORPION_GLAPI __stdcall
+    #else
+        #define SCORPION_GLAPI
+    #endif
+
+    extern "C" {
+        typedef void (*GLFWglproc)(void);
+        GLFWglproc glfwGetProcAddress(const char* procname);
+    }
+
+    static constexpr unsigned int GlVendor = 0x1F00;
+    static constexpr unsigned int GlRenderer = 0x1F01;
+    static constexpr unsigned int GlVersion = 0x1F02;
+    static constexpr unsigned int GlLinkStatus = 0x8B82;
+    static constexpr unsigned int GlProgramBinaryLength = 0x8741;
+
+    struct ProgramBinaryApi {
+        void (SCORPION_GLAPI *getProgramiv)(unsigned int program, unsigned int pname, int* params);
+        void (SCORPION_GLAPI *getProgramBinary)(unsigned int program, int bufSize, int* length, unsigned int* binaryFormat, void* binary);
+        void (SCORPION_GLAPI *programBinary)(unsigned int program, unsigned int binaryFormat, const void* binary, int length);
+        unsigned int (SCORPION_GLAPI *createProgram)();
+        void (SCORPION_GLAPI *deleteProgram)(unsigned int program);
+        const unsigned char* (SCORPION_GLAPI *getString)(unsigned int name);
+    };
+
+    // needs a current context, so the first call has to come from the render thread after InitWindow.
+    // nullptr when the driver is older than GL 4.1 / ARB_get_program_binary
+    static const ProgramBinaryApi* GetProgramBinaryApi() {
+        static ProgramBinaryApi api;
+        static bool loaded = false;
+        static bool supported = false;
+
+        if (!loaded) {
+            loaded = true;
+
+            api.getProgramiv = reinterpret_cast<decltype(api.getProgramiv)>(glfwGetProcAddress("glGetProgramiv"));
+            api.getProgramBinary = reinterpret_cast<decltype(api.getProgramBinary)>(glfwGetProcAddress("glGetProgramBinary"));
+            api.programBinary = reinterpret_cast<decltype(api.programBinary)>(glfwGetProcAddress("glProgramBinary"));
+            api.createProgram = reinterpret_cast<decltype(api.createProgram)>(glfwGetProcAddress("glCreateProgram"));
+            api.deleteProgram = reinterpret_cast<decltype(api.deleteProgram)>(glfwGetProcAddress("glDeleteProgram"));
+            api.getString = reinterpret_cast<decltype(api.getString)>(glfwGetProcAddress("glGetString"));
+
+            supported = api.getProgramiv != nullptr && api.getProgramBinary != nullptr && api.programBinary != nullptr
+                && api.createProgram != nullptr && api.deleteProgram != nullptr && api.getString != nullptr;
+        }
+
+        return supported ? &api : nullptr;
+    }
+#endif
+
+    struct RaylibShader {
+        unsigned int id;
+        int* locs;
+        int instanceColorLoc;
+    };
+
+    struct RaylibMesh {
+        unsigned int vao;
+        unsigned int vbo;
+        unsigned int ebo; // 0 without indices
+        uint32_t vertexCount;
+        uint32_t indexCount;
+    };
+
+    struct RaylibTexture {
+        unsigned int id;
+        int width;
+        int height;
+    };
+
+    struct RaylibRenderTarget {
+        unsigned int fbo;
+        unsigned int color;
+        unsigned int depth;
+        int width;
+        int height;
+    };
+
+    // rlgl's Matrix is stored row by row, ours column by column
+    static math::Matrix4 FromRaylib(const ::Matrix& matrix) {
+        math::Matrix4 result;
+        const float values[16] = {
+            matrix.m0, matrix.m1, matrix.m2, matrix.m3,
+            matrix.m4, matrix.m5, matrix.m6, matrix.m7,
+            matrix.m8, matrix.m9, matrix.m10, matrix.m11,
+            matrix.m12, matrix.m13, matrix.m14, matrix.m15,
+        };
+        memcpy(result.m, values, sizeof(values));
+        return result;
+    }
+
+    static ::Matrix ToRaylib(const math::Matrix4& matrix) {
+        const float* m = matrix.m;
+        return {
+            m[0], m[4], m[8], m[12],
+            m[1], m[5], m[9], m[13],
+            m[2], m[6], m[10], m[14],
+            m[3], m[7], m[11], m[15],
+        };
+    }
+
+    static int ToRaylib(BlendMode blend) {
+        switch (blend) {
+            case BlendMode::Alpha: return RL_BLEND_ALPHA;
+            case BlendMode::Additive: return RL_BLEND_ADDITIVE;
+            case BlendMode::Multiply: return RL_BLEND_MULTIPLIED;
+            case BlendMode::Premultiplied: return RL_BLEND_ALPHA_PREMULTIPLY;
+        }
+
+        return RL_BLEND_ALPHA;
+    }
+
+    // Sprites stream through a ring this big, so a draw doesn't have to wait on the GPU still reading the previous one
+    static constexpr uint32_t SpriteRingQuads = 65536;
+
+    // most quads a 16 bit index buffer can address
+    static constexpr uint32_t SpriteQuadsPerDraw = 16384;
+
+    class RaylibBackend : public Backend {
+    public:
+        const char* getName() const override {
+            return "Raylib";
+        }
+
+        bool isHeadless() const override {
+            return false;
+        }
+
+        void initWindow(int width, int height, const char* title) override {
+            ::SetConfigFlags(FLAG_WINDOW_ALWAYS_RUN | FLAG_MSAA_4X_HINT);
+            ::InitWindow(width, height, title);
+            ::SetExitKey(KEY_NULL);
+            ::SetTargetFPS(0);
+        }
+
+        void closeWindow() override {
+            ::CloseWindow();
+        }
+
+        bool windowShouldClose() override {
+            return ::WindowShouldClose();
+        }
+
+        int getWindowWidth() override {
+            return ::GetScreenWidth();
+        }
+
+        int getWindowHeight() override {
+            return ::GetScreenHeight();
+        }
+
+        bool isCursorVisible() override {
+            return !::IsCursorHidden();
+        }
+
+        void setCursorVisible(bool visible) override {
+            if (visible) {
+                if (!isCursorVisible()) ::EnableCursor();
+            } else {
+                if (isCursorVisible()) ::DisableCursor();
+            }
+        }
+
+        void* compileShader(const char* vShaderCode, const char* fShaderCode) override {
+            unsigned int rlId = rlLoadShaderCode(vShaderCode, fShaderCode);
+            if (rlId == 0) return nullptr;
+
+            return makeShader(rlId);
+        }
+
+        const char* getDriverString() override {
+#ifdef SCORPION_PROGRAM_BINARIES
+            if (mDriverString.empty()) {
+                const ProgramBinaryApi* gl = GetProgramBinaryApi();
+                if (gl == nullptr) return getName();
+
+                for (unsigned int name : { GlVendor, GlRenderer, GlVersion }) {
+                    const unsigned char* string = gl->getString(name);
+                    if (string != nullptr) mDriverString += reinterpret_cast<const char*>(string);
+                    mDriverString += '|';
+                }
+            }
+
+            return mDriverString.c_str();
+#else
+            return getName();
+#endif
+        }
+
+        bool getShaderBinary(void* handle, Vector<uint8_t>& binary, uint32_t& format) override {
+#ifdef SCORPION_PROGRAM_BINARIES
+            auto shader = static_cast<RaylibShader*>(handle);
+            if (shader->id == rlGetShaderIdDefault()) return false; // a failed compile falls back to the default shader, never cache that
+
+            const ProgramBinaryApi* gl = GetProgramBinaryApi();
+            if (gl == nullptr) return false;
+
+            int length = 0;
+            gl->getProgramiv(shader->id, GlProgramBinaryLength, &length);
+            if (length <= 0) return false;
+
+            binary.resize(length);
+            gl->getProgramBinary(shader->id, length, &length, &format, binary.data());
+            binary.resize(length);
+
+            return length > 0;
+#else
+            return false;
+#endif
+        }
+
+        void* loadShaderBinary(const uint8_t* binary, size_t size, uint32_t format) override {
+#ifdef SCORPION_PROGRAM_BINARIES
+            const ProgramBinaryApi* gl = GetProgramBinaryApi();
+            if (gl == nullptr) return nullptr;
+
+            unsigned int rlId = gl->createProgram();
+            if (rlId == 0) return nullptr;
+
+            gl->programBinary(rlId, format, binary, static_cast<int>(size));
+
+            // drivers reject binaries from other versions through the link status
+            int linked = 0;
+            gl->getProgramiv(rlId, GlLinkStatus, &linked);
+            if (linked == 0) {
+                gl->deleteProgram(rlId);
+                return nullptr;
+            }
+
+            return makeShader(rlId);
+#else
+            return nullptr;
+#endif
+        }
+
+        void destroyShader(void* handle) override {
+            auto shader = static_cast<RaylibShader*>(handle);
+            if (shader == mBoundShader) mBoundShader = nullptr;
+
+            if (shader->id != rlGetShaderIdDefault()) {
+                rlUnloadShaderProgram(shader->id);
+                ScorpionHeapFree(shader->locs);
+            }
+
+            ScorpionHeapFree(shader);
+        }
+
+        void bindShader(void* handle) override {
+            auto shader = static_cast<RaylibShader*>(handle);
+            rlSetShader(shader->id, shader->locs);
+
+            mBoundShader = shader;
+        }
+
+        void unbindShader() override {
+            rlSetShader(rlGetShaderIdDefault(), rlGetShaderLocsDefault());
+
+            mBoundShader = nullptr;
+        }
+
+        int getUniformLocation(void* handle, const char* name) override {
+            return rlGetLocationUniform(static_cast<RaylibShader*>(handle)->id, name);
+        }
+
+        int getAttribLocation(void* handle, const char* name) override {
+            return rlGetLocationAttrib(static_cast<RaylibShader*>(handle)->id, name);
+        }
+
+        void setUniform(void* handle, int location, UniformType type, const void* value) override {
+            rlEnableShader(static_cast<RaylibShader*>(handle)->id);
+
+            switch (type) {
+                case UniformType::Float:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_FLOAT, 1);
+                    break;
+                case UniformType::Int:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_INT, 1);
+                    break;
+                case UniformType::UInt:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_UINT, 1);
+                    break;
+                case UniformType::Vec2:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_VEC2, 1);
+                    break;
+                case UniformType::Vec3:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_VEC3, 1);
+                    break;
+                case UniformType::Vec4:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_VEC4, 1);
+                    break;
+                case UniformType::Vec2I:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_IVEC2, 1);
+                    break;
+                case UniformType::Vec3I:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_IVEC3, 1);
+                    break;
+                case UniformType::Vec4I:
+                    rlSetUniform(location, value, RL_SHADER_UNIFORM_IVEC4, 1);
+                    break;
+                case UniformType::Matrix4: {
+                    // raylib's Matrix is laid out row by row, a straight memcpy would upload the transpose
+                    math::Matrix4 matrix;
+                    memcpy(matrix.m, value, sizeof(matrix.m));
+
+                    rlSetUniformMatrix(location, ToRaylib(matrix));
+                    break;
+                }
+            }
+        }
+
+        void* createMesh(const Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount, bool dynamic) override {
+            auto mesh = static_cast<RaylibMesh*>(ScorpionHeapAlloc(sizeof(RaylibMesh)));
+            mesh->vertexCount = vertexCount;
+            mesh->indexCount = indices != nullptr ? indexCount : 0;
+
+            mesh->vao = rlLoadVertexArray();
+            rlEnableVertexArray(mesh->vao);
+
+            mesh->vbo = rlLoadVertexBuffer(vertices, static_cast<int>(vertexCount * sizeof(Vertex)), dynamic);
+
+            // rlgl binds these locations for every program it links, so one layout works for all shaders
+            rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 3, RL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, position));
+            rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, 2, RL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, texCoord));
+            rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL, 3, RL_FLOAT, false, sizeof(Vertex), offsetof(Vertex, normal));
+            rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR, 4, RL_UNSIGNED_BYTE, true, sizeof(Vertex), offsetof(Vertex, color));
+
+            rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+            rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
+            rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL);
+            rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
+
+            mesh->ebo = mesh->indexCount > 0 ? rlLoadVertexBufferElement(indices, static_cast<int>(indexCount * sizeof(uint16_t)), dynamic) : 0;
+
+            rlDisableVertexArray();
+            return mesh;
+        }
+
+        void updateMeshVertices(void* handle, uint32_t first, const Vertex* vertices, uint32_t count) override {
+            auto mesh = static_cast<RaylibMesh*>(handle);
+            rlUpdateVertexBuffer(mesh->vbo, vertices, static_cast<int>(count * sizeof(Vertex)), static_cast<int>(first * sizeof(Vertex)));
+        }
+
+        void updateMeshIndices(void* handle, uint32_t first, const uint16_t* indices, uint32_t count) override {
+            auto mesh = static_cast<RaylibMesh*>(handle);
+            if (mesh->ebo == 0) return;
+
+            rlUpdateVertexBufferElements(mesh->ebo, indices, static_cast<int>(count * sizeof(uint16_t)), static_cast<int>(first * sizeof(uint16_t)));
+        }
+
+        void destroyMesh(void* handle) override {
+            auto mesh = static_cast<RaylibMesh*>(handle);
+
+            rlUnloadVertexArray(mesh->vao);
+            rlUnloadVertexBuffer(mesh->vbo);
+            if (mesh->ebo != 0) rlUnloadVertexBuffer(mesh->ebo);
+
+            ScorpionHeapFree(mesh);
+        }
+
+        void drawMesh(void* handle, const MeshInstance* instances, uint32_t count) override {
+            auto mesh = static_cast<RaylibMesh*>(handle);
+            if (count == 0) return;
+
+            unsigned int shaderId = mBoundShader != nullptr ? mBoundShader->id : rlGetShaderIdDefault();
+            int* locs = mBoundShader != nullptr ? mBoundShader->locs : rlGetShaderLocsDefault();
+
+            rlEnableShader(shaderId);
+
+            math::Matrix4 view = FromRaylib(rlGetMatrixModelview());
+            math::Matrix4 projection = FromRaylib(rlGetMatrixProjection());
+            math::Matrix4 viewProjection = projection * view;
+
+            if (locs[SHADER_LOC_MATRIX_VIEW] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_VIEW], ToRaylib(view));
+            if (locs[SHADER_LOC_MATRIX_PROJECTION] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_PROJECTION], ToRaylib(projection));
+
+            // the default shader samples texture0, so something has to be bound there
+            rlActiveTextureSlot(0);
+            rlEnableTexture(rlGetTextureIdDefault());
+
+            rlEnableVertexArray(mesh->vao);
+
+            int instanceLoc = locs[SHADER_LOC_VERTEX_INSTANCE_TX];
+
+            if (instanceLoc != -1) {
+                // shaders with an instanceTransform attribute get every instance in one draw call
+                uploadInstances(instances, count);
+
+                for (int i = 0; i < 4; i++) {
+                    rlEnableVertexAttribute(instanceLoc + i);
+                    rlSetVertexAttribute(instanceLoc + i, 4, RL_FLOAT, false, sizeof(MeshInstance), offsetof(MeshInstance, transform) + i * 4 * sizeof(float));
+                    rlSetVertexAttributeDivisor(instanceLoc + i, 1);
+                }
+
+                int colorLoc = mBoundShader != nullptr ? mBoundShader->instanceColorLoc : -1;
+                if (colorLoc != -1) {
+                    rlEnableVertexAttribute(colorLoc);
+                    rlSetVertexAttribute(colorLoc, 4, RL_UNSIGNED_BYTE, true, sizeof(MeshInstance), offsetof(MeshInstance, color));
+                    rlSetVertexAttributeDivisor(colorLoc, 1);
+                }
+
+                if (locs[SHADER_LOC_MATRIX_MVP] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], ToRaylib(viewProjection));
+                if (locs[SHADER_LOC_COLOR_DIFFUSE] != -1) {
+                    const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+                    rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+                }
+
+                if (mesh->ebo != 0) {
+                    rlDrawVertexArrayElementsInstanced(0, static_cast<int>(mesh->indexCount), nullptr, static_cast<int>(count));
+                } else {
+                    rlDrawVertexArrayInstanced(0, static_cast<int>(mesh->vertexCount), static_cast<int>(count));
+                }
+
+                for (int i = 0; i < 4; i++) {
+                    rlDisableVertexAttribute(instanceLoc + i);
+                }
+                if (colorLoc != -1) rlDisableVertexAttribute(colorLoc);
+
+                rlDisableVertexBuffer();
+            } else {
+                // everything else still skips re-sending the geometry, it just costs one draw per instance
+                for (uint32_t i = 0; i < count; i++) {
+                    const MeshInstance& instance = instances[i];
+
+                    if (locs[SHADER_LOC_MATRIX_MVP] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], ToRaylib(viewProjection * instance.transform));
+                    if (locs[SHADER_LOC_MATRIX_MODEL] != -1) rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MODEL], ToRaylib(instance.transform));
+
+                    if (locs[SHADER_LOC_COLOR_DIFFUSE] != -1) {
+                        const float color[4] = {
+                            instance.color.r / 255.0f,
+                            instance.color.g / 255.0f,
+                            instance.color.b / 255.0f,
+                            instance.color.a / 255.0f,
+                        };
+                        rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], color, RL_SHADER_UNIFORM_VEC4, 1);
+                    }
+
+                    if (mesh->ebo != 0) {
+                        rlDrawVertexArrayElements(0, static_cast<int>(mesh->indexCount), nullptr);
+                    } else {
+                        rlDrawVertexArray(0, static_cast<int>(mesh->vertexCount));
+                    }
+                }
+            }
+
+            rlDisableVertexArray();
+            rlDisableTexture();
+            rlDisableShader();
+        }
+
+        void* createRenderTarget(int width, int height) override {
+            unsigned int fbo = rlLoadFramebuffer();
+            if (fbo == 0) return nullptr;
+
+            auto target = static_cast<RaylibRenderTarget*>(ScorpionHeapAlloc(sizeof(RaylibRenderTarget)));
+            target->fbo = fbo;
+            target->width = width;
+            target->height = height;
+
+            rlEnableFramebuffer(fbo);
+
+            // the depth buffer is a renderbuffer, nobody samples it
+            target->color = rlLoadTexture(nullptr, width, height, RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+            target->depth = rlLoadTextureDepth(width, height, true);
+            rlFramebufferAttach(fbo, target->color, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+            rlFramebufferAttach(fbo, target->depth, RL_ATTACHMENT_DEPTH, RL_ATTACHMENT_RENDERBUFFER, 0);
+
+            bool complete = rlFramebufferComplete(fbo);
+            rlDisableFramebuffer();
+
+            if (!complete) {
+                destroyRenderTarget(target);
+                return nullptr;
+            }
+
+            return target;
+        }
+
+        void destroyRenderTarget(void* handle) override {
+            auto target = static_cast<RaylibRenderTarget*>(handle);
+            if (target == mViewTarget) endView();
+
+            // unloading the framebuffer takes the depth renderbuffer with it
+            rlUnloadTexture(target->color);
+            rlUnloadFramebuffer(target->fbo);
+
+            ScorpionHeapFree(target);
+        }
+
+        void beginView(void* handle, int x, int y, int width, int height) override {
+            rlDrawRenderBatchActive();
+
+            auto target = static_cast<RaylibRenderTarget*>(handle);
+            mViewTarget = target;
+            mViewWidth = width;
+            mViewHeight = height;
+
+            int targetHeight;
+            if (target != nullptr) {
+                rlEnableFramebuffer(target->fbo);
+                targetHeight = target->height;
+            } else {
+                // the viewport comes in screen coordinates, the backbuffer can be bigger on high dpi displays
+                float scaleX = static_cast<float>(GetRenderWidth()) / static_cast<float>(GetScreenWidth());
+                float scaleY = static_cast<float>(GetRenderHeight()) / static_cast<float>(GetScreenHeight());
+
+                x = static_cast<int>(static_cast<float>(x) * scaleX);
+                y = static_cast<int>(static_cast<float>(y) * scaleY);
+                width = static_cast<int>(static_cast<float>(width) * scaleX);
+                height = static_cast<int>(static_cast<float>(height) * scaleY);
+                targetHeight = GetRenderHeight();
+            }
+
+            // GL counts from the bottom left. The scissor keeps clears inside the viewport too
+            rlViewport(x, targetHeight - y - height, width, height);
+            rlEnableScissorTest();
+            rlScissor(x, targetHeight - y - height, width, height);
+        }
+
+        void endView() override {
+            rlDrawRenderBatchActive();
+            rlDisableScissorTest();
+
+            if (mViewTarget != nullptr) rlDisableFramebuffer();
+            mViewTarget = nullptr;
+            mViewWidth = 0;
+            mViewHeight = 0;
+
+            rlViewport(0, 0, GetRenderWidth(), GetRenderHeight());
+        }
+
+        void* createTexture(int width, int height, const uint8_t* pixels) override {
+            auto texture = static_cast<RaylibTexture*>(ScorpionHeapAlloc(sizeof(RaylibTexture)));
+            texture->id = rlLoadTexture(pixels, width, height, RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+            texture->width = width;
+            texture->height = height;
+
+            return texture;
+        }
+
+        void updateTexture(void* handle, int x, int y, int width, int height, const uint8_t* pixels) override {
+            auto texture = static_cast<RaylibTexture*>(handle);
+            rlUpdateTexture(texture->id, x, y, width, height, RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, pixels);
+        }
+
+        void destroyTexture(void* handle) override {
+            auto texture = static_cast<RaylibTexture*>(handle);
+
+            rlUnloadTexture(texture->id);
+            ScorpionHeapFree(texture);
+        }
+
+        void drawSprites(void* handle, BlendMode blend, const SpriteVertex* vertices, uint32_t count) override {
+            if (count == 0) return;
+
+            // rlgl's batch goes first, whatever was drawn through it is underneath
+            rlDrawRenderBatchActive();
+
+            if (mSpriteVao == 0) createSpriteBuffers();
+
+            auto texture = static_cast<RaylibTexture*>(handle);
+
+            float viewWidth = static_cast<float>(mViewWidth > 0 ? mViewWidth : GetScreenWidth());
+            float viewHeight = static_cast<float>(mViewHeight > 0 ? mViewHeight : GetScreenHeight());
+
+            int* locs = rlGetShaderLocsDefault();
+            rlEnableShader(rlGetShaderIdDefault());
+
+            rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], ToRaylib(math::Matrix4::orthographic(0.0f, viewWidth, viewHeight, 0.0f, -1.0f, 1.0f)));
+
+            const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+            rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+
+            rlActiveTextureSlot(0);
+            rlEnableTexture(texture != nullptr ? texture->id : rlGetTextureIdDefault());
+
+            rlSetBlendMode(ToRaylib(blend));
+
+            rlEnableVertexArray(mSpriteVao);
+
+            while (count > 0) {
+                uint32_t quads = std::min(count, SpriteQuadsPerDraw);
+                if (mSpriteRingPosition + quads > SpriteRingQuads) mSpriteRingPosition = 0;
+
+                int offset = static_cast<int>(mSpriteRingPosition * 4 * sizeof(SpriteVertex));
+                rlUpdateVertexBuffer(mSpriteVbo, vertices, static_cast<int>(quads * 4 * sizeof(SpriteVertex)), offset);
+
+                // the indices always start at 0, so the attributes move instead
+                setSpriteAttributes(offset);
+                rlDrawVertexArrayElements(0, static_cast<int>(quads * 6), nullptr);
+
+                mSpriteRingPosition += quads;
+                vertices += quads * 4;
+                count -= quads;
+            }
+
+            rlDisableVertexArray();
+            rlDisableTexture();
+            rlDisableShader();
+
+            rlSetBlendMode(RL_BLEND_ALPHA);
+        }
+
+        void beginDrawing() override {
+            ::BeginDrawing();
+        }
+
+        void endDrawing() override {
+            ::EndDrawing();
+
+            // EndDrawing pumps the window's events too, the next pump would overwrite the wheel before input got to see it
+            input::SampleWindow();
+        }
+
+        void clear() override {
+            rlClearColor(255, 255, 255, 255);
+            rlClearScreenBuffers();
+        }
+
+        void begin3D(const math::Matrix4& view, const math::Matrix4& projection) override {
+            rlDrawRenderBatchActive();
+
+            rlMatrixMode(RL_PROJECTION);
+            rlPushMatrix();
+            rlLoadIdentity();
+            rlMultMatrixf(projection.m);
+
+            rlMatrixMode(RL_MODELVIEW);
+            rlLoadIdentity();
+            rlMultMatrixf(view.m);
+
+            rlEnableDepthTest();
+        }
+
+        void end3D() override {
+            rlDrawRenderBatchActive();
+
+            rlMatrixMode(RL_PROJECTION);
+            rlPopMatrix();
+
+            rlMatrixMode(RL_MODELVIEW);
+            rlLoadIdentity();
+
+            float scaleX = static_cast<float>(GetRenderWidth()) / static_cast<float>(GetScreenWidth());
+            float scaleY = static_cast<float>(GetRenderHeight()) / static_cast<float>(GetScreenHeight());
+
+            math::Matrix4 screenScale = math::Matrix4::scale({scaleX, scaleY, 1.0});
+
+            if (rlGetActiveFramebuffer() == 0) rlMultMatrixf(screenScale.m);
+
+            rlDisableDepthTest();
+        }
+
+        void drawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color) override {
+            rlPushMatrix();
+
+            math::Matrix4 matrix = math::Matrix4::translation(position) * math::Matrix4::rotation(rotation) * math::Matrix4::scale(size);
+            rlMultMatrixf(matrix.m);
+
+            rlBegin(RL_TRIANGLES);
+            rlColor4ub(color.r, color.g, color.b, color.a);
+
+            // Front face (z+)
+            rlNormal3f(0.0f, 0.0f, 1.0f);
+            rlVertex3f(-0.5f, -0.5f,  0.5f);
+            rlVertex3f( 0.5f, -0.5f,  0.5f);
+            rlVertex3f( 0.5f,  0.5f,  0.5f);
+
+            rlVertex3f(-0.5f, -0.5f,  0.5f);
+            rlVertex3f( 0.5f,  0.5f,  0.5f);
+            rlVertex3f(-0.5f,  0.5f,  0.5f);
+
+            // Back face (z-)
+            rlNormal3f(0.0f, 0.0f, -1.0f);
+            rlVertex3f(-0.5f, -0.5f, -0.5f);
+            rlVertex3f(-0.5f,  0.5f, -0.5f);
+            rlVertex3f( 0.5f,  0.5f, -0.5f);
+
+            rlVertex3f(-0.5f, -0.5f, -0.5f);
+            rlVertex3f( 0.5f,  0.5f, -0.5f);
+            rlVertex3f( 0.5f, -0.5f, -0.5f);
+
+            // Top face (y+)
+            rlNormal3f(0.0f, 1.0f, 0.0f);
+            rlVertex3f(-0.5f,  0.5f, -0.5f);
+            rlVertex3f(-0.5f,  0.5f,  0.5f);
+            rlVertex3f( 0.5f,  0.5f,  0.5f);
+
+            rlVertex3f(-0.5f,  0.5f, -0.5f);
+            rlVertex3f( 0.5f,  0.5f,  0.5f);
+            rlVertex3f( 0.5f,  0.5f, -0.5f);
+
+            // Bottom face (y-)
+            rlNormal3f(0.0f, -1.0f, 0.0f);
+            rlVertex3f(-0.5f, -0.5f, -0.5f);
+            rlVertex3f( 0.5f, -0.5f, -0.5f);
+            rlVertex3f( 0.5f, -0.5f,  0.5f);
+
+            rlVertex3f(-0.5f, -0.5f, -0.5f);
+            rlVertex3f( 0.5f, -0.5f,  0.5f);
+            rlVertex3f(-0.5f, -0.5f,  0.5f);
+
+            // Right face (x+)
+            rlNormal3f(1.0f, 0.0f, 0.0f);
+            rlVertex3f(0.5f, -0.5f, -0.5f);
+            rlVertex3f(0.5f,  0.5f, -0.5f);
+            rlVertex3f(0.5f,  0.5f,  0.5f);
+
+            rlVertex3f(0.5f, -0.5f, -0.5f);
+            rlVertex3f(0.5f,  0.5f,  0.5f);
+            rlVertex3f(0.5f, -0.5f,  0.5f);
+
+            // Left face (x-)
+            rlNormal3f(-1.0f, 0.0f, 0.0f);
+            rlVertex3f(-0.5f, -0.5f, -0.5f);
+            rlVertex3f(-0.5f, -0.5f,  0.5f);
+            rlVertex3f(-0.5f,  0.5f,  0.5f);
+
+            rlVertex3f(-0.5f, -0.5f, -0.5f);
+            rlVertex3f(-0.5f,  0.5f,  0.5f);
+            rlVertex3f(-0.5f,  0.5f, -0.5f);
+
+            rlEnd();
+
+            rlPopMatrix();
+        }
+
+    private:
+#ifdef SCORPION_PROGRAM_BINARIES
+        String mDriverString;
+#endif
+
+        RaylibShader* mBoundShader = nullptr;
+        RaylibRenderTarget* mViewTarget = nullptr;
+
+        // 0 outside of views, sprites use the screen size then
+        int mViewWidth = 0;
+        int mViewHeight = 0;
+
+        unsigned int mSpriteVao = 0;
+        unsigned int mSpriteVbo = 0;
+        unsigned int mSpriteEbo = 0;
+        uint32_t mSpriteRingPosition = 0; // in quads
+
+        // one streaming buffer for all instanced draws, it only ever grows
+        unsigned int mInstanceBuffer = 0;
+        size_t mInstanceCapacity = 0;
+
+        void uploadInstances(const MeshInstance* instances, uint32_t count) {
+            size_t size = count * sizeof(MeshInstance);
+
+            if (size > mInstanceCapacity) {
+                if (mInstanceBuffer != 0) rlUnloadVertexBuffer(mInstanceBuffer);
+
+                mInstanceCapacity = std::max(size, mInstanceCapacity * 2);
+                mInstanceBuffer = rlLoadVertexBuffer(nullptr, static_cast<int>(mInstanceCapacity), true);
+            } else {
+                rlEnableVertexBuffer(mInstanceBuffer);
+            }
+
+            rlUpdateVertexBuffer(mInstanceBuffer, instances, static_cast<int>(size), 0);
+        }
+
+        void createSpriteBuffers() {
+            mSpriteVao = rlLoadVertexArray();
+            rlEnableVertexArray(mSpriteVao);
+
+            mSpriteVbo = rlLoadVertexBuffer(nullptr, static_cast<int>(SpriteRingQuads * 4 * sizeof(SpriteVertex)), true);
+
+            rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+            rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD);
+            rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR);
+
+            // every quad is two triangles over its 4 corners, the same pattern for every draw
+            Vector<uint16_t> indices(SpriteQuadsPerDraw * 6);
+            for (uint32_t i = 0; i < SpriteQuadsPerDraw; i++) {
+                auto base = static_cast<uint16_t>(i * 4);
+                const uint16_t quad[6] = { base, static_cast<uint16_t>(base + 1), static_cast<uint16_t>(base + 2), base, static_cast<uint16_t>(base + 2), static_cast<uint16_t>(base + 3) };
+
+                std::copy(quad, quad + 6, indices.begin() + i * 6);
+            }
+
+            mSpriteEbo = rlLoadVertexBufferElement(indices.data(), static_cast<int>(indices.size() * sizeof(uint16_t)), false);
+
+            rlDisableVertexArray();
+        }
+
+        void setSpriteAttributes(int offset) {
+            rlEnableVertexBuffer(mSpriteVbo);
+
+            // z comes from the default attribute value, 0
+            rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 2, RL_FLOAT, false, sizeof(SpriteVertex), offset + static_cast<int>(offsetof(SpriteVertex, position)));
+            rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, 2, RL_FLOAT, false, sizeof(SpriteVertex), offset + static_cast<int>(offsetof(SpriteVertex, texCoord)));
+            rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_COLOR, 4, RL_UNSIGNED_BYTE, true, sizeof(SpriteVertex), offset + static_cast<int>(offsetof(SpriteVertex, color)));
+        }
+
+        static RaylibShader* makeShader(unsigned int rlId) {
+            auto shader = static_cast<RaylibShader*>(ScorpionHeapAlloc(sizeof(RaylibShader)));
+            shader->id = rlId;
+
+            if (rlId == rlGetShaderIdDefault()) {
+                shader->locs = rlGetShaderLocsDefault();
+                shader->instanceColorLoc = -1;
+                return shader;
+            }
+
+            // not one of raylib's locations, but MeshInstance carries a color and instanced shaders might want it
+            shader->instanceColorLoc = rlGetLocationAttrib(rlId, "instanceColor");
+
+            auto locs = static_cast<int*>(ScorpionHeapAlloc(RL_MAX_SHADER_LOCATIONS * sizeof(int)));
+
+            locs[SHADER_LOC_VERTEX_POSITION] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION);
+            locs[SHADER_LOC_VERTEX_TEXCOORD01] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD);
+            locs[SHADER_LOC_VERTEX_TEXCOORD02] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD2);
+            locs[SHADER_LOC_VERTEX_NORMAL] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_NORMAL);
+            locs[SHADER_LOC_VERTEX_TANGENT] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_TANGENT);
+            locs[SHADER_LOC_VERTEX_COLOR] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_COLOR);
+            locs[SHADER_LOC_VERTEX_BONEIDS] = rlGetLocationAttrib(rlId, "vertexBoneIds");
+            locs[SHADER_LOC_VERTEX_BONEWEIGHTS] = rlGetLocationAttrib(rlId, "vertexBoneWeights");
+            locs[SHADER_LOC_VERTEX_INSTANCE_TX] = rlGetLocationAttrib(rlId, "instanceTransform");
+
+            locs[SHADER_LOC_MATRIX_MVP] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_MVP);
+            locs[SHADER_LOC_MATRIX_VIEW] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW);
+            locs[SHADER_LOC_MATRIX_PROJECTION] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION);
+            locs[SHADER_LOC_MATRIX_MODEL] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL);
+            locs[SHADER_LOC_MATRIX_NORMAL] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL);
+            locs[SHADER_LOC_BONE_MATRICES] = rlGetLocationUniform(rlId, "boneMatrices");
+
+            locs[SHADER_LOC_COLOR_DIFFUSE] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR);
+            locs[SHADER_LOC_MAP_DIFFUSE] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0);
+            locs[SHADER_LOC_MAP_SPECULAR] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1);
+            locs[SHADER_LOC_MAP_NORMAL] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2);
+
+            shader->locs = locs;
+            return shader;
+        }
+    };
+
+    Backend* GetRaylibBackend() {
+        // never destroyed, shaders held by scenes and hooks get released during static destruction and still need it
+        static RaylibBackend* backend = new RaylibBackend();
+        return backend;
+    }
+}
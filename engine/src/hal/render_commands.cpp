@@ -0,0 +1,247 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/hal/render_backend.h"
+
+#include <cstddef>
+#include <cstring>
+
+namespace scorpion::render {
+    size_t GetUniformSize(UniformType type) {
+        switch (type) {
+            case UniformType::Float:
+            case UniformType::Int:
+            case UniformType::UInt:
+                return 4;
+            case UniformType::Vec2:
+            case UniformType::Vec2I:
+                return 8;
+            case UniformType::Vec3:
+            case UniformType::Vec3I:
+                return 12;
+            case UniformType::Vec4:
+            case UniformType::Vec4I:
+                return 16;
+            case UniformType::Matrix4:
+                return 64;
+        }
+
+        return 0;
+    }
+
+    Command& CommandBuffer::push(CommandType type) {
+        Command& command = mCommands.emplace_back();
+        command.type = type;
+        return command;
+    }
+
+    uint32_t CommandBuffer::addString(const char* string) {
+        mStrings.emplace_back(string);
+        return static_cast<uint32_t>(mStrings.size() - 1);
+    }
+
+    uint32_t CommandBuffer::addData(const void* data, size_t size) {
+        size_t offset = (mData.size() + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+        mData.resize(offset + size);
+        if (size > 0) memcpy(mData.data() + offset, data, size);
+
+        return static_cast<uint32_t>(offset);
+    }
+
+    const Vector<Command>& CommandBuffer::getCommands() const {
+        return mCommands;
+    }
+
+    const String& CommandBuffer::getString(uint32_t index) const {
+        return mStrings[index];
+    }
+
+    const uint8_t* CommandBuffer::getData(uint32_t offset) const {
+        return mData.data() + offset;
+    }
+
+    size_t CommandBuffer::size() const {
+        return mCommands.size();
+    }
+
+    bool CommandBuffer::empty() const {
+        return mCommands.empty();
+    }
+
+    void CommandBuffer::clear() {
+        mCommands.clear();
+        mStrings.clear();
+        mData.clear();
+    }
+
+    void CommandBuffer::replay(Backend& target) const {
+        Vector<void*> shaders; // recorded shader id -> handle on the target
+        Vector<void*> meshes; // same for meshes
+        Vector<void*> renderTargets; // and render targets
+        Vector<void*> textures; // and textures
+
+        auto getShader = [&shaders](uint32_t id) -> void* {
+            return id < shaders.size() ? shaders[id] : nullptr;
+        };
+
+        auto getMesh = [&meshes](uint32_t id) -> void* {
+            return id < meshes.size() ? meshes[id] : nullptr;
+        };
+
+        auto getRenderTarget = [&renderTargets](uint32_t id) -> void* {
+            return id < renderTargets.size() ? renderTargets[id] : nullptr;
+        };
+
+        auto getTexture = [&textures](uint32_t id) -> void* {
+            return id < textures.size() ? textures[id] : nullptr;
+        };
+
+        for (const Command& command : mCommands) {
+            switch (command.type) {
+                case CommandType::BeginDrawing:
+                    target.beginDrawing();
+                    break;
+                case CommandType::EndDrawing:
+                    target.endDrawing();
+                    break;
+                case CommandType::Clear:
+                    target.clear();
+                    break;
+                case CommandType::Begin3D: {
+                    math::Matrix4 matrices[2];
+                    memcpy(matrices, getData(command.data), sizeof(matrices));
+
+                    target.begin3D(matrices[0], matrices[1]);
+                    break;
+                }
+                case CommandType::End3D:
+                    target.end3D();
+                    break;
+                case CommandType::DrawCube:
+                    target.drawCube(command.position, command.size, command.rotation, command.color);
+                    break;
+                case CommandType::CompileShader: {
+                    if (command.shader >= shaders.size()) shaders.resize(command.shader + 1, nullptr);
+                    shaders[command.shader] = target.compileShader(getString(command.name).c_str(), getString(command.source).c_str());
+                    break;
+                }
+                case CommandType::DestroyShader: {
+                    void* shader = getShader(command.shader);
+                    if (shader != nullptr) {
+                        target.destroyShader(shader);
+                        shaders[command.shader] = nullptr;
+                    }
+                    break;
+                }
+                case CommandType::BindShader: {
+                    void* shader = getShader(command.shader);
+                    if (shader != nullptr) target.bindShader(shader);
+                    break;
+                }
+                case CommandType::UnbindShader:
+                    target.unbindShader();
+                    break;
+                case CommandType::SetUniform: {
+                    void* shader = getShader(command.shader);
+                    if (shader == nullptr) break;
+
+                    int location = target.getUniformLocation(shader, getString(command.name).c_str());
+                    if (location > -1) target.setUniform(shader, location, command.uniformType, command.uniform);
+                    break;
+                }
+                case CommandType::CreateMesh: {
+                    if (command.mesh >= meshes.size()) meshes.resize(command.mesh + 1, nullptr);
+
+                    auto vertices = reinterpret_cast<const Vertex*>(getData(command.data));
+                    auto indices = command.indexCount > 0 ? reinterpret_cast<const uint16_t*>(getData(command.indexData)) : nullptr;
+                    meshes[command.mesh] = target.createMesh(vertices, command.count, indices, command.indexCount, command.dynamic);
+                    break;
+                }
+                case CommandType::UpdateMeshVertices: {
+                    void* mesh = getMesh(command.mesh);
+                    if (mesh != nullptr) target.updateMeshVertices(mesh, command.first, reinterpret_cast<const Vertex*>(getData(command.data)), command.count);
+                    break;
+                }
+                case CommandType::UpdateMeshIndices: {
+                    void* mesh = getMesh(command.mesh);
+                    if (mesh != nullptr) target.updateMeshIndices(mesh, command.first, reinterpret_cast<const uint16_t*>(getData(command.data)), command.count);
+                    break;
+                }
+                case CommandType::DestroyMesh: {
+                    void* mesh = getMesh(command.mesh);
+                    if (mesh != nullptr) {
+                        target.destroyMesh(mesh);
+                        meshes[command.mesh] = nullptr;
+                    }
+                    break;
+                }
+                case CommandType::DrawMesh: {
+                    void* mesh = getMesh(command.mesh);
+                    if (mesh != nullptr) target.drawMesh(mesh, reinterpret_cast<const MeshInstance*>(getData(command.data)), command.count);
+                    break;
+                }
+                case CommandType::CreateRenderTarget: {
+                    if (command.renderTarget >= renderTargets.size()) renderTargets.resize(command.renderTarget + 1, nullptr);
+                    renderTargets[command.renderTarget] = target.createRenderTarget(command.rect[2], command.rect[3]);
+                    break;
+                }
+                case CommandType::DestroyRenderTarget: {
+                    void* renderTarget = getRenderTarget(command.renderTarget);
+                    if (renderTarget != nullptr) {
+                        target.destroyRenderTarget(renderTarget);
+                        renderTargets[command.renderTarget] = nullptr;
+                    }
+                    break;
+                }
+                case CommandType::BeginView:
+                    target.beginView(getRenderTarget(command.renderTarget), command.rect[0], command.rect[1], command.rect[2], command.rect[3]);
+                    break;
+                case CommandType::EndView:
+                    target.endView();
+                    break;
+                case CommandType::CreateTexture: {
+                    if (command.texture >= textures.size()) textures.resize(command.texture + 1, nullptr);
+
+                    const uint8_t* pixels = command.count > 0 ? getData(command.data) : nullptr;
+                    textures[command.texture] = target.createTexture(command.rect[2], command.rect[3], pixels);
+                    break;
+                }
+                case CommandType::UpdateTexture: {
+                    void* texture = getTexture(command.texture);
+                    if (texture != nullptr) target.updateTexture(texture, command.rect[0], command.rect[1], command.rect[2], command.rect[3], getData(command.data));
+                    break;
+                }
+                case CommandType::DestroyTexture: {
+                    void* texture = getTexture(command.texture);
+                    if (texture != nullptr) {
+                        target.destroyTexture(texture);
+                        textures[command.texture] = nullptr;
+                    }
+                    break;
+                }
+                case CommandType::DrawSprites: {
+                    // a texture the target failed to create draws untextured rather than not at all
+                    void* texture = command.texture != UINT32_MAX ? getTexture(command.texture) : nullptr;
+                    target.drawSprites(texture, command.blend, reinterpret_cast<const SpriteVertex*>(getData(command.data)), command.count);
+                    break;
+                }
+            }
+        }
+
+        for (void* shader : shaders) {
+            if (shader != nullptr) target.destroyShader(shader);
+        }
+
+        for (void* mesh : meshes) {
+            if (mesh != nullptr) target.destroyMesh(mesh);
+        }
+
+        for (void* renderTarget : renderTargets) {
+            if (renderTarget != nullptr) target.destroyRenderTarget(renderTarget);
+        }
+
+        for (void* texture : textures) {
+            if (texture != nullptr) target.destroyTexture(texture);
+        }
+    }
+}
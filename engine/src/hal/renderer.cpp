@@ -1,75 +1,66 @@
 // Copyright 2025 JesusTouchMe
 
-#include "scorpion/engine_std/camera.h"
+#include "scorpion/core/stats.h"
 
+#include "scorpion/hal/command_list.h"
+#include "scorpion/hal/mesh.h"
+#include "scorpion/hal/null_backend.h"
 #include "scorpion/hal/renderer.h"
+#include "scorpion/hal/shader_cache.h"
+#include "scorpion/hal/sprite_batch.h"
 
-#include "scorpion/util/lazy.h"
-
-#include <config.h>
-#include <raylib.h>
-#include <rlgl.h>
+#include <cstring>
 
 namespace scorpion::render {
-    Shader::Shader(void* handle)
-        : mHandle(handle) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-
-        if (rlId == rlGetShaderIdDefault()) mInternalState = rlGetShaderLocsDefault();
-        else if (rlId > 0) {
-            auto locs = static_cast<int*>(ScorpionHeapAlloc(RL_MAX_SHADER_LOCATIONS * sizeof(int)));
-
-            locs[SHADER_LOC_VERTEX_POSITION] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION);
-            locs[SHADER_LOC_VERTEX_TEXCOORD01] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD);
-            locs[SHADER_LOC_VERTEX_TEXCOORD02] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD2);
-            locs[SHADER_LOC_VERTEX_NORMAL] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_NORMAL);
-            locs[SHADER_LOC_VERTEX_TANGENT] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_TANGENT);
-            locs[SHADER_LOC_VERTEX_COLOR] = rlGetLocationAttrib(rlId, RL_DEFAULT_SHADER_ATTRIB_NAME_COLOR);
-            locs[SHADER_LOC_VERTEX_BONEIDS] = rlGetLocationAttrib(rlId, "vertexBoneIds");
-            locs[SHADER_LOC_VERTEX_BONEWEIGHTS] = rlGetLocationAttrib(rlId, "vertexBoneWeights");
-            locs[SHADER_LOC_VERTEX_INSTANCE_TX] = rlGetLocationAttrib(rlId, "instanceTransform");
-
-            locs[SHADER_LOC_MATRIX_MVP] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_MVP);
-            locs[SHADER_LOC_MATRIX_VIEW] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW);
-            locs[SHADER_LOC_MATRIX_PROJECTION] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION);
-            locs[SHADER_LOC_MATRIX_MODEL] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL);
-            locs[SHADER_LOC_MATRIX_NORMAL] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL);
-            locs[SHADER_LOC_BONE_MATRICES] = rlGetLocationUniform(rlId, "boneMatrices");
-
-            locs[SHADER_LOC_COLOR_DIFFUSE] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR);
-            locs[SHADER_LOC_MAP_DIFFUSE] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0);
-            locs[SHADER_LOC_MAP_SPECULAR] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1);
-            locs[SHADER_LOC_MAP_NORMAL] = rlGetLocationUniform(rlId, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2);
-
-            mInternalState = locs;
-        }
+    static Backend* activeBackend = nullptr;
+    static CameraConstants cameraConstants;
+
+    Backend* GetBackend() {
+        if (activeBackend == nullptr) activeBackend = GetRaylibBackend();
+        return activeBackend;
+    }
+
+    void SetBackend(Backend* backend) {
+        activeBackend = backend;
     }
 
+    Shader::Shader(void* handle)
+        : mHandle(handle) {}
+
     Shader::~Shader() {
         if (mBegun) end();
 
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        if (rlId != rlGetShaderIdDefault()) {
-            rlUnloadShaderProgram(rlId);
-            ScorpionHeapFree(mInternalState);
-        }
+        GetBackend()->destroyShader(mHandle);
     }
 
     void Shader::begin() {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int* locs = static_cast<int*>(mInternalState);
-        rlSetShader(rlId, locs);
+        if (CommandList* list = CommandList::getCurrent()) {
+            list->bindShader(this);
+            return;
+        }
+
+        GetBackend()->bindShader(mHandle);
+        mBegun = true;
+
+        stats::Add(stats::Stat::ShaderBinds);
+
+        if (mCameraVersion != cameraConstants.version) uploadCamera();
     }
 
     void Shader::end() {
-        rlSetShader(rlGetShaderIdDefault(), rlGetShaderLocsDefault());
+        if (CommandList* list = CommandList::getCurrent()) {
+            list->unbindShader(this);
+            return;
+        }
+
+        GetBackend()->unbindShader();
+        mBegun = false;
     }
 
     int Shader::getUniformLocation(const String& name) {
         if (auto it = mUniformLocs.find(name); it != mUniformLocs.end()) return it->second;
 
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = rlGetLocationUniform(rlId, name.c_str());
+        int loc = GetBackend()->getUniformLocation(mHandle, name.c_str());
         mUniformLocs[name] = loc;
 
         return loc;
@@ -78,330 +69,226 @@ namespace scorpion::render {
     int Shader::getAttribLocation(const String& name) {
         if (auto it = mAttribLocs.find(name); it != mAttribLocs.end()) return it->second;
 
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = rlGetLocationAttrib(rlId, name.c_str());
+        int loc = GetBackend()->getAttribLocation(mHandle, name.c_str());
         mAttribLocs[name] = loc;
 
         return loc;
     }
 
     void Shader::setUniformFloat(const String& name, float value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
-
-        if (loc > -1) {
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &value, RL_SHADER_UNIFORM_FLOAT, 1);
-        }
+        setUniform(name, UniformType::Float, &value);
     }
 
     void Shader::setUniformInt(const String& name, int value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
-
-        if (loc > -1) {
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &value, RL_SHADER_UNIFORM_INT, 1);
-        }
+        setUniform(name, UniformType::Int, &value);
     }
 
     void Shader::setUniformUInt(const String& name, unsigned int value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
-
-        if (loc > -1) {
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &value, RL_SHADER_UNIFORM_UINT, 1);
-        }
+        setUniform(name, UniformType::UInt, &value);
     }
 
     void Shader::setUniformVec2(const String& name, math::Vec2 value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
-
-        if (loc > -1) {
-            float rawValue[2] = { value.x, value.y };
-
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &rawValue, RL_SHADER_UNIFORM_VEC2, 1);
-        }
+        float rawValue[2] = { value.x, value.y };
+        setUniform(name, UniformType::Vec2, rawValue);
     }
 
     void Shader::setUniformVec3(const String& name, math::Vec3 value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
-
-        if (loc > -1) {
-            float rawValue[3] = {value.x, value.y, value.z};
-
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &rawValue, RL_SHADER_UNIFORM_VEC3, 1);
-        }
+        float rawValue[3] = {value.x, value.y, value.z};
+        setUniform(name, UniformType::Vec3, rawValue);
     }
 
     void Shader::setUniformVec4(const String& name, math::Vec4 value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
-
-        if (loc > -1) {
-            float rawValue[4] = {value.x, value.y, value.z, value.w};
-
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &rawValue, RL_SHADER_UNIFORM_VEC4, 1);
-        }
+        float rawValue[4] = {value.x, value.y, value.z, value.w};
+        setUniform(name, UniformType::Vec4, rawValue);
     }
 
     void Shader::setUniformVec2I(const String& name, math::Vec2I value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
-
-        if (loc > -1) {
-            int rawValue[2] = {value.x, value.y};
-
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &rawValue, RL_SHADER_UNIFORM_IVEC2, 1);
-        }
+        int rawValue[2] = {value.x, value.y};
+        setUniform(name, UniformType::Vec2I, rawValue);
     }
 
     void Shader::setUniformVec3I(const String& name, math::Vec3I value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
-
-        if (loc > -1) {
-            int rawValue[3] = {value.x, value.y, value.z};
-
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &rawValue, RL_SHADER_UNIFORM_IVEC3, 1);
-        }
+        int rawValue[3] = {value.x, value.y, value.z};
+        setUniform(name, UniformType::Vec3I, rawValue);
     }
 
     void Shader::setUniformVec4I(const String& name, math::Vec4I value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
+        int rawValue[4] = {value.x, value.y, value.z, value.w};
+        setUniform(name, UniformType::Vec4I, rawValue);
+    }
 
-        if (loc > -1) {
-            int rawValue[4] = {value.x, value.y, value.z, value.w};
+    void Shader::setUniformMatrix4(const String& name, math::Matrix4 value) {
+        setUniform(name, UniformType::Matrix4, value.m);
+    }
 
-            rlEnableShader(rlId);
-            rlSetUniform(loc, &rawValue, RL_SHADER_UNIFORM_IVEC4, 1);
+    void Shader::setUniform(const String& name, UniformType type, const void* value) {
+        // locations can't be looked up off the render thread, the list resolves them when it's submitted
+        if (CommandList* list = CommandList::getCurrent()) {
+            list->setUniform(this, name, type, value);
+            return;
         }
-    }
 
-    void Shader::setUniformMatrix4(const String& name, math::Matrix4 value) {
-        unsigned int rlId = static_cast<unsigned int>(reinterpret_cast<uintptr_t>(mHandle));
-        int loc = getUniformLocation(name);
+        setUniform(getUniformLocation(name), type, value);
+    }
 
-        if (loc > -1) {
-            ::Matrix matrix; // i genuinely hate rlgl for this
-            for (int i = 0; i < 16; i++) reinterpret_cast<float*>(&matrix)[i] = value.m[i];
+    void Shader::setUniform(int location, UniformType type, const void* value) {
+        if (location > -1) {
+            stats::Add(stats::Stat::UniformUploads);
 
-            rlEnableShader(rlId);
-            rlSetUniformMatrix(loc, matrix);
+            GetBackend()->setUniform(mHandle, location, type, value);
         }
     }
 
-    void InitWindow(int width, int height, const char* title) {
-        ::SetConfigFlags(FLAG_WINDOW_ALWAYS_RUN | FLAG_MSAA_4X_HINT);
-        ::InitWindow(width, height, title);
-        ::SetExitKey(KEY_NULL);
-        ::SetTargetFPS(0);
+    void Shader::uploadCamera() {
+        if (mCameraLocs[0] == -2) {
+            mCameraLocs[0] = getUniformLocation("view");
+            mCameraLocs[1] = getUniformLocation("projection");
+            mCameraLocs[2] = getUniformLocation("viewProjection");
+            mCameraLocs[3] = getUniformLocation("cameraPosition");
+        }
+
+        float position[3] = { cameraConstants.position.x, cameraConstants.position.y, cameraConstants.position.z };
+
+        setUniform(mCameraLocs[0], UniformType::Matrix4, cameraConstants.view.m);
+        setUniform(mCameraLocs[1], UniformType::Matrix4, cameraConstants.projection.m);
+        setUniform(mCameraLocs[2], UniformType::Matrix4, cameraConstants.viewProjection.m);
+        setUniform(mCameraLocs[3], UniformType::Vec3, position);
+
+        mCameraVersion = cameraConstants.version;
     }
 
-    void CloseWindow() {
-        ::CloseWindow();
+    RenderTarget::RenderTarget(void* handle, int width, int height)
+        : mHandle(handle)
+        , mWidth(width)
+        , mHeight(height) {}
+
+    RenderTarget::~RenderTarget() {
+        GetBackend()->destroyRenderTarget(mHandle);
     }
 
-    int GetWindowWidth() {
-        return ::GetScreenWidth();
+    SharedPtr<RenderTarget> CreateRenderTarget(int width, int height) {
+        if (width <= 0 || height <= 0) return nullptr;
+
+        void* handle = GetBackend()->createRenderTarget(width, height);
+        if (handle == nullptr) return nullptr;
+
+        return MakeShared<RenderTarget>(handle, width, height);
     }
 
-    int GetWindowHeight() {
-        return ::GetScreenHeight();
+    void InitWindow(int width, int height, const char* title) {
+        GetBackend()->initWindow(width, height, title);
+        SetRenderThread();
+        CreateSharedMeshes();
     }
 
-    SharedPtr<Shader> CompileShader(const char* vShaderCode, const char* fShaderCode) {
-        static HashMap<String, WeakPtr<Shader>> cache;
-        static std::mutex cacheMutex;
+    void InitHeadless(int width, int height) {
+        // leaked on purpose, same reason as the raylib one
+        static NullBackend* nullBackend = new NullBackend();
 
-        String key = String(vShaderCode) + "||" + fShaderCode;
+        if (!GetBackend()->isHeadless()) SetBackend(nullBackend);
 
-        {
-            std::lock_guard lock(cacheMutex);
+        GetBackend()->initWindow(width, height, "");
+        SetRenderThread();
+        CreateSharedMeshes();
+    }
 
-            auto it = cache.find(key);
-            if (it != cache.end()) {
-                SharedPtr<Shader> shader = it->second.lock();
-                if (shader != nullptr) {
-                    return shader;
-                }
-            }
-        }
+    bool IsHeadless() {
+        return GetBackend()->isHeadless();
+    }
 
-        unsigned int rlId = rlLoadShaderCode(vShaderCode, fShaderCode);
-        if (rlId == 0) return nullptr;
+    void CloseWindow() {
+        ReleaseSharedMeshes();
+        GetBackend()->closeWindow();
+    }
 
-        SharedPtr<Shader> shader = MakeShared<Shader>(reinterpret_cast<void*>(rlId));
+    bool WindowShouldClose() {
+        return GetBackend()->windowShouldClose();
+    }
 
-        {
-            std::lock_guard lock(cacheMutex);
-            cache[key] = shader;
-        }
+    int GetWindowWidth() {
+        return GetBackend()->getWindowWidth();
+    }
 
-        return shader;
+    int GetWindowHeight() {
+        return GetBackend()->getWindowHeight();
     }
 
     bool IsCursorVisible() {
-        return !::IsCursorHidden();
+        return GetBackend()->isCursorVisible();
     }
 
     void SetCursorVisible(bool visible) {
-        if (visible) {
-            if (!IsCursorVisible()) ::EnableCursor();
-        } else {
-            if (IsCursorVisible()) ::DisableCursor();
-        }
+        GetBackend()->setCursorVisible(visible);
     }
 
     void BeginDrawing() {
-        ::BeginDrawing();
+        GetBackend()->beginDrawing();
     }
 
     void EndDrawing() {
-        ::EndDrawing();
+        FlushMeshes();
+        FlushSprites();
+        GetBackend()->endDrawing();
     }
 
-    void Begin3D(math::Vec3 position, math::Vec3 target, math::Vec3 up, float fovY, int projection) {
-        rlDrawRenderBatchActive();
+    void BeginView(RenderTarget* target, int x, int y, int width, int height) {
+        GetBackend()->beginView(target != nullptr ? target->getHandle() : nullptr, x, y, width, height);
+    }
 
-        rlMatrixMode(RL_PROJECTION);
-        rlPushMatrix();
-        rlLoadIdentity();
+    void EndView() {
+        FlushSprites();
+        GetBackend()->endView();
+    }
 
-        float aspect = static_cast<float>(GetScreenWidth()) / static_cast<float>(GetScreenHeight());
+    CameraConstants MakeCameraConstants(const math::Matrix4& view, const math::Matrix4& projection) {
+        const float* m = view.m;
 
-        switch (static_cast<components::Camera::Projection>(projection)) {
-            case components::Camera::Projection::Perspective: {
-                double top = rlGetCullDistanceNear() * std::tan(math::Deg2Rad(fovY * 0.5));
-                double right = top * aspect;
+        CameraConstants constants;
+        constants.view = view;
+        constants.projection = projection;
+        constants.viewProjection = projection * view;
+        constants.position = math::Vec3(-(m[0] * m[12] + m[1] * m[13] + m[2] * m[14]),
+                                        -(m[4] * m[12] + m[5] * m[13] + m[6] * m[14]),
+                                        -(m[8] * m[12] + m[9] * m[13] + m[10] * m[14]));
 
-                rlFrustum(-right, right, -top, top, rlGetCullDistanceNear(), rlGetCullDistanceFar());
-                break;
-            }
-            case components::Camera::Projection::Orthographic: {
-                double top = fovY / 2.0;
-                double right = top * aspect;
+        return constants;
+    }
 
-                rlOrtho(-right, right, -top, top, rlGetCullDistanceNear(), rlGetCullDistanceFar());
+    void Begin3D(const math::Matrix4& view, const math::Matrix4& projection) {
+        // a camera that didn't move keeps the version, so shaders skip the upload entirely
+        if (memcmp(view.m, cameraConstants.view.m, sizeof(view.m)) != 0 || memcmp(projection.m, cameraConstants.projection.m, sizeof(projection.m)) != 0) {
+            uint32_t version = cameraConstants.version;
 
-                break;
-            }
+            cameraConstants = MakeCameraConstants(view, projection);
+            cameraConstants.version = version + 1;
         }
 
-        rlMatrixMode(RL_MODELVIEW);
-        rlLoadIdentity();
-
-        math::Matrix4 view = math::Matrix4::lookAt(position, target, up);
-        rlMultMatrixf(view.m);
-
-        rlEnableDepthTest();
+        GetBackend()->begin3D(view, projection);
     }
 
     void End3D() {
-        rlDrawRenderBatchActive();
-
-        rlMatrixMode(RL_PROJECTION);
-        rlPopMatrix();
-
-        rlMatrixMode(RL_MODELVIEW);
-        rlLoadIdentity();
-
-        float scaleX = static_cast<float>(GetRenderWidth()) / static_cast<float>(GetScreenWidth());
-        float scaleY = static_cast<float>(GetRenderHeight()) / static_cast<float>(GetScreenHeight());
-
-        math::Matrix4 screenScale = math::Matrix4::scale({scaleX, scaleY, 1.0});
-
-        if (rlGetActiveFramebuffer() == 0) rlMultMatrixf(screenScale.m);
+        FlushMeshes();
+        GetBackend()->end3D();
+    }
 
-        rlDisableDepthTest();
+    const CameraConstants& GetCameraConstants() {
+        if (CommandList* list = CommandList::getCurrent()) return list->getCamera();
+        return cameraConstants;
     }
 
     void ClearWindow() {
-        rlClearColor(255, 255, 255, 255);
-        rlClearScreenBuffers();
+        GetBackend()->clear();
     }
 
     void DrawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color) {
-        rlPushMatrix();
-
-        math::Matrix4 matrix = math::Matrix4::translation(position) * math::Matrix4::rotation(rotation) * math::Matrix4::scale(size);
-        rlMultMatrixf(matrix.m);
-
-        rlBegin(RL_TRIANGLES);
-        rlColor4ub(color.r, color.g, color.b, color.a);
-
-        // Front face (z+)
-        rlNormal3f(0.0f, 0.0f, 1.0f);
-        rlVertex3f(-0.5f, -0.5f,  0.5f);
-        rlVertex3f( 0.5f, -0.5f,  0.5f);
-        rlVertex3f( 0.5f,  0.5f,  0.5f);
-
-        rlVertex3f(-0.5f, -0.5f,  0.5f);
-        rlVertex3f( 0.5f,  0.5f,  0.5f);
-        rlVertex3f(-0.5f,  0.5f,  0.5f);
-
-        // Back face (z-)
-        rlNormal3f(0.0f, 0.0f, -1.0f);
-        rlVertex3f(-0.5f, -0.5f, -0.5f);
-        rlVertex3f(-0.5f,  0.5f, -0.5f);
-        rlVertex3f( 0.5f,  0.5f, -0.5f);
-
-        rlVertex3f(-0.5f, -0.5f, -0.5f);
-        rlVertex3f( 0.5f,  0.5f, -0.5f);
-        rlVertex3f( 0.5f, -0.5f, -0.5f);
-
-        // Top face (y+)
-        rlNormal3f(0.0f, 1.0f, 0.0f);
-        rlVertex3f(-0.5f,  0.5f, -0.5f);
-        rlVertex3f(-0.5f,  0.5f,  0.5f);
-        rlVertex3f( 0.5f,  0.5f,  0.5f);
-
-        rlVertex3f(-0.5f,  0.5f, -0.5f);
-        rlVertex3f( 0.5f,  0.5f,  0.5f);
-        rlVertex3f( 0.5f,  0.5f, -0.5f);
-
-        // Bottom face (y-)
-        rlNormal3f(0.0f, -1.0f, 0.0f);
-        rlVertex3f(-0.5f, -0.5f, -0.5f);
-        rlVertex3f( 0.5f, -0.5f, -0.5f);
-        rlVertex3f( 0.5f, -0.5f,  0.5f);
-
-        rlVertex3f(-0.5f, -0.5f, -0.5f);
-        rlVertex3f( 0.5f, -0.5f,  0.5f);
-        rlVertex3f(-0.5f, -0.5f,  0.5f);
-
-        // Right face (x+)
-        rlNormal3f(1.0f, 0.0f, 0.0f);
-        rlVertex3f(0.5f, -0.5f, -0.5f);
-        rlVertex3f(0.5f,  0.5f, -0.5f);
-        rlVertex3f(0.5f,  0.5f,  0.5f);
-
-        rlVertex3f(0.5f, -0.5f, -0.5f);
-        rlVertex3f(0.5f,  0.5f,  0.5f);
-        rlVertex3f(0.5f, -0.5f,  0.5f);
-
-        // Left face (x-)
-        rlNormal3f(-1.0f, 0.0f, 0.0f);
-        rlVertex3f(-0.5f, -0.5f, -0.5f);
-        rlVertex3f(-0.5f, -0.5f,  0.5f);
-        rlVertex3f(-0.5f,  0.5f,  0.5f);
-
-        rlVertex3f(-0.5f, -0.5f, -0.5f);
-        rlVertex3f(-0.5f,  0.5f,  0.5f);
-        rlVertex3f(-0.5f,  0.5f, -0.5f);
-
-        rlEnd();
-
-        rlPopMatrix();
+        if (CommandList* list = CommandList::getCurrent()) {
+            list->drawCube(position, size, rotation, color);
+            return;
+        }
+
+        stats::Add(stats::Stat::DrawCalls);
+        stats::Add(stats::Stat::TrianglesSubmitted, 12);
 
+        GetBackend()->drawCube(position, size, rotation, color);
     }
 }
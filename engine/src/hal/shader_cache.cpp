@@ -0,0 +1,485 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/foundation/jobs/job_system.h"
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include "scorpion/hal/shader_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <shared_mutex>
+#include <thread>
+
+namespace scorpion::render {
+    static constexpr uint64_t FnvOffset = 14695981039346656037ull;
+    static constexpr uint64_t FnvPrime = 1099511628211ull;
+
+    static uint64_t HashBytes(uint64_t hash, const char* string) {
+        for (; *string != '\0'; string++) {
+            hash ^= static_cast<uint8_t>(*string);
+            hash *= FnvPrime;
+        }
+        return hash;
+    }
+
+    uint64_t HashShaderSource(const char* vShaderCode, const char* fShaderCode) {
+        uint64_t hash = HashBytes(FnvOffset, vShaderCode);
+
+        // separator so moving text from one stage to the other changes the hash
+        hash ^= 0xFF;
+        hash *= FnvPrime;
+
+        return HashBytes(hash, fShaderCode);
+    }
+
+    struct BinaryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;
+        uint32_t reserved;
+        uint64_t sourceHash;
+        uint64_t size;
+    };
+
+    static constexpr uint32_t BinaryMagic = 0x42534353; // "SCSB"
+    static constexpr uint32_t BinaryVersion = 1;
+
+    static void PumpWhileWaiting();
+
+    class ShaderCache {
+    public:
+        ShaderCache() {
+            jobs::SetWaitCallback(PumpWhileWaiting);
+        }
+
+        ~ShaderCache() {
+            jobs::SetWaitCallback(nullptr);
+
+            {
+                std::lock_guard lock(mMutex);
+                mIoStop = true;
+            }
+            mIoCondition.notify_all();
+
+            if (mIoThread.joinable()) mIoThread.join();
+        }
+
+        SharedPtr<ShaderRequest> request(const char* vShaderCode, const char* fShaderCode) {
+            uint64_t hash = HashShaderSource(vShaderCode, fShaderCode);
+
+            if (SharedPtr<Shader> shader = findCached(hash, vShaderCode, fShaderCode)) return makeReady(hash, std::move(shader));
+
+            std::unique_lock lock(mMutex);
+
+            // pending requests keep their sources until they're out of here, see process
+            auto pending = mPending.find(hash);
+            if (pending != mPending.end() && pending->second->mVertexSource == vShaderCode && pending->second->mFragmentSource == fShaderCode) {
+                return pending->second;
+            }
+
+            // the render thread may have finished it between the first lookup and taking the lock
+            if (SharedPtr<Shader> shader = findCached(hash, vShaderCode, fShaderCode)) return makeReady(hash, std::move(shader));
+
+            SharedPtr<ShaderRequest> request = MakeShared<ShaderRequest>(hash, vShaderCode, fShaderCode);
+
+            // a different source with the same hash still gets compiled, it just doesn't get to share. Or to use the disk cache, the binary
+            // in there would be the other one's
+            bool shared = pending == mPending.end();
+            if (shared) mPending[hash] = request;
+
+            if (shared && !mDirectory.empty() && mDriverHash != 0) {
+                mIoJobs.push_back({ request, hash, false, getPath(hash), {}, 0 });
+                lock.unlock();
+                mIoCondition.notify_one();
+            } else {
+                mReady.push_back(request);
+            }
+
+            return request;
+        }
+
+        void pump(double budgetSeconds) {
+            SCORPION_PROFILE_SCOPE("ShaderCache::pump");
+
+            claimRenderThread();
+
+            auto start = std::chrono::steady_clock::now();
+
+            while (pumpOne()) {
+                if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= budgetSeconds) break;
+            }
+        }
+
+        // false if there was nothing to do
+        bool pumpOne() {
+            SharedPtr<ShaderRequest> request;
+            {
+                std::lock_guard lock(mMutex);
+                if (mReady.empty()) return false;
+
+                request = std::move(mReady.front());
+                mReady.erase(mReady.begin());
+            }
+
+            process(request);
+            return true;
+        }
+
+        // used by wait() on the render thread to jump the queue
+        bool takeReady(ShaderRequest* request) {
+            SharedPtr<ShaderRequest> taken;
+            {
+                std::lock_guard lock(mMutex);
+
+                auto it = std::find_if(mReady.begin(), mReady.end(), [request](const SharedPtr<ShaderRequest>& ready) {
+                    return ready.get() == request;
+                });
+                if (it == mReady.end()) return false;
+
+                taken = std::move(*it);
+                mReady.erase(it);
+            }
+
+            process(taken);
+            return true;
+        }
+
+        size_t getPendingCount() {
+            std::lock_guard lock(mMutex);
+            return mPending.size();
+        }
+
+        void setDirectory(const char* path) {
+            std::lock_guard lock(mMutex);
+
+            mDirectory = path != nullptr ? path : "";
+            if (mDirectory.empty()) return;
+
+            std::error_code error;
+            std::filesystem::create_directories(mDirectory.c_str(), error);
+
+            if (!mIoThread.joinable()) {
+                mIoThread = std::thread([this] { ioLoop(); });
+            }
+        }
+
+        void setRenderThread() {
+            mRenderThread = std::this_thread::get_id();
+
+            // querying the driver needs a live context, which only the render thread is guaranteed to have
+            std::lock_guard lock(mMutex);
+            mDriverHash = HashBytes(FnvOffset, GetBackend()->getDriverString());
+        }
+
+        bool isRenderThread() {
+            claimRenderThread();
+            return mRenderThread.load() == std::this_thread::get_id();
+        }
+
+        // without claiming it, a thread that happens to wait on a job first doesn't get to become the render thread
+        bool isClaimedRenderThread() const {
+            return mRenderThread.load() == std::this_thread::get_id();
+        }
+
+    private:
+        struct IoJob {
+            SharedPtr<ShaderRequest> request; // only set for reads
+            uint64_t hash;
+            bool write;
+            String path;
+            Vector<uint8_t> binary;
+            uint32_t format;
+        };
+
+        // the sources are kept around so a hash collision can't hand out somebody else's program
+        struct CachedShader {
+            WeakPtr<Shader> shader;
+            String vertexSource;
+            String fragmentSource;
+        };
+
+        std::shared_mutex mCacheMutex;
+        HashMap<uint64_t, CachedShader> mShaders;
+
+        // everything below is guarded by mMutex, which is always taken before mCacheMutex
+        std::mutex mMutex;
+        HashMap<uint64_t, SharedPtr<ShaderRequest>> mPending;
+        Vector<SharedPtr<ShaderRequest>> mReady;
+
+        String mDirectory;
+        uint64_t mDriverHash = 0;
+
+        std::thread mIoThread;
+        std::condition_variable mIoCondition;
+        Vector<IoJob> mIoJobs;
+        bool mIoStop = false;
+
+        std::atomic<std::thread::id> mRenderThread;
+
+        SharedPtr<Shader> findCached(uint64_t hash, const char* vShaderCode, const char* fShaderCode) {
+            std::shared_lock lock(mCacheMutex);
+
+            auto it = mShaders.find(hash);
+            if (it == mShaders.end() || it->second.vertexSource != vShaderCode || it->second.fragmentSource != fShaderCode) return nullptr;
+
+            return it->second.shader.lock();
+        }
+
+        SharedPtr<ShaderRequest> makeReady(uint64_t hash, SharedPtr<Shader> shader) {
+            SharedPtr<ShaderRequest> request = MakeShared<ShaderRequest>(hash, "", "");
+            request->finish(std::move(shader));
+            return request;
+        }
+
+        void claimRenderThread() {
+            std::thread::id none;
+            if (mRenderThread.load() == none && mRenderThread.compare_exchange_strong(none, std::this_thread::get_id())) {
+                std::lock_guard lock(mMutex);
+                if (mDriverHash == 0) mDriverHash = HashBytes(FnvOffset, GetBackend()->getDriverString());
+            }
+        }
+
+        String getPath(uint64_t hash) const {
+            char name[64];
+            snprintf(name, sizeof(name), "/%016llx-%016llx.bin", static_cast<unsigned long long>(hash), static_cast<unsigned long long>(mDriverHash));
+            return mDirectory + name;
+        }
+
+        void process(const SharedPtr<ShaderRequest>& request) {
+            SCORPION_PROFILE_SCOPE("ShaderCache::process");
+
+            Backend* backend = GetBackend();
+
+            void* handle = nullptr;
+            bool fromBinary = false;
+
+            if (!request->mBinary.empty()) {
+                handle = backend->loadShaderBinary(request->mBinary.data(), request->mBinary.size(), request->mBinaryFormat);
+                fromBinary = handle != nullptr;
+
+                request->mBinary = {};
+            }
+
+            // a binary from an older driver can still be rejected even though the driver string matched
+            if (handle == nullptr) {
+                handle = backend->compileShader(request->mVertexSource.c_str(), request->mFragmentSource.c_str());
+            }
+
+            SharedPtr<Shader> shader = handle != nullptr ? MakeShared<Shader>(handle) : nullptr;
+
+            bool cached = false;
+
+            {
+                std::lock_guard lock(mMutex);
+
+                // a colliding request that never made it into mPending doesn't get to take the other one's place
+                auto it = mPending.find(request->mHash);
+                if (it != mPending.end() && it->second == request) {
+                    // into the cache before leaving mPending, so nobody in between finds neither and compiles it again
+                    if (shader != nullptr) {
+                        std::unique_lock cacheLock(mCacheMutex);
+                        mShaders[request->mHash] = { shader, std::move(request->mVertexSource), std::move(request->mFragmentSource) };
+                        cached = true;
+                    }
+
+                    mPending.erase(it);
+                }
+            }
+
+            if (cached && !fromBinary) storeBinary(request->mHash, handle);
+
+            request->mVertexSource = {};
+            request->mFragmentSource = {};
+            request->finish(std::move(shader));
+        }
+
+        void storeBinary(uint64_t hash, void* handle) {
+            {
+                std::lock_guard lock(mMutex);
+                if (mDirectory.empty()) return;
+            }
+
+            IoJob job{ nullptr, hash, true, {}, {}, 0 };
+            if (!GetBackend()->getShaderBinary(handle, job.binary, job.format)) return;
+
+            {
+                std::lock_guard lock(mMutex);
+                job.path = getPath(hash);
+                mIoJobs.push_back(std::move(job));
+            }
+            mIoCondition.notify_one();
+        }
+
+        void ioLoop() {
+#ifdef SCORPION_PROFILER
+            profiler::SetThreadName("Shader Cache IO");
+#endif
+
+            std::unique_lock lock(mMutex);
+
+            while (true) {
+                mIoCondition.wait(lock, [this] { return mIoStop || !mIoJobs.empty(); });
+
+                // pending writes still go out on shutdown, otherwise the next start would be cold
+                if (mIoJobs.empty()) break;
+
+                IoJob job = std::move(mIoJobs.front());
+                mIoJobs.erase(mIoJobs.begin());
+
+                lock.unlock();
+
+                if (job.write) {
+                    writeBinary(job);
+                } else {
+                    readBinary(job);
+                }
+
+                lock.lock();
+
+                if (!job.write) mReady.push_back(std::move(job.request));
+            }
+        }
+
+        static void readBinary(IoJob& job) {
+            SCORPION_PROFILE_SCOPE("ShaderCache::readBinary");
+
+            FILE* file = fopen(job.path.c_str(), "rb");
+            if (file == nullptr) return;
+
+            BinaryHeader header;
+            bool valid = fread(&header, sizeof(header), 1, file) == 1
+                && header.magic == BinaryMagic
+                && header.version == BinaryVersion
+                && header.sourceHash == job.hash
+                && header.size > 0 && header.size < (64ull << 20);
+
+            if (valid) {
+                Vector<uint8_t>& binary = job.request->mBinary;
+
+                binary.resize(header.size);
+                if (fread(binary.data(), 1, binary.size(), file) == binary.size()) {
+                    job.request->mBinaryFormat = header.format;
+                } else {
+                    binary = {};
+                }
+            }
+
+            fclose(file);
+        }
+
+        static void writeBinary(const IoJob& job) {
+            SCORPION_PROFILE_SCOPE("ShaderCache::writeBinary");
+
+            // written next to the real path and renamed so a crash never leaves a half written binary behind
+            String temporary = job.path + ".tmp";
+
+            FILE* file = fopen(temporary.c_str(), "wb");
+            if (file == nullptr) return;
+
+            BinaryHeader header = { BinaryMagic, BinaryVersion, job.format, 0, job.hash, job.binary.size() };
+            bool written = fwrite(&header, sizeof(header), 1, file) == 1
+                && fwrite(job.binary.data(), 1, job.binary.size(), file) == job.binary.size();
+
+            if (fclose(file) != 0) written = false;
+
+            std::error_code error;
+            if (written) {
+                std::filesystem::rename(temporary.c_str(), job.path.c_str(), error);
+            } else {
+                std::filesystem::remove(temporary.c_str(), error);
+            }
+        }
+    };
+
+    static ShaderCache& GetShaderCache() {
+        static ShaderCache cache;
+        return cache;
+    }
+
+    // A job blocked in CompileShader waits for the render thread, and the render thread might be the one waiting for that job
+    static void PumpWhileWaiting() {
+        ShaderCache& cache = GetShaderCache();
+
+        if (!cache.isClaimedRenderThread() || !cache.pumpOne()) std::this_thread::yield();
+    }
+
+    ShaderRequest::ShaderRequest(uint64_t hash, const char* vShaderCode, const char* fShaderCode)
+        : mHash(hash)
+        , mVertexSource(vShaderCode)
+        , mFragmentSource(fShaderCode) {}
+
+    uint64_t ShaderRequest::getHash() const {
+        return mHash;
+    }
+
+    ShaderRequest::State ShaderRequest::getState() const {
+        return mState.load(std::memory_order_acquire);
+    }
+
+    bool ShaderRequest::isDone() const {
+        return getState() != State::Pending;
+    }
+
+    SharedPtr<Shader> ShaderRequest::get() const {
+        if (!isDone()) return nullptr;
+
+        std::lock_guard lock(mMutex);
+        return mShader;
+    }
+
+    SharedPtr<Shader> ShaderRequest::wait() {
+        if (isDone()) return get();
+
+        ShaderCache& cache = GetShaderCache();
+
+        if (cache.isRenderThread()) {
+            // nobody else is going to compile it, do it now. If it's still out on the io thread, give that a moment
+            while (!isDone()) {
+                if (!cache.takeReady(this)) std::this_thread::yield();
+            }
+
+            return get();
+        }
+
+        std::unique_lock lock(mMutex);
+        mCondition.wait(lock, [this] { return isDone(); });
+        return mShader;
+    }
+
+    void ShaderRequest::finish(SharedPtr<Shader> shader) {
+        {
+            std::lock_guard lock(mMutex);
+            mShader = std::move(shader);
+            mState.store(mShader != nullptr ? State::Ready : State::Failed, std::memory_order_release);
+        }
+
+        mCondition.notify_all();
+    }
+
+    SharedPtr<ShaderRequest> CompileShaderAsync(const char* vShaderCode, const char* fShaderCode) {
+        return GetShaderCache().request(vShaderCode, fShaderCode);
+    }
+
+    SharedPtr<Shader> CompileShader(const char* vShaderCode, const char* fShaderCode) {
+        return CompileShaderAsync(vShaderCode, fShaderCode)->wait();
+    }
+
+    void PumpShaderCompiles(double budgetSeconds) {
+        GetShaderCache().pump(budgetSeconds);
+    }
+
+    size_t GetPendingShaderCompiles() {
+        return GetShaderCache().getPendingCount();
+    }
+
+    void SetRenderThread() {
+        GetShaderCache().setRenderThread();
+    }
+
+    void SetShaderCacheDirectory(const char* path) {
+        GetShaderCache().setDirectory(path);
+    }
+}
@@ -0,0 +1,753 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/foundation/jobs/job_system.h"
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include "scorpion/hal/software_backend.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCORPION_SOFTWARE_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace scorpion::render {
+    // corner i of the unit cube has x, y, z set from bits 0, 1 and 2
+    static constexpr int CubeFaces[6][6] = {
+        { 4, 5, 7, 4, 7, 6 }, // z+
+        { 0, 2, 3, 0, 3, 1 }, // z-
+        { 2, 6, 7, 2, 7, 3 }, // y+
+        { 0, 1, 5, 0, 5, 4 }, // y-
+        { 1, 3, 7, 1, 7, 5 }, // x+
+        { 0, 4, 6, 0, 6, 2 }, // x-
+    };
+
+    static const math::Vec3 CubeNormals[6] = {
+        { 0, 0, 1 },
+        { 0, 0, -1 },
+        { 0, 1, 0 },
+        { 0, -1, 0 },
+        { 1, 0, 0 },
+        { -1, 0, 0 },
+    };
+
+    static uint32_t PackColor(math::Color color) {
+        return static_cast<uint32_t>(color.r) | (static_cast<uint32_t>(color.g) << 8) | (static_cast<uint32_t>(color.b) << 16) | (static_cast<uint32_t>(color.a) << 24);
+    }
+
+    static math::Vec4 Transform(const math::Matrix4& matrix, float x, float y, float z) {
+        const float* m = matrix.m;
+        return {
+            m[0] * x + m[4] * y + m[8] * z + m[12],
+            m[1] * x + m[5] * y + m[9] * z + m[13],
+            m[2] * x + m[6] * y + m[10] * z + m[14],
+            m[3] * x + m[7] * y + m[11] * z + m[15],
+        };
+    }
+
+    static math::Vec4 Lerp(const math::Vec4& a, const math::Vec4& b, float t) {
+        return {
+            a.x + (b.x - a.x) * t,
+            a.y + (b.y - a.y) * t,
+            a.z + (b.z - a.z) * t,
+            a.w + (b.w - a.w) * t,
+        };
+    }
+
+    SoftwareBackend::SoftwareBackend(int width, int height)
+        : mClearColor(PackColor(math::Color::white))
+        , mLightDirection(math::Vec3(-0.4f, -1.0f, -0.3f).normalized())
+        , mAmbient(0.3f) {
+        resize(width, height);
+    }
+
+    const char* SoftwareBackend::getName() const {
+        return "Software";
+    }
+
+    bool SoftwareBackend::isHeadless() const {
+        return true;
+    }
+
+    void SoftwareBackend::initWindow(int width, int height, const char* title) {
+        resize(width, height);
+    }
+
+    void SoftwareBackend::closeWindow() {
+    }
+
+    bool SoftwareBackend::windowShouldClose() {
+        return false;
+    }
+
+    int SoftwareBackend::getWindowWidth() {
+        return mWidth;
+    }
+
+    int SoftwareBackend::getWindowHeight() {
+        return mHeight;
+    }
+
+    bool SoftwareBackend::isCursorVisible() {
+        return true;
+    }
+
+    void SoftwareBackend::setCursorVisible(bool visible) {
+    }
+
+    // there's no programmable pipeline here, shaders get a dummy handle so the code using them keeps working
+
+    void* SoftwareBackend::compileShader(const char* vShaderCode, const char* fShaderCode) {
+        return this;
+    }
+
+    void SoftwareBackend::destroyShader(void* shader) {
+    }
+
+    void SoftwareBackend::bindShader(void* shader) {
+    }
+
+    void SoftwareBackend::unbindShader() {
+    }
+
+    int SoftwareBackend::getUniformLocation(void* shader, const char* name) {
+        return 0;
+    }
+
+    int SoftwareBackend::getAttribLocation(void* shader, const char* name) {
+        return 0;
+    }
+
+    void SoftwareBackend::setUniform(void* shader, int location, UniformType type, const void* value) {
+    }
+
+    void* SoftwareBackend::createRenderTarget(int width, int height) {
+        auto target = new RenderTarget();
+        target->width = std::max(width, 1);
+        target->height = std::max(height, 1);
+        target->pitch = (target->width + 3) & ~3;
+        target->color.assign(static_cast<size_t>(target->pitch) * target->height, mClearColor);
+        target->depth.assign(static_cast<size_t>(target->pitch) * target->height, 1.0f);
+
+        return target;
+    }
+
+    void SoftwareBackend::destroyRenderTarget(void* target) {
+        if (target == mViewTarget) endView();
+
+        delete static_cast<RenderTarget*>(target);
+    }
+
+    void SoftwareBackend::beginView(void* target, int x, int y, int width, int height) {
+        if (mViewTarget != nullptr) endView();
+
+        flush();
+
+        if (target != nullptr) {
+            mViewTarget = static_cast<RenderTarget*>(target);
+            swapTarget(mViewTarget);
+        }
+
+        mViewport = { std::clamp(x, 0, mWidth), std::clamp(y, 0, mHeight), std::clamp(x + width, 0, mWidth), std::clamp(y + height, 0, mHeight) };
+    }
+
+    void SoftwareBackend::endView() {
+        flush();
+
+        if (mViewTarget != nullptr) {
+            swapTarget(mViewTarget);
+            mViewTarget = nullptr;
+        }
+
+        mViewport = { 0, 0, mWidth, mHeight };
+    }
+
+    void* SoftwareBackend::createTexture(int width, int height, const uint8_t* pixels) {
+        auto texture = new Texture();
+        texture->width = std::max(width, 1);
+        texture->height = std::max(height, 1);
+        texture->pixels.assign(static_cast<size_t>(texture->width) * texture->height, 0xFFFFFFFF);
+
+        if (pixels != nullptr) updateTexture(texture, 0, 0, width, height, pixels);
+
+        return texture;
+    }
+
+    void SoftwareBackend::updateTexture(void* handle, int x, int y, int width, int height, const uint8_t* pixels) {
+        auto texture = static_cast<Texture*>(handle);
+        if (x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > texture->width || y + height > texture->height) return;
+
+        for (int row = 0; row < height; row++) {
+            memcpy(texture->pixels.data() + static_cast<size_t>(y + row) * texture->width + x, pixels + static_cast<size_t>(row) * width * 4, static_cast<size_t>(width) * 4);
+        }
+    }
+
+    void SoftwareBackend::destroyTexture(void* texture) {
+        delete static_cast<Texture*>(texture);
+    }
+
+    void SoftwareBackend::drawSprites(void* texture, BlendMode blend, const SpriteVertex* vertices, uint32_t count) {
+        SCORPION_PROFILE_SCOPE("SoftwareBackend::drawSprites");
+
+        // sprites blend over what's there, so every triangle before them has to be in the buffer already
+        flush();
+
+        auto spriteTexture = static_cast<const Texture*>(texture);
+
+        for (uint32_t i = 0; i < count; i++) {
+            const SpriteVertex* quad = vertices + i * 4;
+            uint32_t color = PackColor(quad[0].color);
+
+            rasterizeSprite(quad[0], quad[1], quad[2], spriteTexture, blend, color);
+            rasterizeSprite(quad[0], quad[2], quad[3], spriteTexture, blend, color);
+        }
+    }
+
+    void SoftwareBackend::swapTarget(RenderTarget* target) {
+        std::swap(mColorBuffer, target->color);
+        std::swap(mDepthBuffer, target->depth);
+        std::swap(mWidth, target->width);
+        std::swap(mHeight, target->height);
+        std::swap(mPitch, target->pitch);
+
+        mTilesX = (mWidth + TileSize - 1) / TileSize;
+        mTilesY = (mHeight + TileSize - 1) / TileSize;
+        mBins.resize(static_cast<size_t>(mTilesX) * mTilesY);
+    }
+
+    void SoftwareBackend::beginDrawing() {
+        mTriangles.clear();
+    }
+
+    void SoftwareBackend::endDrawing() {
+        flush();
+    }
+
+    void SoftwareBackend::clear() {
+        // whatever was drawn before the clear still has to land first, otherwise it would show up on top. Same for a clear of another viewport
+        if (!mTriangles.empty() || mClearPending) flush();
+
+        mClearPending = true;
+        mClearRect = mViewport;
+    }
+
+    void SoftwareBackend::begin3D(const math::Matrix4& view, const math::Matrix4& projection) {
+        mViewProjection = projection * view;
+    }
+
+    void SoftwareBackend::end3D() {
+    }
+
+    void SoftwareBackend::drawCube(math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color) {
+        math::Matrix4 rotationMatrix = math::Matrix4::rotation(rotation);
+        math::Matrix4 model = math::Matrix4::translation(position) * rotationMatrix * math::Matrix4::scale(size);
+        math::Matrix4 mvp = mViewProjection * model;
+
+        math::Vec4 corners[8];
+        for (int i = 0; i < 8; i++) {
+            corners[i] = Transform(mvp, (i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f);
+        }
+
+        for (int face = 0; face < 6; face++) {
+            const math::Vec3& n = CubeNormals[face];
+
+            // inverse transpose of R * S is R * S^-1
+            math::Vec4 worldNormal = Transform(rotationMatrix, n.x / size.x, n.y / size.y, n.z / size.z);
+            uint32_t packed = shade(math::Vec3(worldNormal.x, worldNormal.y, worldNormal.z), color);
+
+            const int* indices = CubeFaces[face];
+            submitTriangle(corners[indices[0]], corners[indices[1]], corners[indices[2]], packed);
+            submitTriangle(corners[indices[3]], corners[indices[4]], corners[indices[5]], packed);
+        }
+    }
+
+    void* SoftwareBackend::createMesh(const Vertex* vertices, uint32_t vertexCount, const uint16_t* indices, uint32_t indexCount, bool dynamic) {
+        auto mesh = new Mesh();
+        mesh->vertices.assign(vertices, vertices + vertexCount);
+        if (indices != nullptr) mesh->indices.assign(indices, indices + indexCount);
+
+        return mesh;
+    }
+
+    void SoftwareBackend::updateMeshVertices(void* handle, uint32_t first, const Vertex* vertices, uint32_t count) {
+        auto mesh = static_cast<Mesh*>(handle);
+        if (first + count <= mesh->vertices.size()) std::copy(vertices, vertices + count, mesh->vertices.begin() + first);
+    }
+
+    void SoftwareBackend::updateMeshIndices(void* handle, uint32_t first, const uint16_t* indices, uint32_t count) {
+        auto mesh = static_cast<Mesh*>(handle);
+        if (first + count <= mesh->indices.size()) std::copy(indices, indices + count, mesh->indices.begin() + first);
+    }
+
+    void SoftwareBackend::destroyMesh(void* handle) {
+        delete static_cast<Mesh*>(handle);
+    }
+
+    void SoftwareBackend::drawMesh(void* handle, const MeshInstance* instances, uint32_t count) {
+        auto mesh = static_cast<Mesh*>(handle);
+
+        size_t vertexCount = mesh->vertices.size();
+        size_t elementCount = mesh->indices.empty() ? vertexCount : mesh->indices.size();
+
+        mClipVertices.resize(vertexCount);
+        mWorldVertices.resize(vertexCount);
+
+        for (uint32_t instance = 0; instance < count; instance++) {
+            const math::Matrix4& model = instances[instance].transform;
+            math::Matrix4 mvp = mViewProjection * model;
+
+            for (size_t i = 0; i < vertexCount; i++) {
+                const math::Vec3& position = mesh->vertices[i].position;
+
+                math::Vec4 world = Transform(model, position.x, position.y, position.z);
+                mWorldVertices[i] = math::Vec3(world.x, world.y, world.z);
+                mClipVertices[i] = Transform(mvp, position.x, position.y, position.z);
+            }
+
+            // flat shaded from the world space face normal, so vertex normals don't matter here
+            for (size_t i = 0; i + 2 < elementCount; i += 3) {
+                uint32_t a = mesh->indices.empty() ? static_cast<uint32_t>(i) : mesh->indices[i];
+                uint32_t b = mesh->indices.empty() ? static_cast<uint32_t>(i + 1) : mesh->indices[i + 1];
+                uint32_t c = mesh->indices.empty() ? static_cast<uint32_t>(i + 2) : mesh->indices[i + 2];
+                if (a >= vertexCount || b >= vertexCount || c >= vertexCount) continue;
+
+                math::Vec3 normal = (mWorldVertices[b] - mWorldVertices[a]).cross(mWorldVertices[c] - mWorldVertices[a]);
+
+                const math::Color& tint = instances[instance].color;
+                const math::Color& vertexColor = mesh->vertices[a].color;
+                math::Color color = {
+                    static_cast<uint8_t>(tint.r * vertexColor.r / 255),
+                    static_cast<uint8_t>(tint.g * vertexColor.g / 255),
+                    static_cast<uint8_t>(tint.b * vertexColor.b / 255),
+                    static_cast<uint8_t>(tint.a * vertexColor.a / 255),
+                };
+
+                submitTriangle(mClipVertices[a], mClipVertices[b], mClipVertices[c], shade(normal, color));
+            }
+        }
+    }
+
+    void SoftwareBackend::resize(int width, int height) {
+        mWidth = std::max(width, 1);
+        mHeight = std::max(height, 1);
+        mPitch = (mWidth + 3) & ~3; // rows padded so 4 wide loads never run off the end
+        mTilesX = (mWidth + TileSize - 1) / TileSize;
+        mTilesY = (mHeight + TileSize - 1) / TileSize;
+
+        mColorBuffer.assign(static_cast<size_t>(mPitch) * mHeight, mClearColor);
+        mDepthBuffer.assign(static_cast<size_t>(mPitch) * mHeight, 1.0f);
+        mBins.resize(static_cast<size_t>(mTilesX) * mTilesY);
+        mTriangles.clear();
+
+        mViewport = { 0, 0, mWidth, mHeight };
+    }
+
+    void SoftwareBackend::setClearColor(math::Color color) {
+        mClearColor = PackColor(color);
+    }
+
+    void SoftwareBackend::setLight(math::Vec3 direction, float ambient) {
+        mLightDirection = direction.normalized();
+        mAmbient = std::clamp(ambient, 0.0f, 1.0f);
+    }
+
+    void SoftwareBackend::flush() {
+        SCORPION_PROFILE_SCOPE("SoftwareBackend::flush");
+
+        if (mTriangles.empty() && !mClearPending) return;
+
+        for (Vector<uint32_t>& bin : mBins) {
+            bin.clear();
+        }
+
+        // binning stays serial so every tile sees its triangles in submission order
+        for (uint32_t i = 0; i < mTriangles.size(); i++) {
+            const Triangle& triangle = mTriangles[i];
+
+            int tileMinX = triangle.minX / TileSize;
+            int tileMaxX = triangle.maxX / TileSize;
+            int tileMinY = triangle.minY / TileSize;
+            int tileMaxY = triangle.maxY / TileSize;
+
+            for (int ty = tileMinY; ty <= tileMaxY; ty++) {
+                for (int tx = tileMinX; tx <= tileMaxX; tx++) {
+                    mBins[ty * mTilesX + tx].push_back(i);
+                }
+            }
+        }
+
+        jobs::ParallelFor(mBins.size(), 1, [this](size_t begin, size_t end) {
+            for (size_t tile = begin; tile < end; tile++) {
+                rasterizeTile(static_cast<int>(tile));
+            }
+        });
+
+        mTriangles.clear();
+        mClearPending = false;
+    }
+
+    const uint32_t* SoftwareBackend::getPixels() const {
+        return mViewTarget != nullptr ? mViewTarget->color.data() : mColorBuffer.data();
+    }
+
+    const uint32_t* SoftwareBackend::getPixels(void* target) const {
+        if (target == mViewTarget) return mColorBuffer.data();
+        return static_cast<const RenderTarget*>(target)->color.data();
+    }
+
+    int SoftwareBackend::getPitch() const {
+        return mPitch;
+    }
+
+    bool SoftwareBackend::savePPM(const char* path) const {
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) return false;
+
+        fprintf(file, "P6\n%d %d\n255\n", mWidth, mHeight);
+
+        Vector<uint8_t> row(static_cast<size_t>(mWidth) * 3);
+        for (int y = 0; y < mHeight; y++) {
+            const uint32_t* pixels = mColorBuffer.data() + static_cast<size_t>(y) * mPitch;
+
+            for (int x = 0; x < mWidth; x++) {
+                row[x * 3 + 0] = static_cast<uint8_t>(pixels[x]);
+                row[x * 3 + 1] = static_cast<uint8_t>(pixels[x] >> 8);
+                row[x * 3 + 2] = static_cast<uint8_t>(pixels[x] >> 16);
+            }
+
+            fwrite(row.data(), 1, row.size(), file);
+        }
+
+        return fclose(file) == 0;
+    }
+
+    // same factors as the GL blend modes rlgl sets up, applied to all four channels
+    static uint32_t BlendPixel(uint32_t source, uint32_t destination, BlendMode blend) {
+        uint32_t alpha = source >> 24;
+        uint32_t result = 0;
+
+        for (int shift = 0; shift < 32; shift += 8) {
+            uint32_t s = (source >> shift) & 0xFF;
+            uint32_t d = (destination >> shift) & 0xFF;
+            uint32_t value = 0;
+
+            switch (blend) {
+                case BlendMode::Alpha:
+                    value = (s * alpha + d * (255 - alpha)) / 255;
+                    break;
+                case BlendMode::Additive:
+                    value = d + s * alpha / 255;
+                    break;
+                case BlendMode::Multiply:
+                    value = (s * d + d * (255 - alpha)) / 255;
+                    break;
+                case BlendMode::Premultiplied:
+                    value = s + d * (255 - alpha) / 255;
+                    break;
+            }
+
+            result |= std::min(value, 255u) << shift;
+        }
+
+        return result;
+    }
+
+    static uint32_t Modulate(uint32_t a, uint32_t b) {
+        uint32_t result = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            result |= (((a >> shift) & 0xFF) * ((b >> shift) & 0xFF) / 255) << shift;
+        }
+        return result;
+    }
+
+    void SoftwareBackend::rasterizeSprite(const SpriteVertex& v0, const SpriteVertex& v1, const SpriteVertex& v2, const Texture* texture, BlendMode blend, uint32_t color) {
+        const SpriteVertex* a = &v0;
+        const SpriteVertex* b = &v1;
+        const SpriteVertex* c = &v2;
+
+        auto edge = [](const math::Vec2& from, const math::Vec2& to, float x, float y) {
+            return (to.x - from.x) * (y - from.y) - (to.y - from.y) * (x - from.x);
+        };
+
+        float area = edge(a->position, b->position, c->position.x, c->position.y);
+        if (area == 0.0f) return;
+
+        // mirrored sprites wind the other way
+        if (area < 0.0f) {
+            std::swap(b, c);
+            area = -area;
+        }
+
+        // Pixels exactly on an edge go to only one of the two triangles sharing it, otherwise the diagonal of a translucent quad would
+        // get blended twice. Any rule that flips with the edge direction does it
+        auto owns = [](const math::Vec2& from, const math::Vec2& to) {
+            float dx = to.x - from.x;
+            float dy = to.y - from.y;
+            return dy > 0.0f || (dy == 0.0f && dx > 0.0f);
+        };
+
+        bool owns0 = owns(b->position, c->position);
+        bool owns1 = owns(c->position, a->position);
+        bool owns2 = owns(a->position, b->position);
+
+        float offsetX = static_cast<float>(mViewport.x0);
+        float offsetY = static_cast<float>(mViewport.y0);
+
+        float minX = std::min({ a->position.x, b->position.x, c->position.x }) + offsetX;
+        float maxX = std::max({ a->position.x, b->position.x, c->position.x }) + offsetX;
+        float minY = std::min({ a->position.y, b->position.y, c->position.y }) + offsetY;
+        float maxY = std::max({ a->position.y, b->position.y, c->position.y }) + offsetY;
+
+        int x0 = std::max(static_cast<int>(std::floor(minX)), mViewport.x0);
+        int x1 = std::min(static_cast<int>(std::ceil(maxX)), mViewport.x1);
+        int y0 = std::max(static_cast<int>(std::floor(minY)), mViewport.y0);
+        int y1 = std::min(static_cast<int>(std::ceil(maxY)), mViewport.y1);
+
+        float inverseArea = 1.0f / area;
+
+        for (int y = y0; y < y1; y++) {
+            float py = static_cast<float>(y) + 0.5f - offsetY;
+            uint32_t* row = mColorBuffer.data() + static_cast<size_t>(y) * mPitch;
+
+            for (int x = x0; x < x1; x++) {
+                float px = static_cast<float>(x) + 0.5f - offsetX;
+
+                float w0 = edge(b->position, c->position, px, py);
+                float w1 = edge(c->position, a->position, px, py);
+                float w2 = edge(a->position, b->position, px, py);
+
+                if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+                if ((w0 == 0.0f && !owns0) || (w1 == 0.0f && !owns1) || (w2 == 0.0f && !owns2)) continue;
+
+                uint32_t source = color;
+
+                if (texture != nullptr) {
+                    float u = (w0 * a->texCoord.x + w1 * b->texCoord.x + w2 * c->texCoord.x) * inverseArea;
+                    float v = (w0 * a->texCoord.y + w1 * b->texCoord.y + w2 * c->texCoord.y) * inverseArea;
+
+                    int tx = std::clamp(static_cast<int>(u * static_cast<float>(texture->width)), 0, texture->width - 1);
+                    int ty = std::clamp(static_cast<int>(v * static_cast<float>(texture->height)), 0, texture->height - 1);
+
+                    source = Modulate(texture->pixels[static_cast<size_t>(ty) * texture->width + tx], color);
+                }
+
+                row[x] = BlendPixel(source, row[x], blend);
+            }
+        }
+    }
+
+    uint32_t SoftwareBackend::shade(math::Vec3 normal, math::Color color) const {
+        float diffuse = std::max(0.0f, -normal.normalized().dot(mLightDirection));
+        float intensity = mAmbient + (1.0f - mAmbient) * diffuse;
+
+        return PackColor({
+            static_cast<uint8_t>(static_cast<float>(color.r) * intensity),
+            static_cast<uint8_t>(static_cast<float>(color.g) * intensity),
+            static_cast<uint8_t>(static_cast<float>(color.b) * intensity),
+            color.a,
+        });
+    }
+
+    // only the near plane needs real clipping, everything else is handled by the bounding box and the depth range check
+    void SoftwareBackend::submitTriangle(const math::Vec4& v0, const math::Vec4& v1, const math::Vec4& v2, uint32_t color) {
+        const math::Vec4* input[3] = { &v0, &v1, &v2 };
+        float distance[3];
+        int insideCount = 0;
+
+        for (int i = 0; i < 3; i++) {
+            distance[i] = input[i]->z + input[i]->w;
+            if (distance[i] >= 0.0f) insideCount++;
+        }
+
+        if (insideCount == 3) {
+            setupTriangle(v0, v1, v2, color);
+            return;
+        }
+        if (insideCount == 0) return;
+
+        math::Vec4 polygon[4];
+        int count = 0;
+
+        for (int i = 0; i < 3; i++) {
+            int next = (i + 1) % 3;
+
+            if (distance[i] >= 0.0f) polygon[count++] = *input[i];
+            if ((distance[i] >= 0.0f) != (distance[next] >= 0.0f)) {
+                float t = distance[i] / (distance[i] - distance[next]);
+                polygon[count++] = Lerp(*input[i], *input[next], t);
+            }
+        }
+
+        for (int i = 1; i + 1 < count; i++) {
+            setupTriangle(polygon[0], polygon[i], polygon[i + 1], color);
+        }
+    }
+
+    void SoftwareBackend::setupTriangle(const math::Vec4& v0, const math::Vec4& v1, const math::Vec4& v2, uint32_t color) {
+        if (v0.w <= 0.0f || v1.w <= 0.0f || v2.w <= 0.0f) return;
+
+        float x[3], y[3], z[3];
+        const math::Vec4* input[3] = { &v0, &v1, &v2 };
+
+        for (int i = 0; i < 3; i++) {
+            float invW = 1.0f / input[i]->w;
+            x[i] = (input[i]->x * invW * 0.5f + 0.5f) * static_cast<float>(mViewport.x1 - mViewport.x0) + static_cast<float>(mViewport.x0);
+            y[i] = (0.5f - input[i]->y * invW * 0.5f) * static_cast<float>(mViewport.y1 - mViewport.y0) + static_cast<float>(mViewport.y0);
+            z[i] = input[i]->z * invW * 0.5f + 0.5f;
+        }
+
+        // counter clockwise front faces end up clockwise once y points down, flip them to positive area and drop the rest
+        float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        if (area >= 0.0f) return;
+
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(z[1], z[2]);
+        area = -area;
+
+        Triangle triangle;
+        triangle.minX = std::max(mViewport.x0, static_cast<int>(std::floor(std::min({ x[0], x[1], x[2] }))));
+        triangle.minY = std::max(mViewport.y0, static_cast<int>(std::floor(std::min({ y[0], y[1], y[2] }))));
+        triangle.maxX = std::min(mViewport.x1 - 1, static_cast<int>(std::ceil(std::max({ x[0], x[1], x[2] }))));
+        triangle.maxY = std::min(mViewport.y1 - 1, static_cast<int>(std::ceil(std::max({ y[0], y[1], y[2] }))));
+        if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) return;
+
+        // edge i is opposite vertex i, positive inside
+        for (int i = 0; i < 3; i++) {
+            int a = (i + 1) % 3;
+            int b = (i + 2) % 3;
+
+            triangle.edgeA[i] = y[a] - y[b];
+            triangle.edgeB[i] = x[b] - x[a];
+            triangle.edgeC[i] = x[a] * y[b] - x[b] * y[a];
+
+            // shared edges are walked in opposite directions, so exactly one of the two triangles owns pixels sitting on them
+            triangle.inclusive[i] = triangle.edgeA[i] > 0.0f || (triangle.edgeA[i] == 0.0f && triangle.edgeB[i] > 0.0f);
+        }
+
+        float invArea = 1.0f / area;
+        triangle.dzdx = (triangle.edgeA[0] * z[0] + triangle.edgeA[1] * z[1] + triangle.edgeA[2] * z[2]) * invArea;
+        triangle.dzdy = (triangle.edgeB[0] * z[0] + triangle.edgeB[1] * z[1] + triangle.edgeB[2] * z[2]) * invArea;
+        triangle.z0 = (triangle.edgeC[0] * z[0] + triangle.edgeC[1] * z[1] + triangle.edgeC[2] * z[2]) * invArea;
+
+        triangle.color = color;
+
+        mTriangles.push_back(triangle);
+    }
+
+    void SoftwareBackend::rasterizeTile(int tileIndex) {
+        int tileX0 = (tileIndex % mTilesX) * TileSize;
+        int tileY0 = (tileIndex / mTilesX) * TileSize;
+        int tileX1 = std::min(tileX0 + TileSize, mWidth);
+        int tileY1 = std::min(tileY0 + TileSize, mHeight);
+
+        if (mClearPending) {
+            int clearX0 = std::max(tileX0, mClearRect.x0);
+            int clearX1 = std::min(tileX1, mClearRect.x1);
+
+            for (int y = std::max(tileY0, mClearRect.y0); y < std::min(tileY1, mClearRect.y1) && clearX0 < clearX1; y++) {
+                size_t row = static_cast<size_t>(y) * mPitch;
+                std::fill(mColorBuffer.begin() + row + clearX0, mColorBuffer.begin() + row + clearX1, mClearColor);
+                std::fill(mDepthBuffer.begin() + row + clearX0, mDepthBuffer.begin() + row + clearX1, 1.0f);
+            }
+        }
+
+        for (uint32_t index : mBins[tileIndex]) {
+            const Triangle& triangle = mTriangles[index];
+
+            int startX = std::max(tileX0, triangle.minX & ~3);
+            int endX = std::min(tileX1, triangle.maxX + 1);
+            int startY = std::max(tileY0, triangle.minY);
+            int endY = std::min(tileY1, triangle.maxY + 1);
+
+#ifdef SCORPION_SOFTWARE_SSE
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 laneOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+            const __m128 begin = _mm_set1_ps(static_cast<float>(triangle.minX));
+            const __m128 end = _mm_set1_ps(static_cast<float>(endX));
+            const __m128i color = _mm_set1_epi32(static_cast<int>(triangle.color));
+
+            __m128 edgeA[3], inclusive[3];
+            for (int i = 0; i < 3; i++) {
+                edgeA[i] = _mm_set1_ps(triangle.edgeA[i]);
+                inclusive[i] = _mm_castsi128_ps(_mm_set1_epi32(triangle.inclusive[i] ? -1 : 0));
+            }
+            const __m128 dzdx = _mm_set1_ps(triangle.dzdx);
+
+            for (int y = startY; y < endY; y++) {
+                float py = static_cast<float>(y) + 0.5f;
+
+                __m128 rowBase[3];
+                for (int i = 0; i < 3; i++) {
+                    rowBase[i] = _mm_set1_ps(triangle.edgeB[i] * py + triangle.edgeC[i]);
+                }
+                __m128 zRow = _mm_set1_ps(triangle.dzdy * py + triangle.z0);
+
+                uint32_t* colorRow = mColorBuffer.data() + static_cast<size_t>(y) * mPitch;
+                float* depthRow = mDepthBuffer.data() + static_cast<size_t>(y) * mPitch;
+
+                for (int x = startX; x < endX; x += 4) {
+                    __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+
+                    // lanes past endX belong to the next tile, which another thread may be writing. Lanes before minX can be outside the viewport
+                    __m128 mask = _mm_and_ps(_mm_cmpge_ps(px, begin), _mm_cmplt_ps(px, end));
+
+                    for (int i = 0; i < 3; i++) {
+                        __m128 e = _mm_add_ps(_mm_mul_ps(edgeA[i], px), rowBase[i]);
+                        __m128 inside = _mm_or_ps(_mm_cmpgt_ps(e, zero), _mm_and_ps(_mm_cmpeq_ps(e, zero), inclusive[i]));
+                        mask = _mm_and_ps(mask, inside);
+                    }
+
+                    if (_mm_movemask_ps(mask) == 0) continue;
+
+                    __m128 z = _mm_add_ps(_mm_mul_ps(dzdx, px), zRow);
+                    __m128 depth = _mm_loadu_ps(depthRow + x);
+
+                    mask = _mm_and_ps(mask, _mm_cmplt_ps(z, depth));
+                    mask = _mm_and_ps(mask, _mm_cmpge_ps(z, zero));
+                    mask = _mm_and_ps(mask, _mm_cmple_ps(z, one));
+
+                    int bits = _mm_movemask_ps(mask);
+                    if (bits == 0) continue;
+
+                    _mm_storeu_ps(depthRow + x, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, depth)));
+
+                    __m128i maski = _mm_castps_si128(mask);
+                    __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colorRow + x));
+                    __m128i blended = _mm_or_si128(_mm_and_si128(maski, color), _mm_andnot_si128(maski, previous));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(colorRow + x), blended);
+                }
+            }
+#else
+            for (int y = startY; y < endY; y++) {
+                float py = static_cast<float>(y) + 0.5f;
+
+                uint32_t* colorRow = mColorBuffer.data() + static_cast<size_t>(y) * mPitch;
+                float* depthRow = mDepthBuffer.data() + static_cast<size_t>(y) * mPitch;
+
+                for (int x = std::max(startX, triangle.minX); x < endX; x++) {
+                    float px = static_cast<float>(x) + 0.5f;
+
+                    bool inside = true;
+                    for (int i = 0; i < 3; i++) {
+                        float e = triangle.edgeA[i] * px + (triangle.edgeB[i] * py + triangle.edgeC[i]);
+                        inside &= e > 0.0f || (e == 0.0f && triangle.inclusive[i]);
+                    }
+                    if (!inside) continue;
+
+                    float z = triangle.dzdx * px + (triangle.dzdy * py + triangle.z0);
+                    if (z < depthRow[x] && z >= 0.0f && z <= 1.0f) {
+                        depthRow[x] = z;
+                        colorRow[x] = triangle.color;
+                    }
+                }
+            }
+#endif
+        }
+    }
+}
@@ -0,0 +1,194 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/core/stats.h"
+
+#include "scorpion/foundation/profiling/profiler.h"
+
+#include "scorpion/hal/command_list.h"
+#include "scorpion/hal/sprite_batch.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace scorpion::render {
+    static constexpr uint64_t TextureBits = 20;
+    static constexpr uint64_t BlendBits = 4;
+    static constexpr int KeyBytes = 5; // with the 16 bits of order
+
+    uint64_t SpriteQueue::makeKey(int order, BlendMode blend, const Texture* texture) {
+        // biased so negative orders sort below positive ones
+        auto biasedOrder = static_cast<uint64_t>(std::clamp(order, INT16_MIN, INT16_MAX) - INT16_MIN);
+
+        // ids wrap after a million textures, two textures sharing one only costs a draw call since runs compare the pointers
+        uint64_t textureId = texture != nullptr ? texture->getId() & ((1u << TextureBits) - 1) : 0;
+
+        return biasedOrder << (BlendBits + TextureBits) | static_cast<uint64_t>(blend) << TextureBits | textureId;
+    }
+
+    static BlendMode BlendOf(uint64_t key) {
+        return static_cast<BlendMode>((key >> TextureBits) & ((1u << BlendBits) - 1));
+    }
+
+    // LSD radix sort, stable so sprites with equal keys stay in the order they were added. Bytes that are the same in every key get
+    // skipped, usually that's most of them since a frame only has a handful of orders and textures
+    template<typename T>
+    static void RadixSort(Vector<T>& items, Vector<T>& scratch) {
+        uint32_t counts[KeyBytes][256] = {};
+
+        for (const T& item : items) {
+            for (int byte = 0; byte < KeyBytes; byte++) {
+                counts[byte][(item.key >> (byte * 8)) & 0xFF]++;
+            }
+        }
+
+        scratch.resize(items.size());
+
+        for (int byte = 0; byte < KeyBytes; byte++) {
+            uint32_t* count = counts[byte];
+            if (count[(items[0].key >> (byte * 8)) & 0xFF] == items.size()) continue;
+
+            uint32_t offsets[256];
+            uint32_t offset = 0;
+            for (int i = 0; i < 256; i++) {
+                offsets[i] = offset;
+                offset += count[i];
+            }
+
+            for (const T& item : items) {
+                scratch[offsets[(item.key >> (byte * 8)) & 0xFF]++] = item;
+            }
+
+            items.swap(scratch);
+        }
+    }
+
+    void SpriteQueue::add(const TextureRegion& region, math::Vec2 position, math::Vec2 size, math::Color tint, float rotation, math::Vec2 origin, int order, BlendMode blend) {
+        auto index = static_cast<uint32_t>(mSprites.size());
+        mSprites.push_back({ makeKey(order, blend, region.texture), index });
+        mTextures.push_back(region.texture);
+
+        // clockwise from the top left
+        math::Vec2 corners[4] = {
+            math::Vec2(-origin.x, -origin.y),
+            math::Vec2(size.x - origin.x, -origin.y),
+            math::Vec2(size.x - origin.x, size.y - origin.y),
+            math::Vec2(-origin.x, size.y - origin.y),
+        };
+
+        if (rotation != 0.0f) {
+            float c = std::cos(rotation);
+            float s = std::sin(rotation);
+
+            for (math::Vec2& corner : corners) {
+                corner = math::Vec2(corner.x * c - corner.y * s, corner.x * s + corner.y * c);
+            }
+        }
+
+        const math::Vec2 texCoords[4] = {
+            region.uvMin,
+            math::Vec2(region.uvMax.x, region.uvMin.y),
+            region.uvMax,
+            math::Vec2(region.uvMin.x, region.uvMax.y),
+        };
+
+        size_t first = mVertices.size();
+        mVertices.resize(first + 4);
+
+        SpriteVertex* vertices = mVertices.data() + first;
+        for (int i = 0; i < 4; i++) {
+            vertices[i] = { math::Vec2(position.x + corners[i].x, position.y + corners[i].y), texCoords[i], tint };
+        }
+    }
+
+    void SpriteQueue::appendTo(SpriteQueue& other) {
+        auto base = static_cast<uint32_t>(other.mSprites.size());
+
+        for (const Sprite& sprite : mSprites) {
+            other.mSprites.push_back({ sprite.key, base + sprite.index });
+        }
+
+        other.mTextures.insert(other.mTextures.end(), mTextures.begin(), mTextures.end());
+        other.mVertices.insert(other.mVertices.end(), mVertices.begin(), mVertices.end());
+
+        clear();
+    }
+
+    void SpriteQueue::flush() {
+        if (mSprites.empty()) return;
+
+        SCORPION_PROFILE_SCOPE("render::FlushSprites");
+
+        auto byKey = [](const Sprite& a, const Sprite& b) { return a.key < b.key; };
+
+        // UI mostly comes in already sorted, that's one pass and no copying
+        bool sorted = std::is_sorted(mSprites.begin(), mSprites.end(), byKey);
+
+        if (!sorted) {
+            RadixSort(mSprites, mSortedSprites);
+
+            mSortedVertices.resize(mVertices.size());
+            for (size_t i = 0; i < mSprites.size(); i++) {
+                std::copy_n(mVertices.begin() + static_cast<size_t>(mSprites[i].index) * 4, 4, mSortedVertices.begin() + i * 4);
+            }
+
+            mVertices.swap(mSortedVertices);
+        }
+
+        Backend* backend = GetBackend();
+
+        auto textureAt = [this](size_t i) { return mTextures[mSprites[i].index]; };
+
+        size_t first = 0;
+        while (first < mSprites.size()) {
+            Texture* texture = textureAt(first);
+            BlendMode blend = BlendOf(mSprites[first].key);
+
+            // same order isn't needed, the next order continuing on the same texture still goes in the same draw
+            size_t last = first + 1;
+            while (last < mSprites.size() && textureAt(last) == texture && BlendOf(mSprites[last].key) == blend) last++;
+
+            auto count = static_cast<uint32_t>(last - first);
+
+            if (texture != nullptr) texture->upload();
+
+            stats::Add(stats::Stat::DrawCalls);
+            stats::Add(stats::Stat::TrianglesSubmitted, static_cast<uint64_t>(count) * 2);
+            stats::Add(stats::Stat::SpritesDrawn, count);
+
+            backend->drawSprites(texture != nullptr ? texture->getHandle() : nullptr, blend, mVertices.data() + first * 4, count);
+
+            first = last;
+        }
+
+        clear();
+    }
+
+    void SpriteQueue::clear() {
+        mSprites.clear();
+        mTextures.clear();
+        mVertices.clear();
+    }
+
+    static SpriteQueue spriteQueue; // the render thread's, recording threads have their command list's
+
+    void DrawSprite(const TextureRegion& region, math::Vec2 position, math::Vec2 size, math::Color tint, float rotation, math::Vec2 origin, int order, BlendMode blend) {
+        if (CommandList* list = CommandList::getCurrent()) {
+            list->getSprites().add(region, position, size, tint, rotation, origin, order, blend);
+            return;
+        }
+
+        spriteQueue.add(region, position, size, tint, rotation, origin, order, blend);
+    }
+
+    void DrawRect(math::Vec2 position, math::Vec2 size, math::Color color, int order, BlendMode blend) {
+        DrawSprite({}, position, size, color, 0.0f, math::Vec2::zero, order, blend);
+    }
+
+    void FlushSprites() {
+        spriteQueue.flush();
+    }
+
+    void QueueSprites(SpriteQueue& queue) {
+        queue.appendTo(spriteQueue);
+    }
+}
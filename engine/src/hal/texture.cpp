@@ -0,0 +1,110 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/hal/texture.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace scorpion::render {
+    static std::atomic<uint32_t> nextTextureId = 1;
+
+    Texture::Texture(const uint8_t* pixels, int width, int height, Usage usage)
+        : mUsage(usage)
+        , mId(nextTextureId.fetch_add(1, std::memory_order_relaxed))
+        , mWidth(std::max(width, 1))
+        , mHeight(std::max(height, 1)) {
+        size_t size = static_cast<size_t>(mWidth) * mHeight * 4;
+
+        // backends leave new textures undefined, the white has to be uploaded
+        Vector<uint8_t> white;
+        if (pixels == nullptr) {
+            white.assign(size, 0xFF);
+            pixels = white.data();
+        }
+
+        mHandle = GetBackend()->createTexture(mWidth, mHeight, pixels);
+
+        if (usage == Usage::Dynamic) {
+            if (white.empty()) mPixels.assign(pixels, pixels + size);
+            else mPixels.swap(white);
+        }
+    }
+
+    Texture::~Texture() {
+        GetBackend()->destroyTexture(mHandle);
+    }
+
+    Texture::Usage Texture::getUsage() const {
+        return mUsage;
+    }
+
+    int Texture::getWidth() const {
+        return mWidth;
+    }
+
+    int Texture::getHeight() const {
+        return mHeight;
+    }
+
+    const uint8_t* Texture::getPixels() const {
+        return mUsage == Usage::Dynamic ? mPixels.data() : nullptr;
+    }
+
+    void Texture::setPixels(int x, int y, int width, int height, const uint8_t* pixels) {
+        if (mUsage != Usage::Dynamic || width <= 0 || height <= 0) return;
+        if (x < 0 || y < 0 || x + width > mWidth || y + height > mHeight) return;
+
+        for (int row = 0; row < height; row++) {
+            memcpy(mPixels.data() + (static_cast<size_t>(y + row) * mWidth + x) * 4, pixels + static_cast<size_t>(row) * width * 4, static_cast<size_t>(width) * 4);
+        }
+
+        mDirtyX0 = std::min(mDirtyX0, x);
+        mDirtyY0 = std::min(mDirtyY0, y);
+        mDirtyX1 = std::max(mDirtyX1, x + width);
+        mDirtyY1 = std::max(mDirtyY1, y + height);
+    }
+
+    void Texture::upload() {
+        if (mDirtyX0 >= mDirtyX1) return;
+
+        // one rectangle around every edit, uploaded row by row out of the full width copy
+        int width = mDirtyX1 - mDirtyX0;
+        int height = mDirtyY1 - mDirtyY0;
+
+        if (width == mWidth) {
+            GetBackend()->updateTexture(mHandle, 0, mDirtyY0, width, height, mPixels.data() + static_cast<size_t>(mDirtyY0) * mWidth * 4);
+        } else {
+            Vector<uint8_t> rect(static_cast<size_t>(width) * height * 4);
+
+            for (int row = 0; row < height; row++) {
+                memcpy(rect.data() + static_cast<size_t>(row) * width * 4, mPixels.data() + (static_cast<size_t>(mDirtyY0 + row) * mWidth + mDirtyX0) * 4, static_cast<size_t>(width) * 4);
+            }
+
+            GetBackend()->updateTexture(mHandle, mDirtyX0, mDirtyY0, width, height, rect.data());
+        }
+
+        mDirtyX0 = INT32_MAX;
+        mDirtyY0 = INT32_MAX;
+        mDirtyX1 = 0;
+        mDirtyY1 = 0;
+    }
+
+    void* Texture::getHandle() const {
+        return mHandle;
+    }
+
+    uint32_t Texture::getId() const {
+        return mId;
+    }
+
+    SharedPtr<Texture> CreateTexture(int width, int height, const uint8_t* pixels, Texture::Usage usage) {
+        return MakeShared<Texture>(pixels, width, height, usage);
+    }
+
+    TextureRegion GetRegion(Texture* texture) {
+        if (texture == nullptr) return {};
+
+        return { texture, math::Vec2(0.0f, 0.0f), math::Vec2(1.0f, 1.0f), texture->getWidth(), texture->getHeight() };
+    }
+}
@@ -0,0 +1,152 @@
+// Copyright 2025 JesusTouchMe
+
+#include "scorpion/hal/texture_atlas.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace scorpion::render {
+    TextureAtlas::TextureAtlas(int pageSize, int padding)
+        : mPageSize(std::max(pageSize, 1))
+        , mPadding(std::max(padding, 0)) {}
+
+    TextureRegion TextureAtlas::add(int width, int height, const uint8_t* pixels) {
+        int paddedWidth = width + mPadding * 2;
+        int paddedHeight = height + mPadding * 2;
+
+        if (width <= 0 || height <= 0 || paddedWidth > mPageSize || paddedHeight > mPageSize) return {};
+
+        // only the last page is tried, older ones are usually full and going through all of them gets slow with lots of pages
+        int x;
+        int y;
+        if (mPages.empty() || !pack(mPages.back(), paddedWidth, paddedHeight, x, y)) {
+            pack(addPage(), paddedWidth, paddedHeight, x, y);
+        }
+
+        Page& page = mPages.back();
+
+        // the image in the middle and its edge pixels smeared out over the padding
+        mScratch.resize(static_cast<size_t>(paddedWidth) * paddedHeight * 4);
+
+        for (int row = 0; row < paddedHeight; row++) {
+            int sourceRow = std::clamp(row - mPadding, 0, height - 1);
+            const uint8_t* source = pixels + static_cast<size_t>(sourceRow) * width * 4;
+            uint8_t* destination = mScratch.data() + static_cast<size_t>(row) * paddedWidth * 4;
+
+            for (int column = 0; column < mPadding; column++) {
+                memcpy(destination + column * 4, source, 4);
+                memcpy(destination + (mPadding + width + column) * 4, source + (width - 1) * 4, 4);
+            }
+
+            memcpy(destination + mPadding * 4, source, static_cast<size_t>(width) * 4);
+        }
+
+        page.texture->setPixels(x, y, paddedWidth, paddedHeight, mScratch.data());
+
+        auto size = static_cast<float>(mPageSize);
+
+        TextureRegion region;
+        region.texture = page.texture.get();
+        region.uvMin = math::Vec2(static_cast<float>(x + mPadding) / size, static_cast<float>(y + mPadding) / size);
+        region.uvMax = math::Vec2(static_cast<float>(x + mPadding + width) / size, static_cast<float>(y + mPadding + height) / size);
+        region.width = width;
+        region.height = height;
+
+        return region;
+    }
+
+    TextureRegion TextureAtlas::getWhite() {
+        if (mWhite.texture == nullptr) {
+            const uint8_t white[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+            mWhite = add(1, 1, white);
+
+            // sampled right in the middle of the texel, whatever the size of the quad
+            math::Vec2 center((mWhite.uvMin.x + mWhite.uvMax.x) * 0.5f, (mWhite.uvMin.y + mWhite.uvMax.y) * 0.5f);
+            mWhite.uvMin = center;
+            mWhite.uvMax = center;
+        }
+
+        return mWhite;
+    }
+
+    void TextureAtlas::clear() {
+        mPages.clear();
+        mWhite = {};
+    }
+
+    // Bottom left: the spot where the top of the image ends up lowest, on ties the one that leaves the least of a segment uncovered
+    bool TextureAtlas::pack(Page& page, int width, int height, int& x, int& y) {
+        Vector<Segment>& skyline = page.skyline;
+
+        size_t best = SIZE_MAX;
+        int bestTop = INT_MAX;
+        int bestWidth = INT_MAX;
+        int bestY = 0;
+
+        for (size_t i = 0; i < skyline.size(); i++) {
+            int left = skyline[i].x;
+            if (left + width > mPageSize) break;
+
+            // resting on the highest segment under it
+            int top = 0;
+            int remaining = width;
+            for (size_t j = i; remaining > 0; j++) {
+                top = std::max(top, skyline[j].y);
+                remaining -= skyline[j].width;
+            }
+
+            if (top + height > mPageSize) continue;
+
+            if (top + height < bestTop || (top + height == bestTop && skyline[i].width < bestWidth)) {
+                best = i;
+                bestTop = top + height;
+                bestWidth = skyline[i].width;
+                bestY = top;
+            }
+        }
+
+        if (best == SIZE_MAX) return false;
+
+        x = skyline[best].x;
+        y = bestY;
+
+        skyline.insert(skyline.begin() + static_cast<ptrdiff_t>(best), { x, y + height, width });
+
+        // whatever the new segment covers goes away, a segment sticking out on the right just gets shorter
+        size_t next = best + 1;
+        while (next < skyline.size()) {
+            Segment& segment = skyline[next];
+            int covered = x + width - segment.x;
+            if (covered <= 0) break;
+
+            if (covered < segment.width) {
+                segment.x += covered;
+                segment.width -= covered;
+                break;
+            }
+
+            skyline.erase(skyline.begin() + static_cast<ptrdiff_t>(next));
+        }
+
+        // neighbours at the same height are one segment
+        for (size_t i = 0; i + 1 < skyline.size(); ) {
+            if (skyline[i].y == skyline[i + 1].y) {
+                skyline[i].width += skyline[i + 1].width;
+                skyline.erase(skyline.begin() + static_cast<ptrdiff_t>(i + 1));
+            } else {
+                i++;
+            }
+        }
+
+        return true;
+    }
+
+    TextureAtlas::Page& TextureAtlas::addPage() {
+        Page& page = mPages.emplace_back();
+        page.texture = CreateTexture(mPageSize, mPageSize, nullptr, Texture::Usage::Dynamic);
+        page.skyline.push_back({ 0, 0, mPageSize });
+
+        return page;
+    }
+}
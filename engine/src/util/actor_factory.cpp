@@ -4,6 +4,7 @@
 
 #include "scorpion/engine_std/transform.h"
 #include "scorpion/engine_std/cube_renderer.h"
+#include "scorpion/engine_std/mesh_renderer.h"
 
 #include "scorpion/util/actor_factory.h"
 
@@ -48,7 +49,7 @@ namespace scorpion::actors {
     Actor* CreateActorWithTransform(math::Vec3 position, math::Vec3 size, math::Quat rotation, Scene* scene) {
         CHECK_SCENE(scene);
 
-        Actor* actor = CreateActor();
+        Actor* actor = scene->addActor<Actor>();
         actor->addComponent<Transform>(position, size, rotation);
 
         return actor;
@@ -62,4 +63,13 @@ namespace scorpion::actors {
 
         return actor;
     }
+
+    Actor* CreateMesh(SharedPtr<render::Mesh> mesh, math::Vec3 position, math::Vec3 size, math::Quat rotation, math::Color color, Scene* scene) {
+        CHECK_SCENE(scene);
+
+        Actor* actor = CreateActorWithTransform(position, size, rotation, scene);
+        actor->addComponent<MeshRenderer>(std::move(mesh), color);
+
+        return actor;
+    }
 }